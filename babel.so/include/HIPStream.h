@@ -0,0 +1,51 @@
+
+// Copyright (c) 2015-16 Tom Deakin, Simon McIntosh-Smith,
+// University of Bristol HPC
+//
+// For full license terms please see the LICENSE file distributed with this
+// source code
+
+#ifndef MEM_SO_INCLUDE_HIP_STREAM_H_
+#define MEM_SO_INCLUDE_HIP_STREAM_H_
+
+#include <iostream>
+#include <stdexcept>
+#include <sstream>
+
+#include "Stream.h"
+
+#define IMPLEMENTATION_STRING "HIP"
+
+template <class T>
+class HIPStream : public Stream<T>
+{
+  protected:
+    // Size of arrays
+    unsigned int array_size;
+
+    // Host array for partial sums for dot kernel
+    T *sums;
+
+    // Device side pointers to arrays
+    T *d_a;
+    T *d_b;
+    T *d_c;
+    T *d_sum;
+
+
+  public:
+
+    HIPStream(const unsigned int, const int);
+    ~HIPStream();
+
+    virtual void copy() override;
+    virtual void add() override;
+    virtual void mul() override;
+    virtual void triad() override;
+    virtual T dot() override;
+
+    virtual void init_arrays(T initA, T initB, T initC) override;
+    virtual void read_arrays(std::vector<T>& a, std::vector<T>& b, std::vector<T>& c) override;
+
+};
+#endif
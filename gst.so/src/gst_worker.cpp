@@ -0,0 +1,807 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/gst_worker.h"
+
+#include <math.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include <memory>
+#include <iostream>
+
+#include "include/rvs_blas.h"
+#include "include/rvs_module.h"
+#include "include/rvsloglp.h"
+#include "include/rvsstopwatch.h"
+
+#define MODULE_NAME                             "gst"
+
+#define GST_MEM_ALLOC_ERROR                     "memory allocation error!"
+#define GST_BLAS_ERROR                          "memory/blas error!"
+#define GST_BLAS_MEMCPY_ERROR                   "HostToDevice mem copy error!"
+
+#define GST_MAX_GFLOPS_OUTPUT_KEY               "Gflop"
+#define GST_FLOPS_PER_OP_OUTPUT_KEY             "flops_per_op"
+#define GST_BYTES_COPIED_PER_OP_OUTPUT_KEY      "bytes_copied_per_op"
+#define GST_TRY_OPS_PER_SEC_OUTPUT_KEY          "try_ops_per_sec"
+
+#define GST_LOG_GFLOPS_INTERVAL_KEY             "Gflops"
+#define GST_LOG_WALL_GFLOPS_KEY                 "wall_Gflops"
+#define GST_RUN_GFLOPS_KEY                      "run_Gflops"
+#define GST_RUN_WALL_GFLOPS_KEY                 "run_wall_Gflops"
+#define GST_JSON_LOG_GPU_ID_KEY                 "gpu_id"
+#define GST_SEED_KEY                            "seed"
+
+#define GST_SETPOINT_KEY                        "setpoint"
+#define GST_STRESS_VIOLATIONS_KEY               "stress_violations"
+
+#define NMAX_MS_GPU_RUN_PEAK_PERFORMANCE        1000
+//! rate controller measurement window
+#define GST_CONTROL_WINDOW_MS                   500
+#define USLEEP_MAX_VAL                          (1000000 - 1)
+
+#define GST_COPY_MATRIX_MSG                     "copy matrix"
+#define GST_START_MSG                           "start"
+#define GST_PASS_KEY                            "pass"
+#define GST_RAMP_EXCEEDED_MSG                   "ramp time exceeded"
+#define GST_TARGET_ACHIEVED_MSG                 "target achieved"
+#define GST_STRESS_VIOLATION_MSG                "stress violation"
+
+using std::string;
+
+bool GSTWorker::bjson = false;
+
+GSTWorker::GSTWorker() {}
+GSTWorker::~GSTWorker() {}
+
+/**
+ * @brief performs the rvsBlas setup
+ * @param error pointer to a memory location where the error code will be stored
+ * @param err_description stores the error description if any
+ */
+void GSTWorker::setup_blas(int *error, string *err_description) {
+    *error = 0;
+    // setup rvsBlas
+    gpu_blas = std::unique_ptr<rvs_blas>(
+        new rvs_blas(gpu_device_index, matrix_size_a, matrix_size_b,
+                        matrix_size_c, gst_trans_a, gst_trans_b,
+                        gst_alpha_val, gst_beta_val, 
+                        gst_lda_offset, gst_ldb_offset, gst_ldc_offset,
+                        gst_ops_type));
+
+    if (!gpu_blas) {
+        *error = 1;
+        *err_description = GST_MEM_ALLOC_ERROR;
+        return;
+    }
+
+    if (gpu_blas->error()) {
+        *error = 1;
+        *err_description = GST_MEM_ALLOC_ERROR;
+        return;
+    }
+
+    // log the seed so that matrix data can be reproduced
+    string msg = "[" + action_name + "] " + MODULE_NAME + " " +
+            std::to_string(gpu_id) + " " + GST_SEED_KEY + " " +
+            std::to_string(seed);
+    rvs::lp::Log(msg, rvs::loginfo);
+    log_to_json(GST_SEED_KEY, std::to_string(seed), rvs::loginfo);
+
+    // generate random matrix & copy it to the GPU
+    gpu_blas->set_seed(seed);
+    gpu_blas->generate_random_matrix_data();
+    if (!copy_matrix) {
+        // copy matrix only once
+        if (!gpu_blas->copy_data_to_gpu()) {
+            *error = 1;
+            *err_description = GST_BLAS_MEMCPY_ERROR;
+        }
+    }
+}
+
+/**
+ * @brief performs the ramp-up on the given GPU (attempts to reach the given 
+ * target stress Gflops)
+ * @param error pointer to a memory location where the error code will be stored
+ * @param err_description stores the error description if any
+ * @return true if target stress is achieved within the ramp_interval,
+ * false otherwise
+ */
+bool GSTWorker::do_gst_ramp(int *error, string *err_description) {
+    double seconds_elapsed, curr_gflops, setpoint;
+    uint64_t nanos_sgemm_ops;
+    double gpu_ms, interval_gpu_ms = 0;
+    // host time of each GEMM in the current log interval
+    rvs::interval_accumulator interval_wall;
+    string msg;
+
+    // make sure that the ramp_interval & duration are not less than
+    // NMAX_MS_GPU_RUN_PEAK_PERFORMANCE (e.g.: 1000)
+    if (run_duration_ms < NMAX_MS_GPU_RUN_PEAK_PERFORMANCE)
+        run_duration_ms += NMAX_MS_GPU_RUN_PEAK_PERFORMANCE;
+
+    if (ramp_interval < NMAX_MS_GPU_RUN_PEAK_PERFORMANCE)
+        ramp_interval += NMAX_MS_GPU_RUN_PEAK_PERFORMANCE;
+
+    // stage 1. setup rvs blas
+    setup_blas(error, err_description);
+    if (*error)
+        return false;
+
+    // check if stop signal was received
+    if (rvs::lp::Stopping())
+        return false;
+
+    // stage 3. pace the GEMMs to achieve the desired Gflops
+    init_pace();
+
+    rvs::stopwatch gst_run_timer;
+    rvs::stopwatch gst_log_interval_timer;
+
+    for (;;) {
+        // check if stop signal was received
+        if (rvs::lp::Stopping())
+            return false;
+
+        if (gst_run_timer.elapsed_ns() > (ramp_interval -
+                NMAX_MS_GPU_RUN_PEAK_PERFORMANCE) * rvs::NS_PER_MS)
+            return false;
+
+        // wait until the rate controller admits the next GEMM
+        if (!pace_gemm())
+            return false;
+
+        if (copy_matrix) {
+            // Genrate random matrix data
+            gpu_blas->generate_random_matrix_data();
+            // copy matrix before each GEMM
+            if (!gpu_blas->copy_data_to_gpu()) {
+                *error = 1;
+                *err_description = GST_BLAS_MEMCPY_ERROR;
+                return false;
+            }
+        }
+
+        {
+            rvs::scoped_stopwatch gemm_timer(&interval_wall);
+
+            // run GEMM & wait for completion
+            if (!gpu_blas->run_blass_gemm() || !gpu_blas->wait_gemm(&gpu_ms)) {
+                *error = 1;
+                *err_description = GST_BLAS_ERROR;
+                return false;
+            }
+        }
+
+        interval_gpu_ms += gpu_ms;
+
+        if (update_pace(&curr_gflops, &setpoint) &&
+                fabs(curr_gflops - setpoint) <= setpoint * tolerance / 2) {
+            ramp_actual_time = gst_run_timer.elapsed_ms() +
+                        NMAX_MS_GPU_RUN_PEAK_PERFORMANCE;
+            return true;
+        }
+
+        nanos_sgemm_ops = gst_log_interval_timer.elapsed_ns();
+        if (nanos_sgemm_ops >= log_interval * rvs::NS_PER_MS) {
+            // compute the GFLOPS
+            seconds_elapsed = static_cast<double>
+                                (nanos_sgemm_ops) / rvs::NS_PER_SEC;
+            if (seconds_elapsed > 0 && interval_gpu_ms > 0) {
+                log_interval_gflops(gpu_blas->gemm_gflop_count() *
+                                    interval_wall.count() /
+                                    interval_gpu_ms / 1e6,
+                                    gpu_blas->gemm_gflop_count() *
+                                    interval_wall.count() /
+                                    interval_wall.total_sec() / 1e9);
+            }
+
+            interval_gpu_ms = 0;
+            interval_wall.reset();
+            gst_log_interval_timer.start();
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief restarts the rate controller and the target stress profile
+ */
+void GSTWorker::init_pace(void) {
+    rate_ctl.reset(new rvs::rate_controller(
+        gpu_blas->gemm_gflop_count() / 1e9, rvs::rate_controller::params()));
+    profile_start_ns = rvs::stopwatch::now_ns();
+    pace_window_start_ns = profile_start_ns;
+    pace_ops = 0;
+}
+
+/**
+ * @brief returns the Gflops requested at the given time
+ * @param profile_ns time since the start of the profile (ns)
+ * @return requested Gflops
+ */
+double GSTWorker::get_setpoint(uint64_t profile_ns) {
+    if (hold_profile)
+        return stress_profile.value(profile_ns);
+    return target_stress;
+}
+
+/**
+ * @brief sleeps until the rate controller admits the next GEMM
+ * @return true if the GEMM may be queued, false if stop was requested
+ */
+bool GSTWorker::pace_gemm(void) {
+    for (;;) {
+        if (rvs::lp::Stopping())
+            return false;
+
+        uint64_t now = rvs::stopwatch::now_ns() - profile_start_ns;
+        uint64_t delay = rate_ctl->next_delay(now, get_setpoint(now));
+        if (delay == 0) {
+            rate_ctl->consume();
+            return true;
+        }
+
+        // wake up now and then to check for stop signal
+        delay = std::min<uint64_t>(delay,
+                                   GST_CONTROL_WINDOW_MS * rvs::NS_PER_MS);
+        usleep_ex(delay / rvs::NS_PER_US + 1);
+    }
+}
+
+/**
+ * @brief counts a completed GEMM and, at the end of a control window,
+ * feeds the Gflops measured over the window back to the rate controller
+ * @param gflops [out] Gflops measured over the window
+ * @param setpoint [out] Gflops requested over the window
+ * @return true if a control window ended, false otherwise
+ */
+bool GSTWorker::update_pace(double *gflops, double *setpoint) {
+    uint64_t now = rvs::stopwatch::now_ns();
+
+    pace_ops++;
+    if (now - pace_window_start_ns < GST_CONTROL_WINDOW_MS * rvs::NS_PER_MS)
+        return false;
+
+    // window ends on GEMM completion so that it holds whole GEMMs
+    double seconds = static_cast<double>(now - pace_window_start_ns) /
+                     rvs::NS_PER_SEC;
+    *gflops = gpu_blas->gemm_gflop_count() * pace_ops / seconds / 1e9;
+    *setpoint = get_setpoint((pace_window_start_ns + now) / 2 -
+                             profile_start_ns);
+    rate_ctl->update(now - profile_start_ns, *setpoint, *gflops);
+
+    pace_window_start_ns = now;
+    pace_ops = 0;
+    return true;
+}
+
+/**
+ * @brief logs the Gflops computed over the last log_interval period 
+ * @param gflops_interval the Gflops that the GPU achieved
+ */
+void GSTWorker::check_target_stress(double gflops_interval) {
+    string msg;
+    bool result;
+
+    if(gflops_interval >= target_stress){
+           result = true;
+    }else{
+           result = false;
+    }
+
+    msg = "[" + action_name + "] " + MODULE_NAME + " " +
+              std::to_string(gpu_id) + " " + GST_LOG_GFLOPS_INTERVAL_KEY + " " + std::to_string(gflops_interval) + " " +
+              "Target stress :" + " " + std::to_string(target_stress) + " met :" + (result ? "TRUE" : "FALSE");
+    rvs::lp::Log(msg, rvs::logresults);
+
+    log_to_json(GST_LOG_GFLOPS_INTERVAL_KEY, std::to_string(gflops_interval),
+                rvs::loginfo);
+}
+
+
+
+/**
+ * @brief logs the Gflops computed over the last log_interval period 
+ * @param gflops_interval the Gflops that the GPU achieved (GPU time)
+ * @param wall_gflops_interval the same Gflops over host wall-clock time
+ */
+void GSTWorker::log_interval_gflops(double gflops_interval,
+                                    double wall_gflops_interval) {
+    string msg;
+    msg = "[" + action_name + "] " + MODULE_NAME + " " +
+            std::to_string(gpu_id) + " " + GST_LOG_GFLOPS_INTERVAL_KEY + " " +
+            std::to_string(gflops_interval) + " " +
+            GST_LOG_WALL_GFLOPS_KEY + " " +
+            std::to_string(wall_gflops_interval);
+    rvs::lp::Log(msg, rvs::logresults);
+
+    log_to_json(GST_LOG_GFLOPS_INTERVAL_KEY, std::to_string(gflops_interval),
+                rvs::loginfo);
+    log_to_json(GST_LOG_WALL_GFLOPS_KEY, std::to_string(wall_gflops_interval),
+                rvs::loginfo);
+}
+
+/**
+ * @brief logs the Gflops over the whole stress test
+ */
+void GSTWorker::log_run_gflops(void) {
+    if (run_gpu_ms <= 0 || run_wall_ms <= 0)
+        return;
+
+    double gflops = gpu_blas->gemm_gflop_count() * run_gemms /
+                    run_gpu_ms / 1e6;
+    double wall_gflops = gpu_blas->gemm_gflop_count() * run_gemms /
+                         run_wall_ms / 1e6;
+
+    string msg = "[" + action_name + "] " + MODULE_NAME + " " +
+            std::to_string(gpu_id) + " " + GST_RUN_GFLOPS_KEY + " " +
+            std::to_string(gflops) + " " + GST_LOG_WALL_GFLOPS_KEY + " " +
+            std::to_string(wall_gflops) + " gemms " +
+            std::to_string(run_gemms);
+    rvs::lp::Log(msg, rvs::loginfo);
+
+    log_to_json(GST_RUN_GFLOPS_KEY, std::to_string(gflops), rvs::loginfo);
+    log_to_json(GST_RUN_WALL_GFLOPS_KEY, std::to_string(wall_gflops),
+                rvs::loginfo);
+}
+
+/**
+ * @brief checks for Gflops violation 
+ * @param gflops_interval the Gflops that the GPU achieved over the last
+ * control window
+ * @param setpoint the Gflops requested over the same window
+ * @return true if this gflops violates the bounds, false otherwise
+ */
+bool GSTWorker::check_gflops_violation(double gflops_interval,
+                                       double setpoint) {
+    string msg;
+
+    if (!(gflops_interval > setpoint - setpoint * tolerance &&
+            gflops_interval < setpoint + setpoint * tolerance)) {
+        msg = "[" + action_name + "] " + MODULE_NAME + " " +
+                std::to_string(gpu_id) + " " + GST_STRESS_VIOLATION_MSG + " " +
+                std::to_string(gflops_interval) + " " +
+                GST_SETPOINT_KEY + " " + std::to_string(setpoint);
+        rvs::lp::Log(msg, rvs::loginfo);
+
+        log_to_json(GST_STRESS_VIOLATION_MSG, std::to_string(gflops_interval),
+                    rvs::loginfo);
+        return true;
+    }
+
+
+    return false;
+}
+
+/**
+ * @brief performs the stress test on the given GPU
+ * @param error pointer to a memory location where the error code will be stored
+ * @param err_description stores the error description if any
+ * @return true if stress violations is less than max_violations, false otherwise
+ */
+bool GSTWorker::do_gst_stress_test(int *error, std::string *err_description) {
+    uint64_t num_sgemm_ops = 0, completed = 0;
+    uint64_t total_milliseconds, log_interval_nanoseconds;
+    double seconds_elapsed, gflops_interval, wall_gflops_interval;
+    double gpu_ms, interval_gpu_ms, interval_wall_ms;
+    // host time of each GEMM in the current log interval
+    rvs::interval_accumulator interval_wall;
+    string msg;
+
+    *error = 0;
+    max_gflops = 0;
+    max_gflops_wall = 0;
+    run_gemms = 0;
+    run_gpu_ms = 0;
+    run_wall_ms = 0;
+    num_sgemm_ops = 0;
+    interval_gpu_ms = 0;
+    interval_wall_ms = 0;
+
+    // keep several GEMMs queued so that the GPU never idles between them
+    bool inflight = gemm_streams > 1 || gemm_queue_depth > 1;
+    if (inflight && !gpu_blas->init_inflight(gemm_streams, gemm_queue_depth)) {
+        *error = 1;
+        *err_description = GST_BLAS_ERROR;
+        return false;
+    }
+
+    rvs::stopwatch gst_run_timer;
+    rvs::stopwatch gst_log_interval_timer;
+
+    for (;;) {
+        // check if stop signal was received
+        if (rvs::lp::Stopping())
+            return false;
+
+        if (copy_matrix) {
+            // queued GEMMs read the matrices being overwritten
+            if (inflight) {
+                if (!gpu_blas->drain_gemms(&completed, &gpu_ms)) {
+                    *error = 1;
+                    *err_description = GST_BLAS_ERROR;
+                    return false;
+                }
+                num_sgemm_ops += completed;
+                interval_gpu_ms += gpu_ms;
+            }
+
+            // copy matrix before each GEMM
+            if (!gpu_blas->copy_data_to_gpu()) {
+                *error = 1;
+                *err_description = GST_BLAS_MEMCPY_ERROR;
+                return false;
+            }
+        }
+
+        if (inflight) {
+            // queue GEMM, sleeps until the oldest one completes if full
+            if (!gpu_blas->submit_gemm(&completed, &gpu_ms)) {
+                *error = 1;
+                *err_description = GST_BLAS_ERROR;
+                return false;
+            }
+            num_sgemm_ops += completed;
+            interval_gpu_ms += gpu_ms;
+        } else {
+            rvs::scoped_stopwatch gemm_timer(&interval_wall);
+
+            // run GEMM & wait for completion
+            if (!gpu_blas->run_blass_gemm() || !gpu_blas->wait_gemm(&gpu_ms)) {
+                *error = 1;
+                *err_description = GST_BLAS_ERROR;
+                return false;
+            }
+
+            num_sgemm_ops++;
+            interval_gpu_ms += gpu_ms;
+        }
+
+        total_milliseconds = gst_run_timer.elapsed_ms();
+        log_interval_nanoseconds = gst_log_interval_timer.elapsed_ns();
+
+        if (log_interval_nanoseconds >= log_interval * rvs::NS_PER_MS &&
+                num_sgemm_ops > 0) {
+            seconds_elapsed = static_cast<double> (log_interval_nanoseconds) /
+                                rvs::NS_PER_SEC;
+            // GEMMs in flight complete back to back during the interval
+            interval_wall_ms = inflight ? seconds_elapsed * 1000 :
+                               interval_wall.total_sec() * 1000;
+
+            if (interval_gpu_ms > 0 && interval_wall_ms > 0) {
+                gflops_interval = gpu_blas->gemm_gflop_count() *
+                    num_sgemm_ops / interval_gpu_ms / 1e6;
+                wall_gflops_interval = gpu_blas->gemm_gflop_count() *
+                    num_sgemm_ops / interval_wall_ms / 1e6;
+
+                if (gflops_interval > max_gflops) {
+                    max_gflops = gflops_interval;
+                    max_gflops_wall = wall_gflops_interval;
+                }
+
+                log_interval_gflops(max_gflops, max_gflops_wall);
+
+                run_gemms += num_sgemm_ops;
+                run_gpu_ms += interval_gpu_ms;
+                run_wall_ms += interval_wall_ms;
+
+                // reset time & gflops related data
+                num_sgemm_ops = 0;
+                interval_gpu_ms = 0;
+                interval_wall.reset();
+                gst_log_interval_timer.start();
+            }
+        }
+
+
+        if(!gst_hot_calls) {
+               msg = "[" + action_name + "] " + MODULE_NAME + " " +
+                           std::to_string(gpu_id) + " " + GST_START_MSG + " " +
+                           " Execution time in milliseconds :" + std::to_string(total_milliseconds) +
+                           " run_duration_ms :" + std::to_string(run_duration_ms); 
+               rvs::lp::Log(msg, rvs::logtrace);
+               if (total_milliseconds >= run_duration_ms)
+                      break;
+        }else{
+            msg = "[" + action_name + "] " + MODULE_NAME + " " +
+                   std::to_string(gpu_id) + " " + GST_START_MSG + " " +
+                   " Executing hot calls loop :" + std::to_string(gst_hot_calls); 
+            rvs::lp::Log(msg, rvs::logtrace);
+           
+            gst_hot_calls--; 
+        }
+    }
+
+    if (inflight) {
+        if (!gpu_blas->drain_gemms(&completed, &gpu_ms)) {
+            *error = 1;
+            *err_description = GST_BLAS_ERROR;
+            return false;
+        }
+        num_sgemm_ops += completed;
+        interval_gpu_ms += gpu_ms;
+        interval_wall_ms = gst_log_interval_timer.elapsed_sec() * 1000;
+    } else {
+        interval_wall_ms = interval_wall.total_sec() * 1000;
+    }
+
+    // GEMMs of the last partial interval
+    run_gemms += num_sgemm_ops;
+    run_gpu_ms += interval_gpu_ms;
+    run_wall_ms += interval_wall_ms;
+    log_run_gflops();
+
+    return true;
+}
+
+/**
+ * @brief holds the target stress profile on the given GPU for the rest of
+ * the test duration
+ * @param error pointer to a memory location where the error code will be stored
+ * @param err_description stores the error description if any
+ * @return true if stress violations is not more than max_violations,
+ * false otherwise
+ */
+bool GSTWorker::do_gst_hold_profile(int *error, std::string *err_description) {
+    uint64_t num_gflops_violations = 0;
+    double gflops_interval, wall_gflops_interval, curr_gflops, setpoint;
+    double gpu_ms, interval_gpu_ms = 0;
+    // host time of each GEMM in the current log interval
+    rvs::interval_accumulator interval_wall;
+    string msg;
+
+    *error = 0;
+    max_gflops = 0;
+    max_gflops_wall = 0;
+    run_gemms = 0;
+    run_gpu_ms = 0;
+    run_wall_ms = 0;
+
+    rvs::stopwatch gst_run_timer;
+    rvs::stopwatch gst_log_interval_timer;
+
+    while (gst_run_timer.elapsed_ms() < run_duration_ms) {
+        // wait until the rate controller admits the next GEMM
+        if (!pace_gemm())
+            return false;
+
+        if (copy_matrix) {
+            // copy matrix before each GEMM
+            if (!gpu_blas->copy_data_to_gpu()) {
+                *error = 1;
+                *err_description = GST_BLAS_MEMCPY_ERROR;
+                return false;
+            }
+        }
+
+        {
+            rvs::scoped_stopwatch gemm_timer(&interval_wall);
+
+            // run GEMM & wait for completion
+            if (!gpu_blas->run_blass_gemm() || !gpu_blas->wait_gemm(&gpu_ms)) {
+                *error = 1;
+                *err_description = GST_BLAS_ERROR;
+                return false;
+            }
+        }
+
+        interval_gpu_ms += gpu_ms;
+
+        if (update_pace(&curr_gflops, &setpoint) &&
+                check_gflops_violation(curr_gflops, setpoint))
+            num_gflops_violations++;
+
+        if (gst_log_interval_timer.elapsed_ns() >=
+                log_interval * rvs::NS_PER_MS && interval_gpu_ms > 0) {
+            gflops_interval = gpu_blas->gemm_gflop_count() *
+                interval_wall.count() / interval_gpu_ms / 1e6;
+            wall_gflops_interval = gpu_blas->gemm_gflop_count() *
+                interval_wall.count() / interval_wall.total_sec() / 1e9;
+
+            if (gflops_interval > max_gflops) {
+                max_gflops = gflops_interval;
+                max_gflops_wall = wall_gflops_interval;
+            }
+
+            log_interval_gflops(gflops_interval, wall_gflops_interval);
+
+            run_gemms += interval_wall.count();
+            run_gpu_ms += interval_gpu_ms;
+            run_wall_ms += interval_wall.total_sec() * 1000;
+
+            interval_gpu_ms = 0;
+            interval_wall.reset();
+            gst_log_interval_timer.start();
+        }
+    }
+
+    // GEMMs of the last partial interval
+    run_gemms += interval_wall.count();
+    run_gpu_ms += interval_gpu_ms;
+    run_wall_ms += interval_wall.total_sec() * 1000;
+    log_run_gflops();
+
+    bool result = num_gflops_violations <= max_violations;
+    msg = "[" + action_name + "] " + MODULE_NAME + " " +
+            std::to_string(gpu_id) + " " + GST_STRESS_VIOLATIONS_KEY + " " +
+            std::to_string(num_gflops_violations) + " " + GST_PASS_KEY +
+            ": " + (result ? "TRUE" : "FALSE");
+    rvs::lp::Log(msg, rvs::logresults);
+    log_to_json(GST_STRESS_VIOLATIONS_KEY,
+                std::to_string(num_gflops_violations), rvs::loginfo);
+    log_to_json(GST_PASS_KEY, (result ?
+            GST_RESULT_PASS_MESSAGE : GST_RESULT_FAIL_MESSAGE),
+            rvs::logresults);
+
+    return result;
+}
+
+/**
+ * @brief performs the stress test on the given GPU
+ */
+void GSTWorker::run() {
+    string msg, err_description;
+    int error = 0;
+    bool gst_test_passed = true;
+
+    max_gflops = 0;
+    max_gflops_wall = 0;
+
+    // log GST stress test - start message
+    msg = "[" + action_name + "] " + MODULE_NAME + " " +
+            std::to_string(gpu_id) + " " + GST_START_MSG + " " +
+            " Starting the GST stress test "; 
+    rvs::lp::Log(msg, rvs::logtrace);
+
+    log_to_json(GST_START_MSG, std::to_string(target_stress), rvs::loginfo);
+    log_to_json(GST_COPY_MATRIX_MSG, (copy_matrix ? "true":"false"),
+                rvs::loginfo);
+
+    // let the GPU ramp-up and check the result
+    bool ramp_up_success = do_gst_ramp(&error, &err_description);
+
+    // GPU was not able to do the processing (HIP/rocBlas error(s) occurred)
+    if (error) {
+        string msg = "[" + action_name + "] " + MODULE_NAME + " "
+                        + std::to_string(gpu_id) + " " + err_description;
+        rvs::lp::Log(msg, rvs::logerror);
+        log_to_json("err", err_description, rvs::logerror);
+
+        return;
+    }
+
+    // the GPU succeeded to achieve the target_stress GFLOPS
+    // continue with the same workload for the rest of the test duration
+    msg = "[" + action_name + "] " + MODULE_NAME + " " +
+                std::to_string(gpu_id) + " " + " GST ramp completed for interval :" + " " +
+                std::to_string(ramp_interval);
+    rvs::lp::Log(msg, rvs::loginfo);
+    log_to_json(GST_TARGET_ACHIEVED_MSG, std::to_string(target_stress),
+                    rvs::loginfo);
+    if (run_duration_ms > 0) {
+            if (hold_profile)
+                gst_test_passed = do_gst_hold_profile(&error,
+                                                      &err_description);
+            else
+                gst_test_passed = do_gst_stress_test(&error, &err_description);
+            // check if stop signal was received
+            if (rvs::lp::Stopping())
+                return;
+
+            if (error) {
+                // GPU didn't complete the test (HIP/rocBlas error(s) occurred)
+                string msg = "[" + action_name + "] " + MODULE_NAME + " " +
+                                std::to_string(gpu_id) + " " + err_description;
+                rvs::lp::Log(msg, rvs::logerror);
+                log_to_json("err", err_description, rvs::logerror);
+                return;
+            }
+    }
+
+    log_interval_gflops(max_gflops, max_gflops_wall);
+    // pass/fail of a held profile is decided by the stress violations
+    if (!hold_profile)
+        check_target_stress(max_gflops);
+}
+
+/**
+ * @brief logs the GST test result
+ * @param gst_test_passed true if test succeeded, false otherwise
+ */
+void GSTWorker::log_gst_test_result(bool gst_test_passed) {
+    string msg;
+
+    double flops_per_op = (2 * (static_cast<double>(gpu_blas->get_m())/1000) *
+                                (static_cast<double>(gpu_blas->get_n())/1000) *
+                                (static_cast<double>(gpu_blas->get_k())/1000));
+    msg = "[" + action_name + "] " + MODULE_NAME + " " +
+        std::to_string(gpu_id) + " " + GST_MAX_GFLOPS_OUTPUT_KEY + ": " +
+        std::to_string(max_gflops) + " " + GST_FLOPS_PER_OP_OUTPUT_KEY + ": " +
+        std::to_string(flops_per_op) + "x1e9" + " " +
+        GST_BYTES_COPIED_PER_OP_OUTPUT_KEY + ": " +
+        std::to_string(gpu_blas->get_bytes_copied_per_op()) +
+        " " + GST_TRY_OPS_PER_SEC_OUTPUT_KEY + ": "+
+        std::to_string(target_stress / gpu_blas->gemm_gflop_count()) +
+        " "  ;
+    rvs::lp::Log(msg, rvs::logresults);
+
+    log_to_json(GST_MAX_GFLOPS_OUTPUT_KEY, std::to_string(max_gflops),
+                rvs::loginfo);
+    log_to_json(GST_FLOPS_PER_OP_OUTPUT_KEY, std::to_string(flops_per_op) +
+                "x1e9", rvs::loginfo);
+    log_to_json(GST_BYTES_COPIED_PER_OP_OUTPUT_KEY,
+                std::to_string(gpu_blas->get_bytes_copied_per_op()),
+                rvs::loginfo);
+    log_to_json(GST_TRY_OPS_PER_SEC_OUTPUT_KEY,
+                std::to_string(target_stress / gpu_blas->gemm_gflop_count()),
+                rvs::loginfo);
+    log_to_json(GST_PASS_KEY, (gst_test_passed ?
+            GST_RESULT_PASS_MESSAGE : GST_RESULT_FAIL_MESSAGE),
+            rvs::logresults);
+}
+
+/**
+ * @brief logs a message to JSON
+ * @param key info type
+ * @param value message to log
+ * @param log_level the level of log (e.g.: info, results, error)
+ */
+void GSTWorker::log_to_json(const std::string &key, const std::string &value,
+                     int log_level) {
+    if (GSTWorker::bjson) {
+        unsigned int sec;
+        unsigned int usec;
+
+        rvs::lp::get_ticks(&sec, &usec);
+        void *json_node = rvs::lp::LogRecordCreate(MODULE_NAME,
+                            action_name.c_str(), log_level, sec, usec);
+        if (json_node) {
+            rvs::lp::AddString(json_node, GST_JSON_LOG_GPU_ID_KEY,
+                            std::to_string(gpu_id));
+            rvs::lp::AddString(json_node, key, value);
+            rvs::lp::LogRecordFlush(json_node);
+        }
+    }
+}
+
+/**
+ * @brief extends the usleep for more than 1000000us
+ * @param microseconds us to sleep
+ */
+void GSTWorker::usleep_ex(uint64_t microseconds) {
+    uint64_t total_microseconds = microseconds;
+    for (;;) {
+         if (total_microseconds > USLEEP_MAX_VAL) {
+            usleep(USLEEP_MAX_VAL);
+            total_microseconds -= USLEEP_MAX_VAL;
+        } else {
+            usleep(total_microseconds);
+            return;
+        }
+    }
+}
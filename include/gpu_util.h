@@ -28,6 +28,7 @@
 #include <stdint.h>
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 #define KFD_SYS_PATH_NODES              "/sys/class/kfd/kfd/topology/nodes"
 #define KFD_PATH_MAX_LENGTH             256
@@ -43,6 +44,23 @@ namespace rvs {
 
   ::std::string bdf2string(uint32_t BDF);
 
+/**
+ * @class kfd_node
+ *
+ * @brief GPU properties read from one KFD topology node
+ *
+ */
+struct kfd_node {
+  //! KFD topology node number
+  uint16_t node_id;
+  //! GPU ID as found in gpu_id file
+  uint16_t gpu_id;
+  //! location ID (PCI BDF) of the GPU
+  uint16_t location_id;
+  //! PCI device ID of the GPU
+  uint16_t device_id;
+};
+
 /**
  * @class gpulist
  *
@@ -53,7 +71,9 @@ namespace rvs {
  */
 class gpulist {
  public:
-  static int Initialize();
+  static int Initialize(const char* NodesPath = KFD_SYS_PATH_NODES);
+  static int read_nodes(const char* NodesPath, std::vector<kfd_node>* pNodes);
+  static void get_nodes(std::vector<kfd_node>* pNodes);
 
   static int location2gpu(const uint16_t LocationID, uint16_t* pGpuID);
   static int gpu2location(const uint16_t GpuID, uint16_t* pLocationID);
@@ -72,6 +92,17 @@ class gpulist {
   static std::vector<uint16_t> device_id;
   //! Array of node IDs
   static std::vector<uint16_t> node_id;
+
+  static void build_index();
+
+  //! position in the arrays keyed by GPU ID
+  static std::unordered_map<uint16_t, size_t> gpu_index;
+  //! position in the arrays keyed by location ID
+  static std::unordered_map<uint16_t, size_t> location_index;
+  //! position in the arrays keyed by node ID
+  static std::unordered_map<uint16_t, size_t> node_index;
+  //! true once Initialize() succeeded
+  static bool b_initialized;
 };
 
 
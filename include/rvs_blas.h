@@ -32,18 +32,59 @@
 #include "include/hip/hip_runtime_api.h"
 #include <sys/time.h>
 
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class rvs_blas_engine
+ * @ingroup GST
+ *
+ * @brief matrices and GEMM call for one data type
+ *
+ * Implementations are created by rvs_blas_engine::create() for the
+ * requested ops type so that only memory for that type is allocated.
+ *
+ */
+class rvs_blas_engine {
+ public:
+    virtual ~rvs_blas_engine() {}
+
+    static rvs_blas_engine* create(const std::string& ops_type,
+                                   rocblas_int _size_a, rocblas_int _size_b,
+                                   rocblas_int _size_c);
+    static bool is_supported(const std::string& ops_type);
+
+    //! returns size of one matrix element in bytes
+    virtual size_t element_size(void) = 0;
+    //! allocates host memory for A, B and C
+    virtual bool allocate_host(void) = 0;
+    //! allocates GPU memory for A, B and C
+    virtual bool allocate_gpu(void) = 0;
+    //! fills host matrices with random data
+    virtual void generate(uint64_t seed, uint32_t stream) = 0;
+    //! copies host matrices to the GPU
+    virtual bool copy_to_gpu(void) = 0;
+    //! enqueues GEMM on the given handle
+    virtual bool gemm(rocblas_handle handle,
+                      rocblas_operation transa, rocblas_operation transb,
+                      rocblas_int m, rocblas_int n, rocblas_int k,
+                      float alpha, float beta,
+                      int lda, int ldb, int ldc) = 0;
+};
+
 /**
  * @class rvs_blas
  * @ingroup GST
  *
- * @brief implements the SGEMM logic
+ * @brief implements the GEMM logic
  *
  */
 class rvs_blas {
  public:
     rvs_blas(int _gpu_device_index, int _m, int _n, int _k, 
         int transa, int transb, float aplha, float beta, 
-        int lda, int ldb, int ldc);
+        int lda, int ldb, int ldc, std::string ops_type);
     ~rvs_blas();
 
     //! returns the GPU index
@@ -56,11 +97,13 @@ class rvs_blas {
     rocblas_int get_k(void) { return k; }
 
     //! computes the number of bytes which are copied to
-    //! the GPU for one SGEMM operation
+    //! the GPU for one GEMM operation
     uint64_t get_bytes_copied_per_op(void) {
-        return sizeof(float) * (size_a + size_b + size_c);
+        if (!engine)
+            return 0;
+        return engine->element_size() * (size_a + size_b + size_c);
     }
-    //! computes the gflop for a SGEMM operation
+    //! computes the gflop for a GEMM operation
     double gemm_gflop_count(void) {
         return static_cast<double>(2.0 * m * n * k);
     }
@@ -69,9 +112,15 @@ class rvs_blas {
     //! returns TRUE if an error occured
     bool error(void) { return is_error; }
     void generate_random_matrix_data(void);
-    bool copy_data_to_gpu(std::string);
-    bool run_blass_gemm(std::string);
+    void set_seed(uint64_t _seed);
+    bool copy_data_to_gpu(void);
+    bool run_blass_gemm(void);
     bool is_gemm_op_complete(void);
+    bool wait_gemm(double *gpu_ms);
+
+    bool init_inflight(int num_streams, int queue_depth);
+    bool submit_gemm(uint64_t *completed, double *gpu_ms);
+    bool drain_gemms(uint64_t *completed, double *gpu_ms);
 
  protected:
     //! GPU device index
@@ -93,33 +142,8 @@ class rvs_blas {
     //! Transpose matrix B
     rocblas_operation transb;
 
-    //SGEMM DECLARAION
-    //! pointer to device (GPU) memory
-    float *da;
-    //! pointer to device (GPU) memory
-    float *db;
-    //! pointer to device (GPU) memory
-    float *dc;
-    //! pointer to host memory
-    float *ha;
-    //! pointer to host memory
-    float *hb;
-    //! pointer to host memory
-    float *hc;
-
-    //DGEMM Declaration
-    //! pointer to device (GPU) memory
-    double *ddbla;
-    //! pointer to device (GPU) memory
-    double *ddblb;
-    //! pointer to device (GPU) memory
-    double *ddblc;
-    //! pointer to host memory
-    double *hdbla;
-    //! pointer to host memory
-    double *hdblb;
-    //! pointer to host memory
-    double *hdblc;
+    //! matrices and GEMM call for the selected ops type
+    std::unique_ptr<rvs_blas_engine> engine;
 
     //!GST Aplha Val 
     float blas_alpha_val;
@@ -131,40 +155,47 @@ class rvs_blas {
     int blas_ldb_offset;
     int blas_ldc_offset;
 
-    //HGEMM Declaration
-    //! pointer to device (GPU) memory
-    rocblas_half *dhlfa;
-    //! pointer to device (GPU) memory
-    rocblas_half *dhlfb;
-    //! pointer to device (GPU) memory
-    rocblas_half *dhlfc;
-    //! pointer to host memory
-    rocblas_half *hhlfa;
-    //! pointer to host memory
-    rocblas_half *hhlfb;
-    //! pointer to host memory
-    rocblas_half *hhlfc;
-
-    rocblas_half  hostarrayA;
-    rocblas_half  hostarrayB;
-    rocblas_half  hostarrayC;
-
     //! HIP API stream - used to query for GEMM completion
     hipStream_t hip_stream;
     //! rocBlas related handle
     rocblas_handle blas_handle;
     //! TRUE is rocBlas handle was successfully initialized
     bool is_handle_init;
+    //! recorded before each GEMM queued by run_blass_gemm()
+    hipEvent_t gemm_start;
+    //! recorded after each GEMM queued by run_blass_gemm()
+    hipEvent_t gemm_stop;
+    //! TRUE if gemm_start and gemm_stop were successfully created
+    bool is_event_init;
     //! rocBlas guard (prevents executing blass_gemm when there are mem errors)
     bool is_error;
+    //! seed for matrix data generation
+    uint64_t seed;
+    //! number of times matrix data was generated
+    uint32_t generation;
+
+    //! rocBlas handles used for GEMMs kept in flight (one per stream)
+    std::vector<rocblas_handle> inflight_handles;
+    //! HIP streams the in-flight GEMMs are spread over
+    std::vector<hipStream_t> inflight_streams;
+    //! start events of in-flight GEMMs (ring buffer, oldest at head)
+    std::vector<hipEvent_t> inflight_start;
+    //! completion events of in-flight GEMMs (ring buffer, oldest at head)
+    std::vector<hipEvent_t> inflight_stop;
+    //! max number of GEMMs in flight
+    size_t inflight_depth;
+    //! ring buffer index of the oldest in-flight GEMM
+    size_t inflight_head;
+    //! number of GEMMs in flight
+    size_t inflight_count;
+    //! TRUE if the slot before inflight_head holds the last retired GEMM
+    bool inflight_has_prev;
+    //! number of GEMMs submitted with submit_gemm()
+    uint64_t inflight_submitted;
 
     bool init_gpu_device(void);
-    bool allocate_gpu_matrix_mem(void);
-    void release_gpu_matrix_mem(void);
-
-    bool alocate_host_matrix_mem(void);
-    void release_host_matrix_mem(void);
-    float fast_pseudo_rand(u_long *nextr);
+    bool retire_gemm(double *gpu_ms);
+    void release_inflight(void);
 };
 
 #endif  // INCLUDE_RVS_BLAS_H_
@@ -39,6 +39,12 @@
 #define RVS_CONF_LOG_LEVEL_KEY          "cli.-d"
 #define RVS_CONF_BLOCK_SIZE_KEY         "block_size"
 #define RVS_CONF_B2B_BLOCK_SIZE_KEY     "b2b_block_size"
+#define RVS_CONF_PIPELINE_DEPTH_KEY     "pipeline_depth"
+#define RVS_CONF_PIPELINE_COPIES_KEY    "pipeline_copies"
+#define RVS_CONF_SCHEDULE_KEY           "schedule"
+#define RVS_CONF_ADAPTIVE_SWEEP_KEY     "adaptive_sweep"
+#define RVS_CONF_SWEEP_PLATEAU_KEY      "sweep_plateau"
+#define RVS_CONF_SWEEP_TOLERANCE_KEY    "sweep_tolerance"
 #define RVS_CONF_LINK_TYPE_KEY          "link_type"
 #define RVS_CONF_MONITOR_KEY            "monitor"
 
@@ -46,6 +52,9 @@
 #define DEFAULT_DURATION (10000u)
 #define DEFAULT_COUNT (1u)
 #define DEFAULT_WAIT (0u)
+#define DEFAULT_PIPELINE_COPIES (64u)
+#define DEFAULT_SWEEP_PLATEAU (90u)
+#define DEFAULT_SWEEP_TOLERANCE (5u)
 
 #define YAML_DEVICE_PROPERTY_ERROR      "Error while parsing <device> property"
 #define YAML_DEVICEID_PROPERTY_ERROR    "Error while parsing <deviceid> "\
@@ -0,0 +1,137 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSHISTOGRAM_H_
+#define INCLUDE_RVSHISTOGRAM_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "include/rvstransferstats.h"
+
+namespace rvs {
+
+/**
+ * @class latency_histogram
+ * @ingroup RVS
+ *
+ * @brief Fixed size log-linear histogram of nanosecond values
+ *
+ * Values are grouped in power-of-two ranges, each split into 64 linear
+ * sub-buckets, so any recorded value is reproduced within 1/64 (about
+ * 1.6%) from 1 ns up to about 68 s (larger values are clamped). Memory is
+ * fixed regardless of number of samples and histograms are merged by adding
+ * bucket counts.
+ *
+ * Samples are recorded by a single writer without locking; other threads
+ * may read or merge the histogram at any time.
+ *
+ */
+class latency_histogram {
+ public:
+  //! bits of value resolved exactly, values below 2^SUB_BITS are exact
+  static const uint32_t SUB_BITS = 7;
+  //! values are clamped to below 2^MAX_BITS ns
+  static const uint32_t MAX_BITS = 36;
+  //! total number of buckets
+  static const size_t BUCKETS =
+    (1u << SUB_BITS) + (MAX_BITS - SUB_BITS) * (1u << (SUB_BITS - 1));
+
+  latency_histogram() { reset(); }
+
+  latency_histogram(const latency_histogram&) = delete;
+  latency_histogram& operator=(const latency_histogram&) = delete;
+
+  void reset();
+  void record(uint64_t Ns);
+  void merge(const latency_histogram& Src);
+
+  //! Number of recorded values
+  uint64_t count() const { return num.load(std::memory_order_relaxed); }
+  //! Smallest recorded value (ns), 0 if none
+  uint64_t min() const {
+    return count() ? lowest.load(std::memory_order_relaxed) : 0;
+  }
+  //! Largest recorded value (ns)
+  uint64_t max() const { return highest.load(std::memory_order_relaxed); }
+  double mean() const;
+  uint64_t percentile(double Pct) const;
+
+  static size_t bucket(uint64_t Ns);
+  static uint64_t bucket_high(size_t Ix);
+
+ protected:
+  //! number of values per bucket
+  std::atomic<uint32_t> counts[BUCKETS];
+  //! number of recorded values
+  std::atomic<uint64_t> num;
+  //! sum of recorded values (ns)
+  std::atomic<uint64_t> sum;
+  //! smallest recorded value (ns)
+  std::atomic<uint64_t> lowest;
+  //! largest recorded value (ns)
+  std::atomic<uint64_t> highest;
+};
+
+/**
+ * @class latency_recorder
+ * @ingroup RVS
+ *
+ * @brief Keeps one latency_histogram per transfer block size
+ *
+ * Installed as transfer_sink of a worker's rvs::transfer_stats. Block sizes
+ * are set by init() before transfers start and do not change while
+ * recording, so readers need no locking. Each sample is recorded in the
+ * histogram of the largest block size not above it; samples smaller than
+ * all block sizes are ignored.
+ *
+ */
+class latency_recorder : public transfer_sink {
+ public:
+  void init(const std::vector<uint32_t>& Sizes);
+  void record(uint64_t Size, double Duration) override;
+
+  latency_histogram* find(uint64_t Size);
+  void merge(latency_histogram* pDst) const;
+
+  //! Number of block sizes
+  size_t size() const { return sizes.size(); }
+  //! Block size of Ix-th histogram (bytes)
+  uint64_t block_size(size_t Ix) const { return sizes[Ix]; }
+  //! Ix-th histogram
+  const latency_histogram& histogram(size_t Ix) const { return *hist[Ix]; }
+
+ protected:
+  //! sorted list of block sizes
+  std::vector<uint64_t> sizes;
+  //! histograms, one per block size
+  std::vector<std::unique_ptr<latency_histogram>> hist;
+};
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSHISTOGRAM_H_
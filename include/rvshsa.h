@@ -36,16 +36,22 @@
 #include <string>
 #include <vector>
 #include <iomanip>
+#include <map>
+#include <mutex>
+#include <utility>
 
 #include "hsa/hsa.h"
 #include "hsa/hsa_ext_amd.h"
 
+#include "include/rvshistogram.h"
+#include "include/rvshsawaiter.h"
+
 using std::string;
 using std::vector;
 
 #ifdef TRACEHSA
-  #define RVSHSATRACE_ rvs::lp::Log(std::string(__FILE__)+"   "+__func__+":"\
-  +std::to_string(__LINE__), rvs::logtrace);
+  #include "include/rvsloglp.h"
+  #define RVSHSATRACE_ RVSLOGSITE_(rvs::logtrace)
 #else
   #define RVSHSATRACE_
 #endif
@@ -108,6 +114,69 @@ class hsa {
     vector<size_t>                max_size_list;
   };
 
+/**
+ * @class TrafficBuffers
+ * @ingroup RVS
+ *
+ * @brief Buffers and completion signal for transfers between two agents
+ *
+ * Kept in a cache after use so that subsequent transfers between the same
+ * agents need not allocate memory and create signals.
+ *
+ */
+  struct TrafficBuffers {
+    //! source agent index in agent_list vector
+    int                           src_ix;
+    //! destination agent index in agent_list vector
+    int                           dst_ix;
+    //! size of both buffers in bytes
+    size_t                        capacity;
+    //! source memory pool
+    hsa_amd_memory_pool_t         src_pool;
+    //! destination memory pool
+    hsa_amd_memory_pool_t         dst_pool;
+    //! source buffer
+    void*                         src_ptr;
+    //! destination buffer
+    void*                         dst_ptr;
+    //! signal used to wait on copy operation
+    hsa_signal_t                  signal;
+    //! signals of copies in flight in pipelined mode
+    vector<hsa_signal_t>          pipe_signals;
+  };
+
+/**
+ * @class TrafficStats
+ * @ingroup RVS
+ *
+ * @brief Results of pipelined transfer
+ *
+ */
+  struct TrafficStats {
+    //! number of copies completed and timed (all directions)
+    uint32_t                      copies;
+    //! time from start of the first to end of the last timed copy (sec)
+    double                        duration;
+  };
+
+/**
+ * @class TopologyEntry
+ * @ingroup RVS
+ *
+ * @brief Link information between two agents
+ *
+ * Computed once for all pairs of agents during initialization.
+ *
+ */
+  struct TopologyEntry {
+    //! NUMA distance, NO_CONN if there is no path
+    uint32_t                      distance;
+    //! 0 - no access, 1 - Src can access Dst, 2 - both have access
+    int                           peer_status;
+    //! list of hops from source to destination
+    vector<linkinfo_t>            hops;
+  };
+
   //! constant for "no connection" distance value
   static const uint32_t NO_CONN = 0xFFFFFFFF;
 
@@ -156,13 +225,28 @@ class hsa {
 
   int SendTraffic(uint32_t SrcNode, uint32_t DstNode,
                   size_t   Size,    bool     bidirectional,
-                  double*  Duration);
+                  double*  Duration,
+                  hsa_wait_state_t WaitState = HSA_WAIT_STATE_ACTIVE);
+  int SendTrafficPipelined(uint32_t SrcNode, uint32_t DstNode,
+                           size_t Size, bool bidirectional,
+                           uint32_t Depth, uint32_t Count,
+                           TrafficStats* pStats,
+                           rvs::latency_histogram* pHist = nullptr);
+  int ReserveTraffic(uint32_t SrcNode, uint32_t DstNode,
+                     size_t MaxSize, bool bidirectional);
+  void ReleaseTrafficCache();
+  rvs::hsa_waiter* Waiter();
 
   int GetPeerStatus(uint32_t SrcNode, uint32_t DstNode);
   int GetPeerStatusAgent(const AgentInformation& SrcAgent,
                          const AgentInformation& DstAgent);
   int GetLinkInfo(uint32_t SrcNode, uint32_t DstNode,
                   uint32_t* pDistance, std::vector<linkinfo_t>* pInfoarr);
+  int GetNumaNode(uint32_t Node);
+  const TopologyEntry* GetTopology(uint32_t SrcNode, uint32_t DstNode);
+  int SaveTopology(const std::string& File);
+  int LoadTopology(const std::string& File);
+  static std::string LinkTypeName(hsa_amd_link_info_type_t Type);
   double GetCopyTime(bool bidirectional,
                      hsa_signal_t signal_fwd, hsa_signal_t signal_rev);
 
@@ -184,10 +268,38 @@ class hsa {
 
   static hsa_status_t ProcessAgent(hsa_agent_t agent, void* data);
   static hsa_status_t ProcessMemPool(hsa_amd_memory_pool_t pool, void* data);
+  void InitTopology();
+  static TopologyEntry NoConnection();
+  uint64_t TopologyHash();
+  int QueryLinkInfo(int SrcIx, int DstIx,
+                    uint32_t* pDistance, std::vector<linkinfo_t>* pInfoarr);
+
+  TrafficBuffers* AcquireTraffic(int SrcAgent, int DstAgent, size_t Size);
+  void ReleaseTraffic(TrafficBuffers* pBuffers);
+  void FreeTraffic(TrafficBuffers* pBuffers);
+  int PipeSignals(TrafficBuffers* pBuffers, uint32_t Depth);
+  hsa_status_t StartCopy(TrafficBuffers* pBuffers, size_t Size,
+                         hsa_signal_t Signal,
+                         const hsa_signal_t* pDep = nullptr);
 
  protected:
   //! pointer to RVS HSA singleton
   static rvs::hsa* pDsc;
+
+  //! agent_list index keyed by NUMA node
+  std::map<uint32_t, int> node_index;
+  //! link information for all pairs of agents, indexed src * N + dst
+  vector<TopologyEntry> topology;
+
+  //! idle transfer buffers keyed by (source, destination) agent index
+  std::multimap<std::pair<int, int>, TrafficBuffers*> traffic_cache;
+  //! synchronizes access to traffic_cache
+  std::mutex traffic_mutex;
+
+  //! copy completion engine, created on first use
+  rvs::hsa_waiter* waiter;
+  //! synchronizes creation of waiter
+  std::mutex waiter_mutex;
 };
 
 }  // namespace rvs
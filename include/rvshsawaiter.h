@@ -0,0 +1,139 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSHSAWAITER_H_
+#define INCLUDE_RVSHSAWAITER_H_
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "hsa/hsa.h"
+#include "hsa/hsa_ext_amd.h"
+
+namespace rvs {
+
+/**
+ * @class hsa_waiter
+ * @ingroup RVS
+ *
+ * @brief Completion engine for asynchronous HSA copies
+ *
+ * A small, fixed set of waiter threads multiplexes completion signals of
+ * all in-flight copies. Each waiter blocks in hsa_amd_signal_wait_any()
+ * on the signals submitted to it and hands completions back to their
+ * owners through a hsa_waiter::group. The number of waiter threads
+ * depends on the number of CPU cores, not on the number of copies.
+ *
+ */
+class hsa_waiter {
+ public:
+/**
+ * @class group
+ * @ingroup RVS
+ *
+ * @brief Set of copies a worker waits for
+ *
+ */
+  class group {
+   public:
+    group();
+    explicit group(const std::function<void()>& OnDone);
+    void wait();
+    void hold();
+    void release();
+
+   protected:
+    //! protects pending
+    std::mutex mtx;
+    //! signaled when pending drops to zero
+    std::condition_variable cv;
+    //! number of submitted copies not completed yet plus holds
+    int pending;
+    //! called when pending drops to zero, if set
+    std::function<void()> on_done;
+
+    friend class hsa_waiter;
+  };
+
+ public:
+  explicit hsa_waiter(size_t Threads = 0);
+  virtual ~hsa_waiter();
+
+  int Submit(hsa_signal_t Signal, group* pGroup);
+  //! Number of waiter threads
+  size_t Threads() const { return lanes.size(); }
+
+ protected:
+/**
+ * @class entry
+ * @ingroup RVS
+ *
+ * @brief Copy signal and group waiting for it
+ *
+ */
+  struct entry {
+    //! copy completion signal, completed when value drops below 1
+    hsa_signal_t signal;
+    //! group to notify
+    group* pgroup;
+  };
+
+/**
+ * @class lane
+ * @ingroup RVS
+ *
+ * @brief Single waiter thread and its submission queue
+ *
+ */
+  struct lane {
+    //! waiter thread
+    std::thread thread;
+    //! protects incoming and stop
+    std::mutex mtx;
+    //! signals submitted since the last wake up
+    std::vector<entry> incoming;
+    //! set to non-zero to wake waiter up
+    hsa_signal_t wake;
+    //! 'true' to terminate waiter
+    bool stop;
+  };
+
+  void Run(lane* pLane);
+
+ protected:
+  //! waiter threads
+  std::vector<std::unique_ptr<lane>> lanes;
+  //! lane receiving the next submission
+  size_t next;
+  //! protects next
+  std::mutex next_mutex;
+};
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSHSAWAITER_H_
@@ -0,0 +1,79 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSLATENCYREPORT_H_
+#define INCLUDE_RVSLATENCYREPORT_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "include/rvshistogram.h"
+
+namespace rvs {
+
+/**
+ * @class latency_report
+ * @ingroup RVS
+ *
+ * @brief Logs copy latency percentiles of transfers
+ *
+ * Shared by transfer modules. Each transfer is logged per block size and
+ * in total, and latencies of all transfers are accumulated for a final
+ * summary line.
+ *
+ */
+class latency_report {
+ public:
+  latency_report(const std::string& Module, const std::string& Action,
+                 const std::string& Tag, bool Json);
+
+  void print(const latency_recorder& Rec, const std::string& Pair,
+             const std::string& Src, const std::string& Dst);
+  void print_all();
+  void log(const std::string& Pair, const std::string& Src,
+           const std::string& Dst, const std::string& Size,
+           const latency_histogram& Hist, int Level);
+
+  //! Latencies of all transfers printed so far
+  const latency_histogram& all() const { return total; }
+
+ protected:
+  //! module name used in JSON records
+  std::string module;
+  //! action name
+  std::string action;
+  //! tag starting each log line, e.g. "p2p-latency"
+  std::string tag;
+  //! 'true' if JSON records are to be created
+  bool json;
+  //! number of transfers printed
+  uint32_t transfers;
+  //! latencies of all transfers
+  latency_histogram total;
+};
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSLATENCYREPORT_H_
@@ -46,6 +46,8 @@ typedef void  (*t_cbAddNode)(void* Parent, void* Child);
 typedef void  (*t_cbStop)(uint16_t flags);
 typedef bool  (*t_cbStopping)(void);
 typedef int   (*t_rvs_module_err)(const char*, const char*, const char*);
+typedef int   (*t_cbLogLevel)(void);
+typedef bool  (*t_cbGetTicks)(unsigned int* psecs, unsigned int* pusecs);
 
 
 /**
@@ -76,6 +78,23 @@ typedef struct tag_module_init {
   t_rvs_module_err     cbErr;
 } T_MODULE_INIT;
 
+/**
+ * @brief Extended module initialization structure
+ *
+ * Passed through optional rvs_module_init_ext() entry point so that layout
+ * of T_MODULE_INIT stays unchanged for modules built against older headers.
+ * New members are only ever appended; module uses those fully covered by
+ * 'size' and leaves the rest at nullptr.
+ */
+typedef struct tag_module_init_ext {
+  //! size of this structure as known to launcher
+  uint32_t             size;
+  //! pointer to rvs::logger::log_level() function
+  t_cbLogLevel         cbLogLevel;
+  //! pointer to rvs::logger::get_ticks() function
+  t_cbGetTicks         cbGetTicks;
+} T_MODULE_INIT_EXT;
+
 #ifdef __cplusplus
 }
 #endif
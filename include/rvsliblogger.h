@@ -25,9 +25,17 @@
 #ifndef INCLUDE_RVSLIBLOGGER_H_
 #define INCLUDE_RVSLIBLOGGER_H_
 
+#include <sys/types.h>
+
 #include <string>
 #include <mutex>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
 #include "include/rvsliblog.h"
+#include "include/rvslogqueue.h"
+#include "include/rvslogbinary.h"
 
 
 namespace rvs {
@@ -43,13 +51,20 @@ namespace rvs {
 class logger {
  public:
   static  void  log_level(const int level);
+  static  int   log_level();
 
   static  void  to_json(const bool flag);
   static  bool  to_json();
 
+  static  void  to_binary(const bool flag);
+  static  bool  to_binary();
+
   static  void  append(const bool flag);
   static  bool  append();
 
+  static  void  async(const bool flag);
+  static  bool  async();
+
   //! set quiet mode
   static  void  quiet() { b_quiet = true; }
   //! set logging file
@@ -72,7 +87,6 @@ class logger {
   static  void   AddString(void* Parent, const char* Key, const char* Val);
   static  void   AddInt(void* Parent, const char* Key, const int Val);
   static  void   AddNode(void* Parent, void* Child);
-  static  int    JsonPatchAppend(int*);
   static  void   Stop(uint16_t flags);
   static  bool   Stopping(void);
   static  int    Err(const char *Message,
@@ -80,13 +94,33 @@ class logger {
 
  protected:
   static  int    ToFile(const std::string& Row);
+  static  int    RowToFile(const std::string& Row, const bool bJson);
+  static  void   LogClockAnchor();
+  static  int    StartAsync();
+  static  void   StopAsync();
+  static  int    Enqueue(std::string* pRow, const int Target,
+                         const int LogLevel);
+  static  void   AsyncWriter();
+  static  int    OpenFile(const bool bTruncate);
+  static  int    JsonSeekTail();
+  static  int    FlushFile();
+  static  void   FlushTimer();
+  static  void   CloseFile();
+  static  void   RegisterAtExit();
+  static  void   AtExit();
 
   //! Current logging level (0..5)
   static  int    loglevel_m;
   //! 'true' if JSON output is requested
   static  bool   tojson_m;
+  //! 'true' if binary log file is requested
+  static  bool   tobinary_m;
+  //! binary log encoder
+  static  LogBinaryWriter binlog;
   //! 'true' if append to existing log file is requested
   static  bool   append_m;
+  //! 'true' if asynchronous logging is requested
+  static  bool   async_m;
   //! 'true' if the incoming record is the first record in this rvs invocation
   static  bool   isfirstrecord_m;
   //! Array of C std::strings representing logging level names
@@ -103,6 +137,34 @@ class logger {
   static char log_file[1024];
   //! quiet mode
   static bool b_quiet;
+  //! log file descriptor, kept open until terminate()
+  static int log_fd;
+  //! offset of closing bracket in JSON log file, -1 if not JSON
+  static off_t json_tail;
+  //! closing bracket of JSON log file
+  static const char json_term[];
+  //! rows waiting to be written into log file
+  static std::string log_buffer;
+  //! time of the last write of log_buffer into log file
+  static std::chrono::steady_clock::time_point last_flush;
+  //! log_buffer size which triggers write into log file
+  static const size_t log_buffer_max;
+  //! max time (ms) rows may wait in log_buffer before being written
+  static const int log_flush_ms;
+  //! 'true' while a timer is pending to write out log_buffer
+  static bool flush_armed;
+  //! rows pushed by module threads in asynchronous mode
+  static LogQueue log_queue;
+  //! thread draining log_queue in asynchronous mode
+  static std::thread async_thread;
+  //! 'true' while async_thread is accepting rows
+  static std::atomic<bool> async_run;
+  //! 'true' while async_thread waits for new rows
+  static std::atomic<bool> async_idle;
+  //! Mutex used to wake up async_thread
+  static std::mutex async_mutex;
+  //! Condition used to wake up async_thread
+  static std::condition_variable async_cv;
 };
 
 }  // namespace rvs
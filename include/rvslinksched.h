@@ -0,0 +1,93 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSLINKSCHED_H_
+#define INCLUDE_RVSLINKSCHED_H_
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace rvs {
+
+/**
+ * @class LinkScheduler
+ * @ingroup RVS
+ *
+ * @brief Splits set of transfers into rounds of non-conflicting transfers
+ *
+ * Every transfer is described by the set of links it occupies. Two
+ * transfers conflict if they share a link. The conflict graph is coloured
+ * (DSatur heuristic) and each colour forms one round of transfers which
+ * can run concurrently without sharing bandwidth.
+ *
+ * HSA reports only type and distance of hops, not their identity, so
+ * links are derived from path as follows:
+ * - single hop of point-to-point type (see SetPointToPoint(), e.g. xGMI):
+ *   the link between the two agents,
+ * - any other path: the port of the source agent and the port of the
+ *   destination agent, named after the first and the last hop type.
+ *
+ * Links are full duplex: each direction is a separate link, bidirectional
+ * transfers occupy both.
+ *
+ */
+class LinkScheduler {
+ public:
+  //! Set name of hop type which connects two agents directly
+  void SetPointToPoint(const std::string& HopType) { p2p_hop = HopType; }
+
+  size_t Add(uint32_t Src, uint32_t Dst,
+             const std::vector<std::string>& Hops, bool Bidirectional);
+  size_t Add(const std::vector<std::string>& Links);
+
+  //! Number of transfers added
+  size_t Size() const { return transfers.size(); }
+  //! Links occupied by transfer
+  const std::vector<std::string>& Links(size_t Ix) const {
+    return transfers[Ix];
+  }
+
+  std::vector<std::vector<size_t>> Schedule() const;
+  size_t LowerBound() const;
+
+  static std::vector<std::string> PathLinks(uint32_t Src, uint32_t Dst,
+                                     const std::vector<std::string>& Hops,
+                                     const std::string& P2PHop,
+                                     bool Bidirectional);
+
+ protected:
+  bool Conflict(size_t A, size_t B) const;
+
+ protected:
+  //! links of each transfer, sorted
+  std::vector<std::vector<std::string>> transfers;
+  //! hop type which connects two agents directly, empty if none
+  std::string p2p_hop;
+};
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSLINKSCHED_H_
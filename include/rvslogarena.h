@@ -0,0 +1,154 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSLOGARENA_H_
+#define INCLUDE_RVSLOGARENA_H_
+
+#include <stddef.h>
+
+#include <new>
+#include <string>
+#include <vector>
+
+namespace rvs {
+
+/**
+ * @class LogArena
+ * @ingroup Launcher
+ *
+ * @brief Bump allocator holding all nodes of one log record
+ *
+ * Nodes of a log record are carved out of a few large chunks instead of
+ * being allocated one by one. All memory is reclaimed at once when the
+ * record is flushed. Arenas are recycled through a small per-thread pool
+ * so that steady-state logging does not touch the heap for node storage.
+ *
+ */
+class LogArena {
+ public:
+  LogArena();
+  ~LogArena();
+
+  void* allocate(const size_t Size, const size_t Align);
+  void  reset();
+
+  static LogArena* Acquire();
+  static void      Release(LogArena* pArena);
+
+ protected:
+  //! Memory chunk
+  struct Chunk {
+    //! chunk memory
+    char*  Data;
+    //! chunk size in bytes
+    size_t Size;
+  };
+
+  void add_chunk(const size_t MinSize);
+
+ protected:
+  //! chunks allocated so far; the first one survives reset()
+  std::vector<Chunk> chunks;
+  //! current allocation position in the last chunk
+  char*  cursor;
+  //! end of the last chunk
+  char*  limit;
+};
+
+/**
+ * @class ArenaAllocator
+ * @ingroup Launcher
+ *
+ * @brief Standard allocator drawing memory from LogArena
+ *
+ * Lets strings and child lists of arena allocated nodes live in the same
+ * arena as the node itself. Memory is never given back individually, it
+ * is reclaimed together with the arena. With no arena given it behaves as
+ * std::allocator.
+ *
+ */
+template <typename T>
+class ArenaAllocator {
+ public:
+  typedef T         value_type;
+  typedef T*        pointer;
+  typedef const T*  const_pointer;
+  typedef T&        reference;
+  typedef const T&  const_reference;
+  typedef size_t    size_type;
+  typedef ptrdiff_t difference_type;
+
+  //! Rebind allocator to another type
+  template <typename U>
+  struct rebind {
+    //! allocator for type U
+    typedef ArenaAllocator<U> other;
+  };
+
+  //! Constructor
+  explicit ArenaAllocator(LogArena* pArena = nullptr) : arena(pArena) {}
+  //! Converting constructor
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& Other) : arena(Other.arena) {}
+
+  //! Allocate storage for Count objects
+  T* allocate(const size_t Count) {
+    if (arena == nullptr)
+      return static_cast<T*>(::operator new(Count * sizeof(T)));
+    return static_cast<T*>(arena->allocate(Count * sizeof(T), alignof(T)));
+  }
+
+  //! Release storage (no-op for arena memory)
+  void deallocate(T* p, const size_t) {
+    if (arena == nullptr)
+      ::operator delete(p);
+  }
+
+  //! Arena to allocate from (nullptr - heap)
+  LogArena* arena;
+};
+
+//! Allocators are interchangeable if they use the same arena
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena == b.arena;
+}
+
+//! Allocators are interchangeable if they use the same arena
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) {
+  return a.arena != b.arena;
+}
+
+//! String allocated from arena
+typedef std::basic_string<char, std::char_traits<char>,
+                          ArenaAllocator<char> > ArenaString;
+
+//! Vector allocated from arena
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T> >;
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSLOGARENA_H_
@@ -0,0 +1,150 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSLOGBINARY_H_
+#define INCLUDE_RVSLOGBINARY_H_
+
+#include <stdint.h>
+
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rvs {
+
+class LogNodeBase;
+class LogNodeRec;
+
+/**
+ * Binary log layout
+ *
+ * @verbatim
+ * file       := session*
+ * session    := "RVSBLOG" 0x00 version frame*
+ * frame      := 0x01 strdef | 0x02 record | 0x03  (string table reset)
+ * strdef     := len bytes           (ids are assigned 0, 1, 2... per table)
+ * record     := level dtime count node*
+ * node       := 0x01 key count node*    (list)
+ *             | 0x02 key len bytes      (string)
+ *             | 0x03 key zigzag         (integer)
+ *             | 0x04 key id             (string from string table)
+ * @endverbatim
+ *
+ * All integers are LEB128 varints. dtime is zigzag encoded difference,
+ * in microseconds, between this and the previous record timestamp.
+ * Keys are string table ids. Writer empties string table once it holds
+ * LOGBIN_TABLE_MAX strings and marks that with reset frame, so memory used
+ * by both writer and reader stays bounded in long sessions.
+ */
+
+//! Binary log format version
+const uint8_t LOGBIN_VERSION = 2;
+//! Default max number of strings in string table before it is reset
+const size_t LOGBIN_TABLE_MAX = 4096;
+
+/**
+ * @class LogBinaryWriter
+ * @ingroup Launcher
+ *
+ * @brief Encodes log records into compact binary form
+ *
+ * Nodes call BeginRecord(), List(), String() and Int() in depth-first
+ * order from their Encode() method. Derived classes may override these
+ * to walk record structure for other purposes.
+ *
+ */
+class LogBinaryWriter {
+ public:
+  explicit LogBinaryWriter(const size_t TableMax = LOGBIN_TABLE_MAX);
+  virtual ~LogBinaryWriter();
+
+  void Header(std::string* pOut);
+  void Record(const LogNodeRec* pRec, std::string* pOut);
+
+  virtual void BeginRecord(const int Level, const unsigned Sec,
+                           const unsigned uSec, const size_t Count);
+  virtual void List(const char* Key, const size_t Count);
+  virtual void String(const char* Key, const char* Val);
+  virtual void Int(const char* Key, const int Val);
+
+  static void Varint(std::string* pOut, uint64_t Val);
+  static uint64_t ZigZag(const int64_t Val);
+
+ protected:
+  uint32_t Intern(const char* Val, const size_t Len);
+
+ protected:
+  //! string table of the current session
+  std::unordered_map<std::string, uint32_t> table;
+  //! string table lookup key
+  std::string lookup;
+  //! string definitions introduced by current record
+  std::string defs;
+  //! current record
+  std::string body;
+  //! timestamp of the previous record (us)
+  int64_t last_time;
+  //! string table size which triggers reset
+  size_t table_max;
+};
+
+/**
+ * @class LogBinaryReader
+ * @ingroup Launcher
+ *
+ * @brief Decodes binary log back into log records
+ *
+ */
+class LogBinaryReader {
+ public:
+  explicit LogBinaryReader(std::istream* pIn);
+
+  LogNodeRec* Next();
+  //! 'true' if malformed input was encountered
+  bool Error() const { return berror; }
+
+ protected:
+  bool ReadHeader();
+  bool ReadVarint(uint64_t* pVal);
+  bool ReadBytes(const size_t Len, std::string* pVal);
+  bool ReadKey(std::string* pKey);
+  LogNodeBase* ReadNode(const LogNodeBase* pParent, const int Depth);
+
+ protected:
+  //! input stream
+  std::istream* in;
+  //! string table of the current session
+  std::vector<std::string> table;
+  //! timestamp of the previous record (us)
+  int64_t last_time;
+  //! 'true' if session header was read
+  bool bsession;
+  //! 'true' on malformed input
+  bool berror;
+};
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSLOGBINARY_H_
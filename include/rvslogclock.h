@@ -0,0 +1,76 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSLOGCLOCK_H_
+#define INCLUDE_RVSLOGCLOCK_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+
+namespace rvs {
+
+/**
+ * @class LogClock
+ * @ingroup Launcher
+ *
+ * @brief Cheap monotonic time source for log timestamps
+ *
+ * On CPUs with invariant TSC, time is read from the time stamp counter and
+ * converted to CLOCK_MONOTONIC nanoseconds. Each thread caches a pair of
+ * (TSC, CLOCK_MONOTONIC) readings and re-reads the system clock only every
+ * few hundred milliseconds, so a timestamp normally costs a single RDTSC.
+ * Conversion rate is refined on every re-read against a process wide
+ * reference taken at start-up, so that timestamps coming from different
+ * threads stay ordered to well below a microsecond.
+ *
+ * Until enough time has passed for the rate to be accurate, or if TSC is
+ * not usable, CLOCK_MONOTONIC is read directly.
+ *
+ */
+class LogClock {
+ public:
+  static uint64_t now();
+  static void     split(const uint64_t Ns, uint32_t* pSec, uint32_t* pUsec);
+  static void     anchor(uint64_t* pMono, std::string* pWall);
+  static const char* source();
+
+ protected:
+  static uint64_t monotonic();
+  static uint64_t tsc();
+  static bool     calibrate();
+
+ protected:
+  //! 'true' if TSC is invariant and may be used
+  static bool tsc_ok;
+  //! ns per TSC tick as 32.32 fixed point, 0 until calibrated
+  static std::atomic<uint64_t> scale;
+  //! TSC ticks after which thread cache is re-read from system clock
+  static std::atomic<uint64_t> refresh;
+};
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSLOGCLOCK_H_
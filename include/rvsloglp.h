@@ -29,21 +29,27 @@
 
 #include "include/rvsliblog.h"
 
-#define RVSDEBUG_(ATTR, VAL) \
-{std::string msg = std::string(__FILE__)+"   "+__func__+":" \
-+std::to_string(__LINE__) + "\n" + std::string(ATTR) + ": " + \
-std::string(VAL); \
-rvs::lp::Log(msg, rvs::logdebug); \
+/**
+ * Trace macros check logging level before any formatting takes place.
+ * Location of each call site is kept in a function-local static so that
+ * nothing is built unless the message is actually output.
+ */
+#define RVSLOGSITE_(LEVEL, ...) \
+{ \
+  if (rvs::lp::LogOn(LEVEL)) { \
+    static const rvs::lp::log_site rvs_log_site_ = \
+      {__FILE__, __func__, __LINE__}; \
+    rvs::lp::LogSite(rvs_log_site_, LEVEL, ##__VA_ARGS__); \
+  } \
 }
 
+#define RVSDEBUG_(ATTR, VAL) \
+  RVSLOGSITE_(rvs::logdebug, "\n", ATTR, ": ", VAL)
+
 #ifdef RVS_DO_TRACE
-  #define RVSTRACE_ rvs::lp::Log(std::string(__FILE__)+"   "+__func__+":"\
-  +std::to_string(__LINE__), rvs::logtrace);
-  #define RVSDEBUG(x, y) rvs::lp::Log(std::string(__FILE__)+"   "\
-  +__func__+":" + std::to_string(__LINE__)\
-  + "   attr: " + std::string(x) \
-  + "  val: " + std::string(y) \
-  , rvs::logdebug);
+  #define RVSTRACE_ RVSLOGSITE_(rvs::logtrace)
+  #define RVSDEBUG(x, y) \
+    RVSLOGSITE_(rvs::logdebug, "   attr: ", x, "  val: ", y)
 #else
   #define RVSTRACE_
   #define RVSDEBUG(x, y)
@@ -62,11 +68,35 @@ namespace rvs {
  */
 class lp {
  public:
+  //! Static description of trace macro call site
+  struct log_site {
+    //! source file
+    const char* file;
+    //! function name
+    const char* func;
+    //! line number
+    int line;
+  };
+
+  /**
+   * @brief Check if message at given level would be output
+   *
+   * @param level Logging level
+   * @return 'true' if message is to be formatted and logged
+   */
+  static inline bool LogOn(const int level) {
+    return level <= (mi_ext.cbLogLevel ? (*mi_ext.cbLogLevel)() : logtrace);
+  }
+  static int   LogSite(const log_site& Site, const int level);
+  static int   LogSite(const log_site& Site, const int level,
+                       const std::string& s1, const std::string& s2,
+                       const std::string& s3, const std::string& s4);
   static int   Log(const char* pMsg, const int level);
   static int   Log(const std::string& Msg, const int level);
   static int   Log(const std::string& Msg, const int LogLevel,
                    const unsigned int Sec, const unsigned int uSec);
   static int   Initialize(const T_MODULE_INIT* pMi);
+  static int   InitializeExt(const T_MODULE_INIT_EXT* pMiExt);
   static void* LogRecordCreate(const char* Module, const char* Action,
                                const int LogLevel, const unsigned int Sec,
                                const unsigned int uSec);
@@ -87,6 +117,8 @@ class lp {
  protected:
   //! Module init structure passed through Initialize() method
   static T_MODULE_INIT mi;
+  //! Extended init structure passed through InitializeExt() method
+  static T_MODULE_INIT_EXT mi_ext;
 };
 
 }  // namespace rvs
@@ -27,11 +27,15 @@
 
 #include <string>
 
+#include "include/rvslogarena.h"
+
 #define RVSENDL "\n"
 #define RVSINDENT "  "
 
 namespace rvs {
 
+class LogBinaryWriter;
+
 typedef enum eLN {
   Unknown = 0,
   List    = 1,
@@ -51,29 +55,58 @@ class LogNodeBase {
  public:
   virtual ~LogNodeBase();
 
+  virtual std::string ToJson(const std::string& Lead = "");
+
+/**
+ * @brief Appends JSON representation of Node to the output buffer
+ *
+ * Converts node into proper string representation and appends it to
+ * pJson without building intermediate strings.
+ * This method has to be implemented in every derived class.
+ *
+ * @param pJson output buffer
+ * @param Lead String representing base indentation
+ * @param Depth nesting level; RVSINDENT is added to Lead for each level
+ *
+ */
+  virtual void Serialize(std::string* pJson, const std::string& Lead,
+                         const int Depth) const = 0;
+
 /**
- * @brief Provides JSON representation of Node
+ * @brief Encodes Node into binary log format
  *
- * Converts node into proper string representation.
  * This method has to be implemented in every derived class.
  *
- * @param Lead String of blanks " " representing current indentation
- * @return Node as JSON string
+ * @param pWriter binary log encoder
  *
  */
-  virtual std::string ToJson(const std::string& Lead = "") = 0;
+  virtual void Encode(LogBinaryWriter* pWriter) const = 0;
+
+ public:
+  //! Arena from which node was allocated (nullptr if allocated by new)
+  LogArena* GetArena() const { return Arena; }
+  static void Destroy(LogNodeBase* pNode);
+
+ protected:
+  static void JsonIndent(std::string* pJson, const std::string& Lead,
+                         const int Depth);
+  static void JsonString(std::string* pJson, const ArenaString& Val);
+  static void JsonInt(std::string* pJson, const int Val);
 
  protected:
   explicit LogNodeBase(const char* rName,
-                       const LogNodeBase* pParent = nullptr);
+                       const LogNodeBase* pParent = nullptr,
+                       LogArena* pArena = nullptr);
 
  protected:
   //! Node name
-  std::string     Name;
+  ArenaString     Name;
   //! Parent node
   const LogNodeBase*   Parent;
   //! Node type
   T_LNTYPE       Type;
+  //! Arena holding node memory
+  LogArena*      Arena;
 };
 
 
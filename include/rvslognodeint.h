@@ -42,11 +42,14 @@ namespace rvs {
 class LogNodeInt : public LogNodeBase {
  public:
   explicit LogNodeInt(const char* Name, const int Val,
-                      const LogNodeBase* pParent = nullptr);
+                      const LogNodeBase* pParent = nullptr,
+                      LogArena* pArena = nullptr);
 
   virtual ~LogNodeInt();
 
-  virtual std::string ToJson(const std::string& Lead = "");
+  virtual void Serialize(std::string* pJson, const std::string& Lead,
+                         const int Depth) const;
+  virtual void Encode(LogBinaryWriter* pWriter) const;
 
  protected:
   //! Node value
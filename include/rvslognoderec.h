@@ -43,10 +43,13 @@ namespace rvs {
 class LogNodeRec : public LogNode {
  public:
   LogNodeRec(const char* Name, int LogLevel, unsigned Sec,
-             unsigned uSec, const LogNodeBase* Parent = nullptr);
+             unsigned uSec, const LogNodeBase* Parent = nullptr,
+             LogArena* pArena = nullptr);
   virtual ~LogNodeRec();
 
-  virtual std::string ToJson(const std::string& Lead = "");
+  virtual void Serialize(std::string* pJson, const std::string& Lead,
+                         const int Depth) const;
+  virtual void Encode(LogBinaryWriter* pWriter) const;
 
  public:
   int LogLevel();
@@ -41,15 +41,18 @@ namespace rvs {
 class LogNodeString : public LogNodeBase {
  public:
   explicit LogNodeString(const char* Name, const char* Val,
-                         const LogNodeBase* Parent = nullptr);
+                         const LogNodeBase* Parent = nullptr,
+                         LogArena* pArena = nullptr);
 
   virtual ~LogNodeString();
 
-  virtual std::string ToJson(const std::string& Lead = "");
+  virtual void Serialize(std::string* pJson, const std::string& Lead,
+                         const int Depth) const;
+  virtual void Encode(LogBinaryWriter* pWriter) const;
 
  protected:
   //! Node value
-  std::string Value;
+  ArenaString Value;
 };
 
 }  // namespace rvs
@@ -0,0 +1,112 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSLOGQUEUE_H_
+#define INCLUDE_RVSLOGQUEUE_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace rvs {
+
+/**
+ * @class LogQueue
+ * @ingroup Launcher
+ *
+ * @brief Bounded lock-free multi-producer single-consumer queue of log rows
+ *
+ * Used by logger in asynchronous mode. Any number of threads may push()
+ * while exactly one writer thread calls pop(). Each slot carries sequence
+ * number so producers only contend on the tail index.
+ *
+ */
+class LogQueue {
+ public:
+  //! Row destination flags
+  enum eTarget {
+    //! row is printed to cout
+    toCout = 1,
+    //! row is plain text appended to log file
+    toFile = 2,
+    //! row is JSON record appended to log file
+    toJson = 4
+  };
+
+  //! Single queue entry
+  struct Entry {
+    //! formatted row
+    std::string Row;
+    //! combination of eTarget flags
+    int Target;
+  };
+
+  explicit LogQueue(const size_t Capacity = 8192);
+  ~LogQueue();
+
+  bool push(Entry* pEntry, const bool bWait);
+  bool pop(Entry* pEntry);
+  bool empty() const;
+
+  //! number of rows accepted into the queue
+  uint64_t pushed() const { return cnt_pushed.load(); }
+  //! number of rows dropped because queue was full
+  uint64_t dropped() const { return cnt_dropped.load(); }
+  //! number of times a producer found the queue full
+  uint64_t full() const { return cnt_full.load(); }
+  void reset_counters();
+
+ protected:
+  //! Ring slot
+  struct Cell {
+    //! slot sequence number
+    std::atomic<size_t> Seq;
+    //! slot payload
+    Entry Data;
+  };
+
+  bool try_push(Entry* pEntry);
+
+ protected:
+  //! ring buffer
+  std::unique_ptr<Cell[]> buffer;
+  //! capacity - 1 (capacity is power of 2)
+  size_t mask;
+  //! next slot to be filled by producers
+  alignas(64) std::atomic<size_t> tail;
+  //! next slot to be drained by the consumer
+  alignas(64) std::atomic<size_t> head;
+  //! rows accepted
+  alignas(64) std::atomic<uint64_t> cnt_pushed;
+  //! rows dropped
+  std::atomic<uint64_t> cnt_dropped;
+  //! full queue encounters
+  std::atomic<uint64_t> cnt_full;
+};
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSLOGQUEUE_H_
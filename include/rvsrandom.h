@@ -0,0 +1,68 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSRANDOM_H_
+#define INCLUDE_RVSRANDOM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace rvs {
+
+/**
+ * @class philox4x32
+ * @ingroup RVS
+ *
+ * @brief Philox4x32-10 counter-based pseudo random generator
+ *
+ * Every 64-bit counter value maps to four independent 32-bit random words,
+ * so any part of a random sequence can be generated directly without
+ * generating what precedes it. Sequences are selected by seed and stream.
+ *
+ */
+class philox4x32 {
+ public:
+  philox4x32(uint64_t Seed, uint32_t Stream);
+
+  void generate(uint64_t Counter, uint32_t Out[4]) const;
+
+ protected:
+  //! low half of the key
+  uint32_t k0;
+  //! high half of the key
+  uint32_t k1;
+  //! stream number
+  uint32_t stream;
+};
+
+void random_fill(float* pData, size_t Count, float Scale,
+                 uint64_t Seed, uint32_t Stream, size_t Threads = 0);
+void random_fill(double* pData, size_t Count, double Scale,
+                 uint64_t Seed, uint32_t Stream, size_t Threads = 0);
+void random_fill_half(uint16_t* pData, size_t Count,
+                      uint64_t Seed, uint32_t Stream, size_t Threads = 0);
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSRANDOM_H_
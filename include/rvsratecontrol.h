@@ -0,0 +1,157 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSRATECONTROL_H_
+#define INCLUDE_RVSRATECONTROL_H_
+
+#include <stdint.h>
+
+#include <string>
+
+namespace rvs {
+
+/**
+ * @class rate_profile
+ * @ingroup RVS
+ *
+ * @brief Time-varying rate setpoint
+ *
+ * All shapes move between Low and High. Constant stays at High, step climbs
+ * from Low to High in equal steps each held for one period, square holds
+ * High and Low for half a period each and sine follows a cosine starting
+ * at High.
+ *
+ */
+class rate_profile {
+ public:
+  //! profile shape
+  enum shape {
+    constant,
+    step,
+    sine,
+    square
+  };
+
+  rate_profile();
+  rate_profile(shape Shape, double High, double Low, uint64_t PeriodNs,
+               uint32_t Steps);
+
+  double value(uint64_t Ns) const;
+
+  static bool parse_shape(const std::string& Name, shape* pShape);
+
+ protected:
+  //! profile shape
+  shape shp;
+  //! highest rate
+  double high;
+  //! lowest rate
+  double low;
+  //! period (ns)
+  uint64_t period;
+  //! number of steps of step profile
+  uint32_t steps;
+};
+
+/**
+ * @class rate_controller
+ * @ingroup RVS
+ *
+ * @brief Schedules operations to hold a requested rate
+ *
+ * Operations are admitted through a token bucket refilled at the setpoint
+ * rate, scaled by a correction factor computed by a PI(D) loop from the
+ * measured rate. The bucket alone holds the rate as long as the device
+ * keeps up; the loop removes the remaining bias (host overhead, queuing).
+ * Integration stops while the correction is saturated or the device,
+ * not the bucket, limits the rate, so that the loop recovers quickly once
+ * an unreachable setpoint drops.
+ *
+ * All times are passed in by the caller, so the controller can be driven
+ * by a simulated device.
+ *
+ */
+class rate_controller {
+ public:
+  /**
+   * @brief Controller parameters
+   */
+  struct params {
+    params();
+    //! proportional gain (per relative error)
+    double kp;
+    //! integral gain (per relative error and second)
+    double ki;
+    //! derivative gain (seconds)
+    double kd;
+    //! correction factor is kept within [1 - max_correction,
+    //! 1 + max_correction]
+    double max_correction;
+    //! bucket capacity in operations
+    double burst;
+  };
+
+  rate_controller(double OpAmount, const params& Params);
+
+  void reset(uint64_t NowNs);
+  uint64_t next_delay(uint64_t NowNs, double Setpoint);
+  void consume(void);
+  void update(uint64_t NowNs, double Setpoint, double Measured);
+
+  //! returns rate at which operations are currently admitted
+  double rate(void) const { return cur_rate; }
+  //! returns current correction factor
+  double correction(void) const { return corr; }
+
+ protected:
+  void refill(uint64_t NowNs, double Setpoint);
+
+ protected:
+  //! controller parameters
+  params prm;
+  //! amount (e.g. GFLOP) of one operation
+  double op;
+  //! tokens in the bucket (same unit as op)
+  double tokens;
+  //! time of last refill (ns)
+  uint64_t last_refill;
+  //! rate at which bucket was last refilled
+  double cur_rate;
+  //! correction factor applied to setpoint
+  double corr;
+  //! integral of relative error (seconds)
+  double integral;
+  //! relative error at last update
+  double last_err;
+  //! time of last update (ns)
+  uint64_t last_update;
+  //! TRUE once update() was called after reset()
+  bool updated;
+  //! TRUE if an operation had to wait for tokens since last update()
+  bool throttled;
+};
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSRATECONTROL_H_
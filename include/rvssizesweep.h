@@ -0,0 +1,142 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSSIZESWEEP_H_
+#define INCLUDE_RVSSIZESWEEP_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <vector>
+
+namespace rvs {
+
+/**
+ * @class size_sweep
+ * @ingroup RVS
+ *
+ * @brief Finds block size at which transfer bandwidth reaches its plateau
+ *
+ * Instead of measuring every size of a fixed list, block size is doubled
+ * from the smallest one until bandwidth stops growing, which gives the
+ * plateau bandwidth without transferring the largest blocks. The smallest
+ * size reaching a given fraction of plateau is then found by bisection in
+ * logarithmic scale between the last two doublings. Each probed size is
+ * measured repeatedly until the confidence interval of its mean bandwidth
+ * is tight enough.
+ *
+ * A knee found earlier can be confirmed at the cost of measuring the knee
+ * and the size below it, avoiding a new search while link performance does
+ * not change.
+ *
+ * Measurement is done through a callback so the search can be run against
+ * a synthetic bandwidth model.
+ *
+ */
+class size_sweep {
+ public:
+  /**
+   * @brief Search parameters
+   */
+  struct params {
+    params();
+    //! smallest block size (bytes)
+    uint64_t min_size;
+    //! largest block size (bytes)
+    uint64_t max_size;
+    //! probed sizes are multiples of this (bytes)
+    uint64_t align;
+    //! fraction of plateau bandwidth defining the knee (0-1)
+    double plateau;
+    //! stop doubling once bandwidth grows by less than this fraction
+    double flatness;
+    //! target half-width of 95% confidence interval relative to mean
+    double tolerance;
+    //! stop bisecting once upper/lower bound ratio is below 1 + resolution
+    double resolution;
+    //! minimum number of measurements per size
+    uint32_t min_samples;
+    //! maximum number of measurements per size
+    uint32_t max_samples;
+  };
+
+  /**
+   * @brief Measured size
+   */
+  struct point {
+    //! block size (bytes)
+    uint64_t size;
+    //! mean bandwidth
+    double bandwidth;
+    //! half-width of 95% confidence interval of mean bandwidth
+    double ci;
+    //! number of measurements
+    uint32_t samples;
+  };
+
+  /**
+   * @brief Search result
+   */
+  struct result {
+    //! smallest size reaching required fraction of plateau (bytes)
+    uint64_t knee;
+    //! mean bandwidth at knee
+    double knee_bandwidth;
+    //! largest size known to be below required bandwidth, 0 if none
+    uint64_t below;
+    //! plateau bandwidth
+    double plateau_bandwidth;
+    //! all probed sizes in order of measurement
+    std::vector<point> points;
+  };
+
+  /**
+   * @brief Measurement callback
+   *
+   * Performs one transfer of Size bytes and stores its bandwidth (in any
+   * unit) in *pBandwidth. Returns 0 if successful.
+   */
+  typedef std::function<int(uint64_t Size, double* pBandwidth)> measure_t;
+
+  size_sweep(const params& Params, measure_t Measure);
+
+  int run(result* pResult);
+  int run(const result& Previous, result* pResult);
+  int probe(uint64_t Size, point* pPoint);
+
+  static double t95(uint32_t Dof);
+
+ protected:
+  uint64_t align(uint64_t Size) const;
+
+ protected:
+  //! search parameters
+  params prm;
+  //! measurement callback
+  measure_t measure;
+};
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSSIZESWEEP_H_
@@ -0,0 +1,148 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSSTOPWATCH_H_
+#define INCLUDE_RVSSTOPWATCH_H_
+
+#include <stdint.h>
+
+#include <chrono>
+
+namespace rvs {
+
+//! nanoseconds in one microsecond
+const uint64_t NS_PER_US = 1000;
+//! nanoseconds in one millisecond
+const uint64_t NS_PER_MS = 1000 * NS_PER_US;
+//! nanoseconds in one second
+const uint64_t NS_PER_SEC = 1000 * NS_PER_MS;
+
+/**
+ * @class stopwatch
+ * @ingroup RVS
+ *
+ * @brief Measures time elapsed since start on a monotonic clock
+ *
+ * Unlike system clock, steady clock is not affected by NTP adjustments so
+ * it should be used for all throughput and duration measurements.
+ *
+ */
+class stopwatch {
+ public:
+  //! clock used for all measurements
+  typedef std::chrono::steady_clock clock_t;
+
+  //! Constructor, starts measurement
+  stopwatch() { start(); }
+
+  //! (Re)start measurement
+  void start() { start_time = clock_t::now(); }
+
+  uint64_t elapsed_ns() const;
+  uint64_t elapsed_ms() const;
+  double elapsed_sec() const;
+  uint64_t lap_ns();
+
+  //! Check if at least Ms milliseconds have elapsed since start
+  bool expired(uint64_t Ms) const { return elapsed_ns() >= Ms * NS_PER_MS; }
+
+  static uint64_t now_ns();
+
+ protected:
+  //! time measurement started at
+  clock_t::time_point start_time;
+};
+
+/**
+ * @class interval_accumulator
+ * @ingroup RVS
+ *
+ * @brief Accumulates measured intervals
+ *
+ * Keeps number of intervals, their sum and extremes. Not thread safe;
+ * use one instance per thread.
+ *
+ */
+class interval_accumulator {
+ public:
+  interval_accumulator() { reset(); }
+
+  void reset();
+  void add(uint64_t Ns);
+
+  //! Number of intervals accumulated
+  uint64_t count() const { return num; }
+  //! Sum of all intervals (ns)
+  uint64_t total_ns() const { return total; }
+  //! Sum of all intervals (s)
+  double total_sec() const {
+    return static_cast<double>(total) / NS_PER_SEC;
+  }
+  //! Shortest interval (ns), 0 if none
+  uint64_t min_ns() const { return num ? shortest : 0; }
+  //! Longest interval (ns)
+  uint64_t max_ns() const { return longest; }
+  //! Average interval (ns), 0 if none
+  double mean_ns() const {
+    return num ? static_cast<double>(total) / num : 0;
+  }
+
+ protected:
+  //! number of intervals
+  uint64_t num;
+  //! sum of intervals (ns)
+  uint64_t total;
+  //! shortest interval (ns)
+  uint64_t shortest;
+  //! longest interval (ns)
+  uint64_t longest;
+};
+
+/**
+ * @class scoped_stopwatch
+ * @ingroup RVS
+ *
+ * @brief Adds time spent in a scope to an interval_accumulator
+ *
+ */
+class scoped_stopwatch {
+ public:
+  //! Constructor, starts measurement
+  explicit scoped_stopwatch(interval_accumulator* pAcc) : acc(pAcc) {}
+  //! Destructor, adds elapsed time to accumulator
+  ~scoped_stopwatch() { acc->add(watch.elapsed_ns()); }
+
+  scoped_stopwatch(const scoped_stopwatch&) = delete;
+  scoped_stopwatch& operator=(const scoped_stopwatch&) = delete;
+
+ protected:
+  //! accumulator receiving the measurement
+  interval_accumulator* acc;
+  //! measures time spent in scope
+  stopwatch watch;
+};
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSSTOPWATCH_H_
@@ -25,12 +25,86 @@
 #ifndef INCLUDE_RVSTIMER_H_
 #define INCLUDE_RVSTIMER_H_
 
+#include <atomic>
 #include <chrono>
-
-#include "include/rvsthreadbase.h"
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
 
 namespace rvs {
 
+/**
+ * @class timer_service
+ * @ingroup RVS
+ *
+ * @brief Single thread serving all timers
+ *
+ * Pending timers are kept sorted by expiration time on a steady clock.
+ * Service thread sleeps on a condition variable until the earliest
+ * timer expires or the set of timers changes. Callbacks are called from
+ * the service thread. Thread is started when the first timer is added and
+ * exits when there are no more timers.
+ *
+ */
+class timer_service {
+ public:
+  //! clock used for all timers
+  typedef std::chrono::steady_clock clock_t;
+  //! timer callback
+  typedef std::function<void()> callback_t;
+
+  static timer_service* get();
+
+  uint64_t add(clock_t::duration Interval, bool RunOnce,
+               const callback_t& Callback);
+  void cancel(uint64_t Id);
+
+  virtual ~timer_service();
+
+ protected:
+  timer_service();
+  void run();
+
+/**
+ * @class entry
+ * @ingroup RVS
+ *
+ * @brief Single registered timer
+ *
+ */
+  struct entry {
+    //! timer interval
+    clock_t::duration interval;
+    //! true if timer is to fire only once
+    bool once;
+    //! function called on expiration
+    callback_t callback;
+    //! position in the expiration queue
+    std::multimap<clock_t::time_point, uint64_t>::iterator pos;
+  };
+
+  //! registered timers keyed by ID
+  std::map<uint64_t, entry> entries;
+  //! timer IDs sorted by expiration time
+  std::multimap<clock_t::time_point, uint64_t> queue;
+  //! ID to be assigned to the next timer
+  uint64_t next_id;
+  //! ID of timer which callback is in progress, 0 if none
+  uint64_t running_id;
+  //! true while service thread is active
+  bool brunning;
+  //! synchronizes access to members
+  std::mutex mtx;
+  //! wakes service thread when timers are added or removed
+  std::condition_variable cv;
+  //! signaled when callback completes
+  std::condition_variable done_cv;
+  //! service thread
+  std::thread t;
+};
+
 /**
  * @class timer
  * @ingroup RVS
@@ -41,12 +115,12 @@ namespace rvs {
  * It accepts parameter T which is a class which member function will
  * be called upon expiration of timer interval.
  *
- * Timer resolution is 1ms
+ * Timers do not own threads; all of them are served by timer_service.
  *
  */
 
 template<class T>
-class timer : public ThreadBase {
+class timer {
  public:
   //! helper typedef to simplify member declaration of callback function
   typedef void (T::*timerfunc_t)();
@@ -61,6 +135,10 @@ class timer : public ThreadBase {
   timer(timerfunc_t cbFunc, T* cbArg) {
     cbfunc = cbFunc;
     cbarg = cbArg;
+    brun = false;
+    brunonce = false;
+    timeset = 0;
+    id = 0;
   }
 
   //! Default destructor
@@ -71,79 +149,53 @@ class timer : public ThreadBase {
   /**
   * @brief Start timer
   *
+  * Restarts the timer if already running.
+  *
   * @param Interval Timer interval in ms
   * @param RunOnce 'true' if timer is to fire only once
   *
   * */
   void start(int Interval, bool RunOnce = false) {
+    timer_service* service = timer_service::get();
+    service->cancel(id);
     brunonce = RunOnce;
     timeset = Interval;
-    end_time = std::chrono::system_clock::now() +
-               std::chrono::milliseconds(timeset);
-    // recalculate the end time and only if thread is not started start it
-    if (brun == false) {
-      brun = true;
-      rvs::ThreadBase::start();
-    }
+    brun = true;
+    id = service->add(std::chrono::milliseconds(timeset), brunonce,
+                      [this]() { expired(); });
   }
 
 
 /**
  * @brief Stop timer
  *
- * Sets brun member to FALSE thus signaling end of processing.
- * Then it waits for std::thread to exit before returning.
+ * Removes the timer from timer service. If callback is in progress,
+ * waits for it to complete before returning.
  *
  * */
   void stop() {
-    // signal thread to exit
     brun = false;
-
-    // wait a bit to make sure thread has exited
-    std::this_thread::yield();
-
-    try {
-      if (t.joinable())
-        t.join();
-    } catch(...) {
+    if (id) {
+      timer_service::get()->cancel(id);
+      id = 0;
     }
   }
 
-
+ protected:
 /**
- * @brief Timer internal thread function (called from ThreadBase)
+ * @brief Called by timer service when interval expires
  *
  * */
-  virtual void run() {
-    do {
-      std::chrono::time_point<std::chrono::system_clock> curr_time;
-      // wait for time to ellsapse (or for timer to be stopped)
-      while (brun) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        curr_time = std::chrono::system_clock::now();
-        if (std::chrono::duration_cast<std::chrono::milliseconds>
-                                         (curr_time - end_time).count() >= 0) {
-          break;
-        }
-      }
-
-      // if timer is not stopped, call the callback function
-      if (brun) {
-        (cbarg->*cbfunc)();
-      }
-
-      if (brunonce) {
-        brun = false;
-      } else {
-        end_time = std::chrono::system_clock::now() +
-                   std::chrono::milliseconds(timeset);
-      }
-    } while (brun);
+  void expired() {
+    if (brunonce) {
+      brun = false;
+    }
+    (cbarg->*cbfunc)();
   }
 
  protected:
   //! true for the duration of timer activity
-  bool        brun;
+  std::atomic<bool> brun;
   //! true if timer is to fire only once
   bool        brunonce;
   //! timer interval (ms)
@@ -152,8 +204,8 @@ class timer : public ThreadBase {
   timerfunc_t cbfunc;
   //! ptr to instance of a class to be called-back through cbfunc.
   T*          cbarg;
-  //! time when timer will expire
-  std::chrono::time_point<std::chrono::system_clock> end_time;
+  //! ID of this timer in timer service, 0 if not started
+  uint64_t    id;
 };
 
 }  // namespace rvs
@@ -0,0 +1,114 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSTRANSFERSTATS_H_
+#define INCLUDE_RVSTRANSFERSTATS_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <mutex>
+
+namespace rvs {
+
+/**
+ * @class transfer_sink
+ * @ingroup RVS
+ *
+ * @brief Receives individual transfer samples from rvs::transfer_stats
+ *
+ * record() is called on the writer thread only, right after the sample has
+ * been accounted, so implementations must not block.
+ *
+ */
+class transfer_sink {
+ public:
+  virtual ~transfer_sink() {}
+  //! Record one transfer of Size bytes which took Duration seconds
+  virtual void record(uint64_t Size, double Duration) = 0;
+};
+
+/**
+ * @class transfer_stats
+ * @ingroup RVS
+ *
+ * @brief Single-writer transfer counters with lock-free snapshots
+ *
+ * Counters are only ever incremented, by one thread at a time (the thread
+ * running transfers of a worker). Readers take consistent snapshots through
+ * a sequence lock and compute running and final figures as differences
+ * from snapshots taken earlier, so the writer never waits for a reader and
+ * never has to reset anything. Readers serialize among themselves.
+ *
+ */
+class transfer_stats {
+ public:
+  /**
+   * @brief Counter values
+   */
+  struct data {
+    //! bytes transferred
+    uint64_t size;
+    //! time spent transferring (sec)
+    double duration;
+  };
+
+  transfer_stats();
+
+  void reset();
+  void add(uint64_t Size, double Duration);
+  //! Set sample sink called for each add(), nullptr to disable
+  void set_sink(transfer_sink* pSink) { sink = pSink; }
+
+  void load(data* pData) const;
+  void take_running(data* pRunning);
+  void take_final(data* pTotal, bool bReset);
+
+ protected:
+  void publish(const data& Data);
+
+ protected:
+  //! sequence number, odd while writer is updating counters
+  std::atomic<uint32_t> seq;
+  //! bytes transferred
+  std::atomic<uint64_t> size;
+  //! time spent transferring (bit pattern of double)
+  std::atomic<uint64_t> duration;
+
+  //! writer's own copy of counters
+  data wr;
+  //! optional sample sink
+  transfer_sink* sink;
+
+  //! serializes readers
+  std::mutex rdmutex;
+  //! counters at the end of previous running interval
+  data running_base;
+  //! counters at the last final totals reset
+  data final_base;
+};
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSTRANSFERSTATS_H_
@@ -0,0 +1,123 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef INCLUDE_RVSWORKPOOL_H_
+#define INCLUDE_RVSWORKPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rvs {
+
+/**
+ * @class WorkPool
+ * @ingroup RVS
+ *
+ * @brief Persistent work-stealing thread pool
+ *
+ * Worker threads are spread over NUMA nodes and pinned to CPUs of their
+ * node. Every thread has its own task queue. Tasks are queued on a thread
+ * of the requested node and idle threads steal work, first from threads
+ * on their own node and then from other nodes. Threads stay alive until
+ * the pool is destroyed so the same pool serves any number of runs.
+ *
+ */
+class WorkPool {
+ public:
+  //! task executed by the pool
+  typedef std::function<void()> task_t;
+
+  explicit WorkPool(size_t Threads = 0);
+  virtual ~WorkPool();
+
+  void Submit(const task_t& Task, int Node = -1);
+  void Hold();
+  void Release();
+  void Wait();
+
+  //! Number of pool threads
+  size_t Threads() const { return lanes.size(); }
+  //! Number of NUMA nodes pool threads are spread over
+  size_t Nodes() const { return node_lanes.size(); }
+
+  static std::vector<int> ParseCpuList(const std::string& List);
+
+ protected:
+/**
+ * @class lane
+ * @ingroup RVS
+ *
+ * @brief Single pool thread and its task queue
+ *
+ */
+  struct lane {
+    //! pool thread
+    std::thread thread;
+    //! index into node_lanes
+    size_t node;
+    //! protects tasks
+    std::mutex mtx;
+    //! tasks queued on this thread
+    std::deque<task_t> tasks;
+  };
+
+  void Run(size_t Ix);
+  bool Pop(size_t Ix, task_t* pTask);
+  bool Steal(size_t Ix, task_t* pTask);
+
+ protected:
+  //! pool threads
+  std::vector<std::unique_ptr<lane>> lanes;
+  //! NUMA node number for each entry in node_lanes
+  std::vector<int> node_ids;
+  //! lanes of each NUMA node
+  std::vector<std::vector<size_t>> node_lanes;
+  //! next lane of each node to receive a task
+  std::vector<size_t> node_next;
+  //! next lane to receive a task with no node preference
+  size_t next_any;
+
+  //! protects counters below and pool wide sleeping
+  std::mutex mtx;
+  //! signaled when new task is queued or pool is stopping
+  std::condition_variable cv_work;
+  //! signaled when all work has completed
+  std::condition_variable cv_idle;
+  //! number of queued tasks
+  size_t queued;
+  //! number of queued and running tasks plus holds
+  size_t pending;
+  //! 'true' when pool threads are to exit
+  bool stop;
+};
+
+}  // namespace rvs
+
+#endif  // INCLUDE_RVSWORKPOOL_H_
@@ -0,0 +1,501 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/worker.h"
+
+#ifdef __cplusplus
+extern "C" {
+  #endif
+  #include <pci/pci.h>
+  #include <linux/pci.h>
+  #ifdef __cplusplus
+}
+#endif
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+
+#include "include/rvs_module.h"
+#include "include/pci_caps.h"
+#include "include/gpu_util.h"
+#include "include/rvsloglp.h"
+#include "include/rvshsa.h"
+#include "include/rvsworkpool.h"
+#include "include/rvs_key_def.h"
+#include "include/rvssizesweep.h"
+
+#define MODULE_NAME "PEBB"
+
+using std::string;
+using std::vector;
+using std::map;
+
+extern uint64_t test_duration;
+ 
+pebbworker::pebbworker() {
+  // set to 'true' so that do_transfer() will also work
+  // when parallel: false
+  brun = true;
+  loglevel = rvs::logerror;
+  pipeline_depth = 0;
+  pipeline_copies = DEFAULT_PIPELINE_COPIES;
+  pPool = nullptr;
+  numa_node = -1;
+  badaptive = false;
+  bsweep_done = false;
+}
+pebbworker::~pebbworker() {}
+
+/**
+ * @brief Thread function
+ *
+ * Loops while brun == TRUE and performs polled monitoring avery 1msec.
+ *
+ * */
+void pebbworker::run() {
+  std::string msg;
+
+  msg = "[" + action_name + "] pebb thread " + std::to_string(src_node) + " "
+  + std::to_string(dst_node) + " has started";
+  rvs::lp::Log(msg, rvs::logdebug);
+
+  brun = true;
+
+  rvs::stopwatch run_timer;
+  do{
+    do_transfer();
+
+    if (run_timer.expired(test_duration)) {
+        break;
+    }
+  } while (brun);
+
+  msg = "[" + action_name + "] pebb thread " + std::to_string(src_node) + " "
+  + std::to_string(dst_node) + " has finished";
+  rvs::lp::Log(msg, rvs::logdebug);
+}
+
+/**
+ * @brief Start transfers in a worker pool
+ *
+ * Instead of running in its own thread, the worker queues one transfer
+ * pass at a time in the pool until the test duration expires or the
+ * worker is stopped. Use rvs::WorkPool::Wait() to wait for completion.
+ *
+ * @param pPool pool to run transfer passes in
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int pebbworker::schedule(rvs::WorkPool* pPool) {
+  std::string msg;
+
+  msg = "[" + action_name + "] pebb task " + std::to_string(src_node) + " "
+  + std::to_string(dst_node) + " has started";
+  rvs::lp::Log(msg, rvs::logdebug);
+
+  this->pPool = pPool;
+  brun = true;
+  pass_timer.start();
+  pPool->Submit([this]{ pass(); }, numa_node);
+
+  return 0;
+}
+
+/**
+ * @brief Check if next transfer pass is to be run
+ *
+ * @return 'true' if worker has not been stopped and test duration has not
+ * expired yet
+ *
+ * */
+bool pebbworker::pass_continue() {
+  if (!brun) {
+    return false;
+  }
+  return !pass_timer.expired(test_duration);
+}
+
+/**
+ * @brief Pool task performing one transfer pass
+ *
+ * Queues the next pass if needed.
+ *
+ * */
+void pebbworker::pass() {
+  do_transfer();
+
+  if (pass_continue()) {
+    pPool->Submit([this]{ pass(); }, numa_node);
+    return;
+  }
+
+  std::string msg = "[" + action_name + "] pebb task "
+  + std::to_string(src_node) + " " + std::to_string(dst_node)
+  + " has finished";
+  rvs::lp::Log(msg, rvs::logdebug);
+}
+
+/**
+ * @brief Stop processing
+ *
+ * Sets brun member to FALSE thus signaling end of processing.
+ * Then it waits for std::thread to exit before returning.
+ *
+ * */
+void pebbworker::stop() {
+  std::string msg;
+
+  msg = "[" + stop_action_name + "] pebb transfer " + std::to_string(src_node)
+      + " "       + std::to_string(dst_node) + " in pebbworker::stop()";
+  rvs::lp::Log(msg, rvs::logtrace);
+
+  brun = false;
+}
+
+/**
+ * @brief Init worker object and set transfer parameters
+ *
+ * @param Src source NUMA node
+ * @param Dst destination NUMA node
+ * @param h2d 'true' for host to device transfer
+ * @param d2h 'true' for device to host transfer
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int pebbworker::initialize(uint16_t Src, uint16_t Dst, bool h2d, bool d2h) {
+  src_node = Src;
+  dst_node = Dst;
+  bidirect = d2h && h2d;
+
+  prop_d2h = d2h;
+  prop_h2d = h2d;
+
+  pHsa = rvs::hsa::Get();
+
+  stats.reset();
+  latency.init(pHsa->size_list);
+  stats.set_sink(&latency);
+
+  return 0;
+}
+
+/**
+ * @brief Set list of block sizes to transfer
+ *
+ * @param val list of block sizes (bytes), default list if empty
+ *
+ * */
+void pebbworker::set_block_sizes(const std::vector<uint32_t>& val) {
+  block_size = val;
+  const std::vector<uint32_t>& sizes =
+    block_size.empty() ? pHsa->size_list : block_size;
+  if (!badaptive || sizes.empty()) {
+    latency.init(sizes);
+    return;
+  }
+
+  // sizes probed by adaptive sweep are not known up front so latencies are
+  // kept per power-of-two size class between the smallest and the largest
+  // block size
+  uint32_t lo = *std::min_element(sizes.begin(), sizes.end());
+  uint32_t hi = *std::max_element(sizes.begin(), sizes.end());
+  std::vector<uint32_t> classes;
+  for (uint64_t s = lo; s < hi; s *= 2) {
+    classes.push_back(static_cast<uint32_t>(s));
+  }
+  classes.push_back(hi);
+  latency.init(classes);
+}
+
+/**
+ * @brief Set number of copies in flight
+ *
+ * Pipelined copies are timed individually by rvs::hsa so transfer totals
+ * are not fed into latency histograms in that case.
+ *
+ * @param val number of copies in flight, 0 for one copy at a time
+ *
+ * */
+void pebbworker::set_pipeline_depth(const uint32_t val) {
+  pipeline_depth = val;
+  stats.set_sink(pipeline_depth > 0 ? nullptr : &latency);
+}
+
+/**
+ * @brief Executes data transfer
+ *
+ * Based on transfer parameters, initiates and performs one way or
+ * bidirectional data transfer. Resulting measurements are compounded in running
+ * totals for periodical printout during the test.
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int pebbworker::do_transfer() {
+  int sts;
+  unsigned int startsec;
+  unsigned int startusec;
+  unsigned int endsec;
+  unsigned int endusec;
+
+  RVSTRACE_
+
+  brun = true;
+  if (loglevel >= rvs::logdebug)
+    rvs::lp::get_ticks(&startsec, &startusec);
+
+  if (block_size.size() == 0) {
+    RVSTRACE_
+    block_size = pHsa->size_list;
+  }
+
+  // if needed, swap source and destination
+  uint16_t from_node = src_node;
+  uint16_t to_node = dst_node;
+  if (!prop_h2d && prop_d2h) {
+    RVSTRACE_
+    std::swap(from_node, to_node);
+  }
+
+  // allocate buffers for the whole sweep up front so that only copying
+  // takes place in the loop below; if that fails, buffers are allocated
+  // per size as needed
+  pHsa->ReserveTraffic(from_node, to_node,
+                       *std::max_element(block_size.begin(), block_size.end()),
+                       bidirect);
+
+  if (badaptive) {
+    RVSTRACE_
+    sts = do_sweep(from_node, to_node);
+    if (sts) {
+      return sts;
+    }
+  }
+
+  for (size_t i = 0; !badaptive && brun && i < block_size.size(); i++) {
+    RVSTRACE_
+    size_t bytes;
+    double duration;
+
+    if (rvs::lp::Stopping()) {
+      RVSTRACE_
+      return -1;
+    }
+    sts = transfer_block(from_node, to_node, block_size[i],
+                         &bytes, &duration);
+    if (sts) {
+      return sts;
+    }
+  }
+
+  RVSTRACE_
+  if (loglevel >= rvs::logdebug) {
+    RVSTRACE_
+    std::string msg;
+    msg = "[" + action_name + "] pebb transfer " + std::to_string(src_node)
+        + " " + std::to_string(dst_node) + " ";
+
+    rvs::lp::get_ticks(&endsec, &endusec);
+    rvs::lp::Log(msg + "start", rvs::logdebug, startsec, startusec);
+    rvs::lp::Log(msg + "finish", rvs::logdebug, endsec, endusec);
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Transfer one block size and account it in running totals
+ *
+ * @param From source NUMA node
+ * @param To destination NUMA node
+ * @param Size block size (bytes)
+ * @param pBytes [out] bytes transferred
+ * @param pDuration [out] transfer duration (sec)
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int pebbworker::transfer_block(uint16_t From, uint16_t To, size_t Size,
+                               size_t* pBytes, double* pDuration) {
+  int sts;
+
+  RVSTRACE_
+  current_size = Size;
+  if (pipeline_depth > 0) {
+    RVSTRACE_
+    rvs::hsa::TrafficStats traffic;
+    sts = pHsa->SendTrafficPipelined(From, To, Size,
+                                     bidirect, pipeline_depth,
+                                     pipeline_copies, &traffic,
+                                     latency.find(Size));
+    // duration spans timed copies only so only those are accounted;
+    // bytes are per direction as for SendTraffic()
+    *pDuration = traffic.duration;
+    *pBytes = Size * traffic.copies / (bidirect ? 2 : 1);
+  } else {
+    // pool threads may outnumber cores, so do not spin while copying
+    sts = pHsa->SendTraffic(From, To, Size, bidirect, pDuration,
+                            pPool ? HSA_WAIT_STATE_BLOCKED
+                                  : HSA_WAIT_STATE_ACTIVE);
+    *pBytes = Size;
+  }
+  if (sts) {
+    std::string msg = "internal error, src: " + std::to_string(src_node)
+    + "   dst: " +std::to_string(dst_node)
+    + "   current size: " + std::to_string(Size)
+    + " status "+ std::to_string(sts);
+    rvs::lp::Err(msg, MODULE_NAME, action_name);
+    return sts;
+  }
+
+  stats.add(*pBytes, *pDuration);
+  return 0;
+}
+
+/**
+ * @brief Enable adaptive block size sweep
+ *
+ * Instead of transferring every block size, each pass searches for the
+ * smallest block size reaching given fraction of plateau bandwidth. Block
+ * sizes are searched between the smallest and the largest configured one.
+ *
+ * @param Plateau fraction of plateau bandwidth defining the knee (0-1)
+ * @param Tolerance target relative half-width of 95% confidence interval
+ *
+ * */
+void pebbworker::set_adaptive_sweep(double Plateau, double Tolerance) {
+  badaptive = true;
+  sweep_prm.plateau = Plateau;
+  sweep_prm.tolerance = Tolerance;
+}
+
+/**
+ * @brief Search for the block size at which bandwidth reaches its plateau
+ *
+ * @param From source NUMA node
+ * @param To destination NUMA node
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int pebbworker::do_sweep(uint16_t From, uint16_t To) {
+  RVSTRACE_
+  rvs::size_sweep::params prm = sweep_prm;
+  prm.min_size = *std::min_element(block_size.begin(), block_size.end());
+  prm.max_size = *std::max_element(block_size.begin(), block_size.end());
+  prm.align = std::min<uint64_t>(prm.align, prm.min_size);
+
+  rvs::size_sweep sweep(prm, [this, From, To](uint64_t Size, double* pBw) {
+    size_t bytes;
+    double duration;
+
+    if (!brun || rvs::lp::Stopping()) {
+      return -1;
+    }
+    int sts = transfer_block(From, To, Size, &bytes, &duration);
+    if (sts) {
+      return sts;
+    }
+    *pBw = duration > 0 ? bytes / duration / 1000 / 1000 / 1000 : 0;
+    if (bidirect) {
+      *pBw *= 2;
+    }
+    return 0;
+  });
+
+  // passes after the first one only confirm the knee found before
+  rvs::size_sweep::result res;
+  int sts = bsweep_done ? sweep.run(sweep_res, &res) : sweep.run(&res);
+  if (sts == 0) {
+    // the last completed pass is reported;
+    // read only after the worker has stopped
+    sweep_res = res;
+    bsweep_done = true;
+  }
+  return sts;
+}
+
+/**
+ * @brief Get result of adaptive block size sweep
+ *
+ * @param pResult [out] sweep result
+ * @return 'true' if sweep has completed
+ *
+ * */
+bool pebbworker::get_sweep(rvs::size_sweep::result* pResult) {
+  if (!bsweep_done)
+    return false;
+  *pResult = sweep_res;
+  return true;
+}
+
+/**
+ * @brief Get running cumulatives for data trnasferred and time ellapsed
+ *
+ * @param Src [out] source NUMA node
+ * @param Dst [out] destination NUMA node
+ * @param Bidirect [out] 'true' for bidirectional transfer
+ * @param Size [out] cumulative size of transferred data in this sampling
+ * interval (in bytes)
+ * @param Duration [out] cumulative duration of transfers in this sampling
+ * interval (in seconds)
+ *
+ * */
+void pebbworker::get_running_data(uint16_t* Src,  uint16_t* Dst, bool* Bidirect,
+                                 size_t* Size, double* Duration) {
+  rvs::transfer_stats::data running;
+  stats.take_running(&running);
+
+  *Src = src_node;
+  *Dst = dst_node;
+  *Bidirect = bidirect;
+  *Size = running.size;
+  *Duration = running.duration;
+}
+
+/**
+ * @brief Get final cumulatives for data trnasferred and time ellapsed
+ *
+ * @param Src [out] source NUMA node
+ * @param Dst [out] destination NUMA node
+ * @param Bidirect [out] 'true' for bidirectional transfer
+ * @param Size [out] cumulative size of transferred data in
+ * this test (in bytes)
+ * @param Duration [out] cumulative duration of transfers in
+ * this test (in seconds)
+ * @param bReset [in] if 'true' set final totals to zero
+ *
+ * */
+void pebbworker::get_final_data(uint16_t* Src, uint16_t* Dst, bool* Bidirect,
+                               size_t* Size, double* Duration, bool bReset) {
+  rvs::transfer_stats::data total;
+  stats.take_final(&total, bReset);
+
+  *Src = src_node;
+  *Dst = dst_node;
+  *Bidirect = bidirect;
+  *Size = total.size;
+  *Duration = total.duration;
+}
@@ -0,0 +1,57 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <string>
+#include <vector>
+
+#include "test/unitactionbase.h"
+#include "include/rvsloglp.h"
+
+#define MODULE_NAME_CAPS "UNITPESM"
+
+//! Default constructor
+unitactionbase::unitactionbase() {
+}
+
+//! Default destructor
+unitactionbase::~unitactionbase() {
+  property.clear();
+}
+
+
+int unitactionbase::run(void) {
+  RVSTRACE_
+  // agreed upon return value for this run() method
+  return 3;
+}
+
+void unitactionbase::test_get_device_all
+(std::vector<uint16_t>* pDev, bool* bAll) {
+  *pDev = property_device;
+  *bAll = property_device_all;
+}
+
+void unitactionbase::test_erase_property(const std::string& prop) {
+  property.erase(prop);
+}
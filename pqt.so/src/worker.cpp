@@ -0,0 +1,312 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/worker.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+#include <pci/pci.h>
+#include <linux/pci.h>
+#ifdef __cplusplus
+}
+#endif
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+
+#include "include/rvs_module.h"
+#include "include/pci_caps.h"
+#include "include/gpu_util.h"
+#include "include/rvsloglp.h"
+#include "include/rvshsa.h"
+#include "include/rvsworkpool.h"
+#define MODULE_NAME "PQT"
+
+
+pqtworker::pqtworker() {
+  // set to 'true' so that do_transfer() will also work
+  // when parallel: false
+  brun = true;
+  pPool = nullptr;
+  numa_node = -1;
+  pass_duration = 0;
+}
+pqtworker::~pqtworker() {}
+
+extern uint64_t test_duration;
+ 
+/**
+ * @brief Thread function
+ *
+ * Loops while brun == TRUE and performs polled monitoring avery 1msec.
+ *
+ * */
+void pqtworker::run() {
+  std::string msg;
+
+  msg = "[" + action_name + "] pqt thread " + std::to_string(src_node) + " "
+  + std::to_string(dst_node) + " has started";
+  rvs::lp::Log(msg, rvs::logdebug);
+
+  brun = true;
+
+  rvs::stopwatch run_timer;
+  do {
+      do_transfer();
+
+      if (run_timer.expired(test_duration)) {
+          break;
+      }
+   } while (brun);
+
+  msg = "[" + action_name + "] pqt thread " + std::to_string(src_node) + " "
+  + std::to_string(dst_node) + " has finished";
+  rvs::lp::Log(msg, rvs::logdebug);
+}
+
+/**
+ * @brief Start transfers in a worker pool
+ *
+ * Instead of running in its own thread, the worker queues one transfer
+ * pass at a time in the pool until the test duration expires or the
+ * worker is stopped. Use rvs::WorkPool::Wait() to wait for completion.
+ *
+ * @param pPool pool to run transfer passes in
+ * @param Duration run duration (ms), 0 - test duration
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int pqtworker::schedule(rvs::WorkPool* pPool, uint64_t Duration) {
+  std::string msg;
+
+  msg = "[" + action_name + "] pqt task " + std::to_string(src_node) + " "
+  + std::to_string(dst_node) + " has started";
+  rvs::lp::Log(msg, rvs::logdebug);
+
+  this->pPool = pPool;
+  brun = true;
+  pass_duration = Duration ? Duration : test_duration;
+  pass_timer.start();
+  pPool->Submit([this]{ pass(); }, numa_node);
+
+  return 0;
+}
+
+/**
+ * @brief Check if next transfer pass is to be run
+ *
+ * @return 'true' if worker has not been stopped and test duration has not
+ * expired yet
+ *
+ * */
+bool pqtworker::pass_continue() {
+  if (!brun) {
+    return false;
+  }
+  return !pass_timer.expired(pass_duration);
+}
+
+/**
+ * @brief Pool task performing one transfer pass
+ *
+ * Queues the next pass if needed.
+ *
+ * */
+void pqtworker::pass() {
+  do_transfer();
+
+  if (pass_continue()) {
+    pPool->Submit([this]{ pass(); }, numa_node);
+    return;
+  }
+
+  std::string msg = "[" + action_name + "] pqt task "
+  + std::to_string(src_node) + " " + std::to_string(dst_node)
+  + " has finished";
+  rvs::lp::Log(msg, rvs::logdebug);
+}
+
+/**
+ * @brief Stop processing
+ *
+ * Sets brun member to FALSE thus signaling end of processing.
+ * Then it waits for std::thread to exit before returning.
+ *
+ * */
+void pqtworker::stop() {
+  std::string msg;
+
+  msg = "[" + stop_action_name + "] pqt transfer " + std::to_string(src_node)
+      + " " + std::to_string(dst_node) + " in pqtworker::stop()";
+  rvs::lp::Log(msg, rvs::logtrace);
+
+  brun = false;
+}
+
+/**
+ * @brief Init worker object and set transfer parameters
+ *
+ * @param Src source NUMA node
+ * @param Dst destination NUMA node
+ * @param Bidirect 'true' for bidirectional transfer
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int pqtworker::initialize(uint16_t Src, uint16_t Dst, bool Bidirect) {
+  src_node = Src;
+  dst_node = Dst;
+  bidirect = Bidirect;
+  pHsa = rvs::hsa::Get();
+
+  stats.reset();
+  latency.init(pHsa->size_list);
+  stats.set_sink(&latency);
+
+  return 0;
+}
+
+/**
+ * @brief Set list of block sizes to transfer
+ *
+ * @param val list of block sizes (bytes), default list if empty
+ *
+ * */
+void pqtworker::set_block_sizes(const std::vector<uint32_t>& val) {
+  block_size = val;
+  latency.init(block_size.empty() ? pHsa->size_list : block_size);
+}
+
+/**
+ * @brief Executes data transfer
+ *
+ * Based on transfer parameters, initiates and performs one way or
+ * bidirectional data transfer. Resulting measurements are compounded in running
+ * totals for periodical printout during the test.
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int pqtworker::do_transfer() {
+  double duration;
+  int sts;
+  unsigned int startsec;
+  unsigned int startusec;
+  unsigned int endsec;
+  unsigned int endusec;
+  std::string msg;
+
+  msg = "[" + action_name + "] pqt transfer " + std::to_string(src_node) + " "
+      + std::to_string(dst_node) + " ";
+
+  rvs::lp::get_ticks(&startsec, &startusec);
+
+  if (block_size.size() == 0) {
+    block_size = pHsa->size_list;
+  }
+
+  // allocate buffers for the whole sweep up front so that only copying
+  // takes place in the loop below; if that fails, buffers are allocated
+  // per size as needed
+  pHsa->ReserveTraffic(src_node, dst_node,
+                       *std::max_element(block_size.begin(), block_size.end()),
+                       bidirect);
+
+  for (size_t i = 0; brun && i < block_size.size(); i++) {
+    current_size = block_size[i];
+    // pool threads may outnumber cores, so do not spin while copying
+    sts = pHsa->SendTraffic(src_node, dst_node, current_size,
+                            bidirect, &duration,
+                            pPool ? HSA_WAIT_STATE_BLOCKED
+                                  : HSA_WAIT_STATE_ACTIVE);
+
+    if (sts) {
+      msg = "internal error, src: " + std::to_string(src_node)
+                + "   dst: " + std::to_string(dst_node)
+                + "   current size: " + std::to_string(current_size);
+      rvs::lp::Err(msg, MODULE_NAME, action_name);
+      return sts;
+    }
+
+    stats.add(current_size, duration);
+  }
+
+  rvs::lp::get_ticks(&endsec, &endusec);
+  rvs::lp::Log(msg + "start", rvs::logdebug, startsec, startusec);
+  rvs::lp::Log(msg + "finish", rvs::logdebug, endsec, endusec);
+
+  return 0;
+}
+
+/**
+ * @brief Get running cumulatives for data trnasferred and time ellapsed
+ *
+ * @param Src [out] source NUMA node
+ * @param Dst [out] destination NUMA node
+ * @param Bidirect [out] 'true' for bidirectional transfer
+ * @param Size [out] cumulative size of transferred data in this sampling
+ * interval (in bytes)
+ * @param Duration [out] cumulative duration of transfers in this sampling
+ * interval (in seconds)
+ *
+ * */
+void pqtworker::get_running_data(uint16_t* Src,  uint16_t* Dst, bool* Bidirect,
+                             size_t* Size, double* Duration) {
+  rvs::transfer_stats::data running;
+  stats.take_running(&running);
+
+  *Src = src_node;
+  *Dst = dst_node;
+  *Bidirect = bidirect;
+  *Size = running.size;
+  *Duration = running.duration;
+}
+
+/**
+ * @brief Get final cumulatives for data trnasferred and time ellapsed
+ *
+ * @param Src [out] source NUMA node
+ * @param Dst [out] destination NUMA node
+ * @param Bidirect [out] 'true' for bidirectional transfer
+ * @param Size [out] cumulative size of transferred data in
+ * this test (in bytes)
+ * @param Duration [out] cumulative duration of transfers in
+ * this test (in seconds)
+ * @param bReset [in] if 'true' set final totals to zero
+ *
+ * */
+void pqtworker::get_final_data(uint16_t* Src,  uint16_t* Dst, bool* Bidirect,
+                           size_t* Size, double* Duration, bool bReset) {
+  rvs::transfer_stats::data total;
+  stats.take_final(&total, bReset);
+
+  *Src = src_node;
+  *Dst = dst_node;
+  *Bidirect = bidirect;
+  *Size = total.size;
+  *Duration = total.duration;
+}
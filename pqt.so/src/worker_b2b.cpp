@@ -0,0 +1,377 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/worker_b2b.h"
+
+#ifdef __cplusplus
+extern "C" {
+  #endif
+  #include <pci/pci.h>
+  #include <linux/pci.h>
+  #ifdef __cplusplus
+}
+#endif
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <cstdint>
+
+#include "include/rvs_module.h"
+#include "include/pci_caps.h"
+#include "include/gpu_util.h"
+#include "include/rvsloglp.h"
+#include "include/rvshsa.h"
+#include "include/rvsworkpool.h"
+
+using std::string;
+using std::vector;
+using std::map;
+
+pqtworker_b2b::pqtworker_b2b()
+: pqtworker(),
+  pass_group([this]{ pPool->Submit([this]{ complete(); }, numa_node); }) {
+  issue_sts = 0;
+}
+pqtworker_b2b::~pqtworker_b2b() {}
+
+extern uint64_t test_duration;
+ 
+/**
+ * @brief Init worker object and set transfer parameters
+ *
+ * @param Src source NUMA node
+ * @param Dst destination NUMA node
+ * @param Bidirect 'true' for bidirectional transfer
+ * @param Size size of block used for transfer
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int pqtworker_b2b::initialize(int Src, int Dst, bool Bidirect, size_t Size) {
+  pqtworker::initialize(Src, Dst, Bidirect);
+
+  b2b_block_size = Size;
+  latency.init(std::vector<uint32_t>(1, Size));
+
+  ctx_fwd.SrcAgentIx = pHsa->FindAgent(Src);
+  ctx_fwd.SrcAgent = pHsa->agent_list[ctx_fwd.SrcAgentIx].agent;
+
+  ctx_fwd.DstAgentIx = pHsa->FindAgent(Dst);
+  ctx_fwd.DstAgent = pHsa->agent_list[ctx_fwd.DstAgentIx].agent;
+
+  ctx_fwd.Sig.handle = 0;
+  ctx_fwd.pSrcBuff = nullptr;
+  ctx_fwd.pDstBuff = nullptr;
+
+  ctx_rev.SrcAgentIx = ctx_fwd.DstAgentIx;
+  ctx_rev.SrcAgent = ctx_fwd.DstAgent;
+
+  ctx_rev.DstAgentIx = ctx_fwd.SrcAgentIx;
+  ctx_rev.DstAgent = ctx_fwd.SrcAgent;
+  ctx_rev.Sig.handle = 0;
+
+  ctx_rev.pSrcBuff = nullptr;
+  ctx_rev.pDstBuff = nullptr;
+
+  return 0;
+}
+
+/**
+ * @brief Set list of block sizes
+ *
+ * Only back-to-back block size is transferred so latency histogram
+ * is kept for that size alone.
+ *
+ * @param val list of block sizes (bytes), not used for transfers
+ *
+ * */
+void pqtworker_b2b::set_block_sizes(const std::vector<uint32_t>& val) {
+  block_size = val;
+  latency.init(std::vector<uint32_t>(1, b2b_block_size));
+}
+
+/**
+ * @brief release all resources used in transfers
+ */
+void pqtworker_b2b::deinit() {
+  RVSTRACE_
+  // release fwd buffers if any
+  if (ctx_fwd.pSrcBuff) {
+    hsa_amd_memory_pool_free(ctx_fwd.pSrcBuff);
+    ctx_fwd.pSrcBuff = nullptr;
+  }
+
+  RVSTRACE_
+  if (ctx_fwd.pDstBuff) {
+    hsa_amd_memory_pool_free(ctx_fwd.pDstBuff);
+    ctx_fwd.pDstBuff = nullptr;
+  }
+
+  RVSTRACE_
+  if (ctx_fwd.Sig.handle) {
+    hsa_signal_destroy(ctx_fwd.Sig);
+    ctx_fwd.Sig.handle = 0;
+  }
+
+  RVSTRACE_
+  if (ctx_rev.pSrcBuff) {
+    hsa_amd_memory_pool_free(ctx_rev.pSrcBuff);
+    ctx_rev.pSrcBuff = nullptr;
+  }
+
+  RVSTRACE_
+  if (ctx_rev.pDstBuff) {
+    hsa_amd_memory_pool_free(ctx_rev.pDstBuff);
+    ctx_rev.pDstBuff = nullptr;
+  }
+
+  RVSTRACE_
+  if (ctx_rev.Sig.handle) {
+    hsa_signal_destroy(ctx_rev.Sig);
+    ctx_rev.Sig.handle = 0;
+  }
+  RVSTRACE_
+}
+
+/**
+ * @brief Allocate buffers and signals used in transfers
+ *
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int pqtworker_b2b::setup() {
+  hsa_status_t status;
+  int sts;
+
+  RVSTRACE_
+  // allocate buffers and grant permissions for forward transfer
+  sts = pHsa->Allocate(ctx_fwd.SrcAgentIx, ctx_fwd.DstAgentIx, b2b_block_size,
+          &ctx_fwd.SrcPool, &ctx_fwd.pSrcBuff,
+          &ctx_fwd.DstPool, &ctx_fwd.pDstBuff);
+  if (sts) {
+    RVSTRACE_
+    deinit();
+    return -1;
+  }
+
+  // Create a signal to wait on forward copy operation
+  if (HSA_STATUS_SUCCESS !=
+    (status = hsa_signal_create(1, 0, NULL, &ctx_fwd.Sig))) {
+    rvs::hsa::print_hsa_status(__FILE__, __LINE__, __func__,
+              "hsa_signal_create()", status);
+    RVSTRACE_
+    deinit();
+    return -1;
+  }
+
+  // allocate buffers and grant permissions for reverse transfer
+  if (bidirect) {
+    sts = pHsa->Allocate(ctx_rev.SrcAgentIx, ctx_rev.DstAgentIx, b2b_block_size,
+            &ctx_rev.SrcPool, &ctx_rev.pSrcBuff,
+            &ctx_rev.DstPool, &ctx_rev.pDstBuff);
+
+    if (sts) {
+      RVSTRACE_
+      deinit();
+      return -1;
+    }
+
+    // Create a signal to wait on reverse copy operation
+    if (HSA_STATUS_SUCCESS !=
+      (status = hsa_signal_create(1, 0, NULL, &ctx_rev.Sig))) {
+      rvs::hsa::print_hsa_status(__FILE__, __LINE__, __func__,
+                "hsa_signal_create()", status);
+      RVSTRACE_
+      deinit();
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Initiate one back-to-back pass
+ *
+ * Copies are handed to the shared waiter threads which release @p pGroup
+ * once all of them complete. Result is stored in issue_sts before the
+ * group is released.
+ *
+ * @param pGroup group notified when all the copies complete
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int pqtworker_b2b::issue(rvs::hsa_waiter::group* pGroup) {
+  rvs::hsa_waiter* pWaiter = pHsa->Waiter();
+  hsa_status_t status;
+  int sts = 0;
+
+  // keep group from completing until all copies are submitted
+  pGroup->hold();
+
+  // initiate forward transfer
+  RVSTRACE_
+  hsa_signal_store_relaxed(ctx_fwd.Sig, 1);
+  if (HSA_STATUS_SUCCESS !=
+    (status = hsa_amd_memory_async_copy(
+                ctx_fwd.pDstBuff, ctx_fwd.DstAgent,
+                ctx_fwd.pSrcBuff, ctx_fwd.SrcAgent,
+                b2b_block_size,
+                0, NULL, ctx_fwd.Sig))) {
+    rvs::hsa::print_hsa_status(__FILE__, __LINE__, __func__,
+              "hsa_amd_memory_async_copy()",
+              status);
+    sts = -1;
+  } else if (pWaiter->Submit(ctx_fwd.Sig, pGroup)) {
+    RVSTRACE_
+    // no waiter available, wait for this copy here
+    while (hsa_signal_wait_scacquire(ctx_fwd.Sig, HSA_SIGNAL_CONDITION_LT,
+           1, UINT64_MAX, HSA_WAIT_STATE_BLOCKED)) {}
+  }
+
+  if (sts == 0 && bidirect) {
+    RVSTRACE_
+    // initiate reverse transfer
+    hsa_signal_store_relaxed(ctx_rev.Sig, 1);
+    if (HSA_STATUS_SUCCESS != (status = hsa_amd_memory_async_copy(
+                  ctx_rev.pDstBuff, ctx_rev.DstAgent,
+                  ctx_rev.pSrcBuff, ctx_rev.SrcAgent,
+                  b2b_block_size,
+                  0, NULL, ctx_rev.Sig))) {
+      rvs::hsa::print_hsa_status(__FILE__, __LINE__, __func__,
+              "hsa_amd_memory_async_copy()",
+              status);
+      sts = -1;
+    } else if (pWaiter->Submit(ctx_rev.Sig, pGroup)) {
+      RVSTRACE_
+      while (hsa_signal_wait_scacquire(ctx_rev.Sig, HSA_SIGNAL_CONDITION_LT,
+             1, UINT64_MAX, HSA_WAIT_STATE_BLOCKED)) {}
+    }
+  }
+
+  issue_sts = sts;
+  pGroup->release();
+
+  return sts;
+}
+
+/**
+ * @brief Account completed pass in running totals
+ *
+ * @return 'true' if next pass is to be initiated
+ *
+ * */
+bool pqtworker_b2b::account() {
+  RVSTRACE_
+  // get transfer duration
+  double duration = pHsa->GetCopyTime(bidirect,
+                                ctx_fwd.Sig, ctx_rev.Sig)/1000000000;
+  stats.add(b2b_block_size, duration);
+
+  return pass_continue();
+}
+
+/**
+ * @brief Thread function
+ *
+ * Loops while brun == TRUE issuing back-to-back copies. The thread sleeps
+ * while copies are in flight; their completion is reported by the waiter
+ * threads of rvs::hsa_waiter.
+ *
+ * */
+void pqtworker_b2b::run() {
+  RVSTRACE_
+
+  // enable test
+  brun = true;
+
+  if (setup()) {
+    return;
+  }
+
+  pass_duration = test_duration;
+  pass_timer.start();
+  while (brun) {
+    // sleep until waiter threads report completion of all the copies
+    rvs::hsa_waiter::group done;
+    int sts = issue(&done);
+    done.wait();
+    if (sts || !account()) {
+      break;
+    }
+  }  // while(brun)
+
+  RVSTRACE_
+  // deallocate buffers and signals
+  deinit();
+}
+
+/**
+ * @brief Start back-to-back transfers in a worker pool
+ *
+ * No pool thread is blocked while copies are in flight. Once a pass
+ * completes, waiter thread queues complete() in the pool which accounts
+ * the pass and initiates the next one.
+ *
+ * @param pPool pool to run transfer passes in
+ * @param Duration run duration (ms), 0 - test duration
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int pqtworker_b2b::schedule(rvs::WorkPool* pPool, uint64_t Duration) {
+  RVSTRACE_
+  this->pPool = pPool;
+  brun = true;
+  pass_duration = Duration ? Duration : test_duration;
+
+  if (setup()) {
+    return -1;
+  }
+
+  // keep pool busy until the last pass completes
+  pPool->Hold();
+  pass_timer.start();
+  issue(&pass_group);
+
+  return 0;
+}
+
+/**
+ * @brief Pool task run after each pass completes
+ *
+ * */
+void pqtworker_b2b::complete() {
+  RVSTRACE_
+  if (issue_sts == 0 && account()) {
+    issue(&pass_group);
+    return;
+  }
+
+  RVSTRACE_
+  deinit();
+  pPool->Release();
+}
@@ -98,6 +98,8 @@ typedef std::pair<std::string, module*> t_mmpair;
 
   //! Pointer to module init function
   t_rvs_module_init           rvs_module_init;
+  //! Pointer to optional extended module init function
+  t_rvs_module_init_ext       rvs_module_init_ext;
   //! Pointer to module terminate function
   t_rvs_module_terminate      rvs_module_terminate;
   //! Pointer to module action create function
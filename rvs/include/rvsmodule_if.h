@@ -27,6 +27,7 @@
 
 extern "C" {
 extern  int   rvs_module_init(void*);
+extern  int   rvs_module_init_ext(void*);
 extern  int   rvs_module_terminate(void);
 extern  void* rvs_module_action_create(void);
 extern  int   rvs_module_action_destroy(void*);
@@ -34,6 +35,7 @@ extern  int   rvs_module_has_interface(int);
 
 // define function pointer types to ease late binding usage
 typedef int   (*t_rvs_module_init)(void*);
+typedef int   (*t_rvs_module_init_ext)(void*);
 typedef int   (*t_rvs_module_terminate)(void);
 typedef void* (*t_rvs_module_action_create)(void);
 typedef int   (*t_rvs_module_action_destroy)(void*);
@@ -0,0 +1,237 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+/**
+ * Converts binary log written by "rvs -j -l <file> --binLog" into the
+ * JSON produced by "rvs -j -l <file>", or into CSV with one row per
+ * log record and one column per distinct key path.
+ */
+
+#include <stdio.h>
+
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "include/rvslogbinary.h"
+#include "include/rvslognoderec.h"
+
+namespace {
+
+/**
+ * @class csv_row
+ *
+ * @brief Flattens log record into list of (key path, value) pairs
+ *
+ */
+class csv_row : public rvs::LogBinaryWriter {
+ public:
+  void BeginRecord(const int Level, const unsigned Sec, const unsigned uSec,
+                   const size_t Count) override {
+    char buff[64];
+    snprintf(buff, sizeof(buff), "%u.%06u", Sec, uSec);
+    fields.clear();
+    path.clear();
+    left.clear();
+    fields.push_back(std::make_pair("time", std::string(buff)));
+    fields.push_back(std::make_pair("loglevel", std::to_string(Level)));
+    path.push_back("");
+    left.push_back(Count);
+    pop_done();
+  }
+
+  void List(const std::string& Key, const size_t Count) override {
+    left.back()--;
+    path.push_back(path.back() + Key + ".");
+    left.push_back(Count);
+    pop_done();
+  }
+
+  void String(const std::string& Key, const std::string& Val) override {
+    left.back()--;
+    fields.push_back(std::make_pair(path.back() + Key, Val));
+    pop_done();
+  }
+
+  void Int(const std::string& Key, const int Val) override {
+    left.back()--;
+    fields.push_back(std::make_pair(path.back() + Key, std::to_string(Val)));
+    pop_done();
+  }
+
+  //! (key path, value) pairs of the current record
+  std::vector<std::pair<std::string, std::string>> fields;
+
+ protected:
+  //! close lists whose children have all been visited
+  void pop_done() {
+    while (!left.empty() && left.back() == 0) {
+      left.pop_back();
+      path.pop_back();
+    }
+  }
+
+  //! key path prefix for each open list
+  std::vector<std::string> path;
+  //! children still to be visited for each open list
+  std::vector<size_t> left;
+};
+
+//! Quote CSV field if needed
+std::string csv_field(const std::string& val) {
+  if (val.find_first_of(",\"\r\n") == std::string::npos)
+    return val;
+
+  std::string out("\"");
+  for (size_t i = 0; i < val.size(); i++) {
+    if (val[i] == '"')
+      out += '"';
+    out += val[i];
+  }
+  out += '"';
+  return out;
+}
+
+//! Output records as JSON array identical to "rvs -j" log file
+int to_json(std::istream* pIn, std::ostream* pOut) {
+  rvs::LogBinaryReader reader(pIn);
+  std::string json("[");
+  bool bfirst = true;
+
+  while (std::unique_ptr<rvs::LogNodeRec> rec{reader.Next()}) {
+    if (!bfirst)
+      json += ",";
+    bfirst = false;
+    rec->Serialize(&json, "  ", 0);
+    *pOut << json;
+    json.clear();
+  }
+  *pOut << json << RVSENDL << "]";
+
+  return reader.Error() ? 1 : 0;
+}
+
+//! Output records as CSV
+int to_csv(const char* pFile, std::ostream* pOut) {
+  std::vector<std::string> columns;
+  std::unordered_map<std::string, size_t> index;
+  csv_row row;
+
+  // first pass - collect columns in order of appearance
+  {
+    std::ifstream in(pFile, std::ios::binary);
+    rvs::LogBinaryReader reader(&in);
+    while (std::unique_ptr<rvs::LogNodeRec> rec{reader.Next()}) {
+      rec->Encode(&row);
+      for (auto& f : row.fields) {
+        if (index.insert(std::make_pair(f.first, columns.size())).second)
+          columns.push_back(f.first);
+      }
+    }
+    if (reader.Error())
+      return 1;
+  }
+
+  for (size_t i = 0; i < columns.size(); i++) {
+    *pOut << (i ? "," : "") << csv_field(columns[i]);
+  }
+  *pOut << "\n";
+
+  // second pass - output rows
+  std::ifstream in(pFile, std::ios::binary);
+  rvs::LogBinaryReader reader(&in);
+  std::vector<std::string> values(columns.size());
+  while (std::unique_ptr<rvs::LogNodeRec> rec{reader.Next()}) {
+    rec->Encode(&row);
+    for (auto& v : values)
+      v.clear();
+    for (auto& f : row.fields)
+      values[index[f.first]] = f.second;
+    for (size_t i = 0; i < values.size(); i++) {
+      *pOut << (i ? "," : "") << csv_field(values[i]);
+    }
+    *pOut << "\n";
+  }
+
+  return reader.Error() ? 1 : 0;
+}
+
+void usage() {
+  std::cerr << "Usage: rvsblog [--csv] <binary log> [output file]\n";
+  std::cerr << "\nConverts binary log produced with --binLog into JSON "
+               "(default) or CSV.\n";
+}
+
+}  // namespace
+
+/**
+ * @brief Main method
+ *
+ * @param Argc standard C argc parameter to main()
+ * @param Argv standard C argv parameter to main()
+ * @return 0 - all OK, non-zero error
+ *
+ */
+int main(int Argc, char** Argv) {
+  bool bcsv = false;
+  int arg = 1;
+
+  if (arg < Argc && std::string(Argv[arg]) == "--csv") {
+    bcsv = true;
+    arg++;
+  }
+  if (arg >= Argc || Argc - arg > 2) {
+    usage();
+    return 1;
+  }
+
+  const char* pinput = Argv[arg];
+  std::ifstream in(pinput, std::ios::binary);
+  if (!in.good()) {
+    std::cerr << "RVS-ERROR could not open " << pinput << "\n";
+    return 1;
+  }
+
+  std::ofstream fout;
+  std::ostream* pout = &std::cout;
+  if (arg + 1 < Argc) {
+    fout.open(Argv[arg + 1], std::ios::binary | std::ios::trunc);
+    if (!fout.good()) {
+      std::cerr << "RVS-ERROR could not create " << Argv[arg + 1] << "\n";
+      return 1;
+    }
+    pout = &fout;
+  }
+
+  int sts = bcsv ? to_csv(pinput, pout) : to_json(&in, pout);
+  if (sts) {
+    std::cerr << "RVS-ERROR malformed binary log " << pinput << "\n";
+  }
+
+  return sts;
+}
@@ -135,6 +135,12 @@ void rvs::cli::init_grammar() {
   grammar.insert(gpair("-a", sp));
   grammar.insert(gpair("--appendLog", sp));
 
+  sp = std::make_shared<optbase>("-async", command);
+  grammar.insert(gpair("--asyncLog", sp));
+
+  sp = std::make_shared<optbase>("-bin", command);
+  grammar.insert(gpair("--binLog", sp));
+
   sp = std::make_shared<optbase>("-c", command, value);
   grammar.insert(gpair("-c", sp));
   grammar.insert(gpair("--config", sp));
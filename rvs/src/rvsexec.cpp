@@ -113,6 +113,11 @@ int rvs::exec::run() {
     logger::append(true);
   }
 
+  // check --asyncLog option
+  if (rvs::options::has_option("-async", &val)) {
+    logger::async(true);
+  }
+
   // check -l option
   std::string s_log_file;
   if (rvs::options::has_option("-l", &s_log_file)) {
@@ -124,6 +129,16 @@ int rvs::exec::run() {
     logger::to_json(true);
   }
 
+  // check --binLog option
+  if (rvs::options::has_option("-bin", &val)) {
+    if (!logger::to_json() || s_log_file.empty()) {
+      rvs::logger::Err("--binLog requires -j and -l options",
+                       MODULE_NAME_CAPS);
+      return -1;
+    }
+    logger::to_binary(true);
+  }
+
   string config_file;
   if (rvs::options::has_option("-c", &val)) {
     config_file = val;
@@ -224,6 +239,16 @@ void rvs::exec::do_help() {
                               "overwrite the contents\n";
   cout << "                   of a current log. Used in conjuction with the"
                                "-d and -l options.\n";
+  cout << "   --asyncLog      Format log records on the calling thread "
+                              "and output them\n";
+  cout << "                   from a dedicated writer thread. Verbose "
+                              "records may be\n";
+  cout << "                   dropped if the writer falls behind.\n";
+  cout << "   --binLog        Write JSON log records into the log file "
+                              "in compact binary\n";
+  cout << "                   format. Used in conjunction with the -j "
+                              "and -l options.\n";
+  cout << "                   Use rvsblog to convert it to JSON or CSV.\n";
   cout << "-c --config        Specify the configuration file to be used.\n";
   cout << "                   The default is <install base>/conf/RVS.conf\n";
   cout << "   --configless    Run RVS in a configless mode. Executes a "
@@ -59,7 +59,8 @@ using std::string;
 rvs::module::module(const char* pModuleName, void* pSoLib)
 :
 psolib(pSoLib),
-name(pModuleName) {
+name(pModuleName),
+rvs_module_init_ext(nullptr) {
 }
 
 //! Destructor
@@ -224,7 +225,9 @@ rvs::module* rvs::module::find_create_module(const char* name) {
  * @brief Module instance initialization method
  *
  * Fills module initialization structure with pointers to
- * Logger API and passes it to module Initialize() API.
+ * Logger API and passes it to module Initialize() API. Callbacks added
+ * later are passed through extended structure to modules which export
+ * rvs_module_init_ext().
  *
  * @return 0 - success, non-zero otherwise
  *
@@ -244,6 +247,18 @@ int rvs::module::initialize() {
   d.cbStopping        = rvs::logger::Stopping;
   d.cbErr             = rvs::logger::Err;
 
+  if (rvs_module_init_ext) {
+    T_MODULE_INIT_EXT e;
+
+    e.size              = sizeof(e);
+    e.cbLogLevel        = rvs::logger::log_level;
+    e.cbGetTicks        = rvs::logger::get_ticks;
+
+    int sts = (*rvs_module_init_ext)(reinterpret_cast<void*>(&e));
+    if (sts)
+      return sts;
+  }
+
   return (*rvs_module_init)(reinterpret_cast<void*>(&d));
 }
 
@@ -395,6 +410,10 @@ int rvs::module::init_interfaces() {
     --sts;
     }
 
+  // optional, not present in modules built against older headers
+  rvs_module_init_ext = reinterpret_cast<t_rvs_module_init_ext>(
+    dlsym(psolib, "rvs_module_init_ext"));
+
   if (init_interface_method(
     reinterpret_cast<void**>(&rvs_module_terminate), "rvs_module_terminate")) {
     --sts;
@@ -23,6 +23,11 @@
  *
  *******************************************************************************/
 
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -39,6 +44,7 @@ class GpuUtilTest : public ::testing::Test , public rvs::gpulist {
     gpu_id      = {1, 2, 5, 4, 9, 7};
     device_id   = {3, 0, 2, 7, 5, 1};
     node_id     = {2, 1, 3, 7, 4, 9};
+    build_index();
   }
 
   void TearDown() override {
@@ -46,6 +52,7 @@ class GpuUtilTest : public ::testing::Test , public rvs::gpulist {
     gpu_id.clear();
     device_id.clear();
     node_id.clear();
+    build_index();
   }
 };
 
@@ -117,3 +124,105 @@ TEST_F(GpuUtilTest, gpu_util) {
   EXPECT_EQ(return_value, -1);
 }
 
+
+class GpuUtilSysfsTest : public ::testing::Test , public rvs::gpulist {
+ protected:
+  void SetUp() override {
+    root = "test_gpu_util_" + std::to_string(getpid());
+    mkdir(root.c_str(), 0755);
+  }
+
+  void TearDown() override {
+    for (const auto& file : files) {
+      unlink(file.c_str());
+    }
+    for (auto it = dirs.rbegin(); it != dirs.rend(); ++it) {
+      rmdir(it->c_str());
+    }
+    rmdir(root.c_str());
+    b_initialized = false;
+    location_id.clear();
+    gpu_id.clear();
+    device_id.clear();
+    node_id.clear();
+    build_index();
+  }
+
+  void write_file(const std::string& path, const std::string& content) {
+    std::ofstream fs(path);
+    fs << content;
+    files.push_back(path);
+  }
+
+  // creates fake KFD topology node
+  void add_node(int node, int gpu, int location, int device) {
+    std::string dir = root + "/" + std::to_string(node);
+    mkdir(dir.c_str(), 0755);
+    dirs.push_back(dir);
+    write_file(dir + "/gpu_id", std::to_string(gpu) + "\n");
+    write_file(dir + "/properties",
+               "cpu_cores_count 0\n"
+               "simd_count 256\n"
+               "vendor_id 4098\n"
+               "device_id " + std::to_string(device) + "\n"
+               "location_id " + std::to_string(location) + "\n"
+               "drm_render_minor 128\n");
+  }
+
+  std::string root;
+  std::vector<std::string> dirs;
+  std::vector<std::string> files;
+};
+
+TEST_F(GpuUtilSysfsTest, snapshot) {
+  // CPU node is skipped, nodes are sorted numerically
+  add_node(0, 0, 0, 0);
+  add_node(10, 3001, 1024, 26287);
+  add_node(2, 3002, 768, 26273);
+  ASSERT_EQ(Initialize(root.c_str()), 0);
+
+  std::vector<uint16_t> expected_node = {2, 10};
+  std::vector<uint16_t> expected_gpu = {3002, 3001};
+  std::vector<uint16_t> expected_location = {768, 1024};
+  std::vector<uint16_t> expected_device = {26273, 26287};
+  EXPECT_EQ(node_id, expected_node);
+  EXPECT_EQ(gpu_id, expected_gpu);
+  EXPECT_EQ(location_id, expected_location);
+  EXPECT_EQ(device_id, expected_device);
+
+  uint16_t result_id;
+  EXPECT_EQ(gpu2node(3001, &result_id), 0);
+  EXPECT_EQ(result_id, 10);
+  EXPECT_EQ(location2gpu(768, &result_id), 0);
+  EXPECT_EQ(result_id, 3002);
+  EXPECT_EQ(gpu2device(3002, &result_id), 0);
+  EXPECT_EQ(result_id, 26273);
+  EXPECT_EQ(node2gpu(0, &result_id), -1);
+
+  std::vector<rvs::kfd_node> nodes;
+  get_nodes(&nodes);
+  ASSERT_EQ(nodes.size(), 2u);
+  EXPECT_EQ(nodes[1].gpu_id, 3001);
+}
+
+TEST_F(GpuUtilSysfsTest, many_nodes) {
+  const int count = 300;
+  for (int i = 0; i < count; i++) {
+    add_node(i, 1000 + i, 2 * i, 26000 + i);
+  }
+  ASSERT_EQ(Initialize(root.c_str()), 0);
+  ASSERT_EQ(gpu_id.size(), static_cast<size_t>(count));
+
+  uint16_t result_id;
+  for (int i = 0; i < count; i++) {
+    ASSERT_EQ(location2node(2 * i, &result_id), 0);
+    EXPECT_EQ(result_id, i);
+    ASSERT_EQ(gpu2location(1000 + i, &result_id), 0);
+    EXPECT_EQ(result_id, 2 * i);
+  }
+}
+
+TEST_F(GpuUtilSysfsTest, missing_root) {
+  EXPECT_EQ(Initialize((root + "/none").c_str()), -1);
+  EXPECT_TRUE(gpu_id.empty());
+}
@@ -0,0 +1,174 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without result_idtriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "include/rvshistogram.h"
+#include "include/rvslatencyreport.h"
+
+TEST(LatencyHistogram, buckets) {
+  // exact below 2^SUB_BITS
+  for (uint64_t v = 0; v < 128; v++) {
+    EXPECT_EQ(rvs::latency_histogram::bucket(v), v);
+    EXPECT_EQ(rvs::latency_histogram::bucket_high(v), v);
+  }
+
+  // every value falls into bucket covering it, within 1/64
+  size_t prev = 0;
+  for (uint64_t v = 128; v < (1ull << 36); v += v / 97 + 1) {
+    size_t ix = rvs::latency_histogram::bucket(v);
+    ASSERT_LT(ix, rvs::latency_histogram::BUCKETS);
+    ASSERT_GE(ix, prev);
+    uint64_t high = rvs::latency_histogram::bucket_high(ix);
+    ASSERT_GE(high, v);
+    ASSERT_LE(high - v, v / 64);
+    if (ix > 0) {
+      ASSERT_LT(rvs::latency_histogram::bucket_high(ix - 1), v);
+    }
+    prev = ix;
+  }
+  EXPECT_EQ(rvs::latency_histogram::bucket(~0ull),
+            rvs::latency_histogram::BUCKETS - 1);
+}
+
+TEST(LatencyHistogram, percentiles) {
+  rvs::latency_histogram h;
+  EXPECT_EQ(h.percentile(50), 0u);
+
+  std::vector<uint64_t> values;
+  std::mt19937_64 gen(1);
+  std::lognormal_distribution<double> dist(10, 1);
+  for (int i = 0; i < 100000; i++) {
+    values.push_back(static_cast<uint64_t>(dist(gen)) + 1);
+    h.record(values.back());
+  }
+  std::sort(values.begin(), values.end());
+
+  EXPECT_EQ(h.count(), values.size());
+  EXPECT_EQ(h.min(), values.front());
+  EXPECT_EQ(h.max(), values.back());
+  EXPECT_EQ(h.percentile(100), values.back());
+
+  const double pct[] = {50, 90, 99, 99.9};
+  for (double p : pct) {
+    uint64_t exact = values[static_cast<size_t>(p / 100 * values.size()) - 1];
+    uint64_t got = h.percentile(p);
+    EXPECT_GE(got, exact);
+    EXPECT_LE(got - exact, exact / 64 + 1) << p;
+  }
+}
+
+TEST(LatencyHistogram, merge) {
+  rvs::latency_histogram a, b, all;
+  for (uint64_t v = 1; v <= 1000; v++) {
+    (v % 2 ? a : b).record(v * 1000);
+    all.record(v * 1000);
+  }
+
+  rvs::latency_histogram m;
+  m.merge(a);
+  m.merge(b);
+  EXPECT_EQ(m.count(), all.count());
+  EXPECT_EQ(m.min(), 1000u);
+  EXPECT_EQ(m.max(), 1000000u);
+  EXPECT_DOUBLE_EQ(m.mean(), all.mean());
+  for (double p : {1.0, 50.0, 99.0, 99.9}) {
+    EXPECT_EQ(m.percentile(p), all.percentile(p));
+  }
+}
+
+TEST(LatencyHistogram, recorder) {
+  rvs::latency_recorder rec;
+  rec.init({4096, 1024, 4096});
+  ASSERT_EQ(rec.size(), 2u);
+  EXPECT_EQ(rec.block_size(0), 1024u);
+
+  rvs::transfer_stats stats;
+  stats.set_sink(&rec);
+  stats.add(1024, 0.000001);
+  stats.add(4096, 0.000002);
+  stats.add(4096, 0.000004);
+  stats.add(512, 0.000008);
+
+  EXPECT_EQ(rec.histogram(0).count(), 1u);
+  EXPECT_EQ(rec.histogram(1).count(), 2u);
+  EXPECT_EQ(rec.histogram(1).max(), 4000u);
+  EXPECT_EQ(rec.find(512), nullptr);
+
+  rvs::latency_histogram all;
+  rec.merge(&all);
+  EXPECT_EQ(all.count(), 3u);
+  EXPECT_EQ(all.min(), 1000u);
+
+  // sizes between block sizes fall into the class of the smaller one
+  EXPECT_EQ(rec.find(3000), &rec.histogram(0));
+  EXPECT_EQ(rec.find(1u << 20), &rec.histogram(1));
+  stats.add(3000, 0.000003);
+  EXPECT_EQ(rec.histogram(0).count(), 2u);
+  EXPECT_EQ(rec.histogram(0).max(), 3000u);
+}
+
+TEST(LatencyHistogram, report) {
+  rvs::latency_recorder rec;
+  rec.init({1024, 4096});
+  rec.record(1024, 0.000001);
+  rec.record(4096, 0.000002);
+
+  rvs::latency_report report("pqt", "action_1", "p2p-latency", true);
+  report.print(rec, "[1/2] 3 4", "3", "4");
+  report.print(rec, "[2/2] 4 3", "4", "3");
+  report.print_all();
+  EXPECT_EQ(report.all().count(), 4u);
+  EXPECT_EQ(report.all().max(), 2000u);
+}
+
+TEST(LatencyHistogram, concurrent_merge) {
+  const uint64_t num = 1000000;
+  rvs::latency_histogram h;
+  std::atomic<bool> done(false);
+
+  std::thread writer([&] {
+    for (uint64_t i = 0; i < num; i++) {
+      h.record(i % 5000);
+    }
+    done = true;
+  });
+
+  while (!done) {
+    rvs::latency_histogram m;
+    m.merge(h);
+    EXPECT_LE(m.percentile(99), 5000u);
+  }
+  writer.join();
+
+  rvs::latency_histogram m;
+  m.merge(h);
+  EXPECT_EQ(m.count(), num);
+}
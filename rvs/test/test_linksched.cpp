@@ -0,0 +1,160 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without result_idtriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "include/rvslinksched.h"
+#include "include/rvs_unit_testing_defs.h"
+
+namespace {
+
+// point-to-point hop type
+const std::string xgmi("xGMI");
+
+// all-to-all transfers between Count agents connected by HopType
+rvs::LinkScheduler all_to_all(uint32_t Count, const std::string& HopType,
+                              bool Bidirectional) {
+  rvs::LinkScheduler sched;
+  sched.SetPointToPoint(xgmi);
+  for (uint32_t src = 0; src < Count; src++) {
+    for (uint32_t dst = 0; dst < Count; dst++) {
+      if (src != dst) {
+        sched.Add(src, dst, {HopType}, Bidirectional);
+      }
+    }
+  }
+  return sched;
+}
+
+// every transfer scheduled exactly once, no shared link within a round
+void check_rounds(const rvs::LinkScheduler& Sched,
+                  const std::vector<std::vector<size_t>>& Rounds) {
+  std::multiset<size_t> seen;
+  for (const auto& round : Rounds) {
+    EXPECT_FALSE(round.empty());
+    std::set<std::string> busy;
+    for (size_t ix : round) {
+      seen.insert(ix);
+      for (const auto& link : Sched.Links(ix)) {
+        EXPECT_TRUE(busy.insert(link).second) << link;
+      }
+    }
+  }
+  ASSERT_EQ(seen.size(), Sched.Size());
+  for (size_t ix = 0; ix < Sched.Size(); ix++) {
+    EXPECT_EQ(seen.count(ix), 1u);
+  }
+}
+
+}  // namespace
+
+TEST(LinkSchedulerTest, path_links) {
+  EXPECT_EQ(rvs::LinkScheduler::PathLinks(3, 5, {xgmi}, xgmi, false),
+            std::vector<std::string>({xgmi + " 3>5"}));
+  EXPECT_EQ(rvs::LinkScheduler::PathLinks(3, 5, {xgmi}, xgmi, true),
+            std::vector<std::string>({xgmi + " 3>5", xgmi + " 5>3"}));
+  EXPECT_EQ(rvs::LinkScheduler::PathLinks(3, 5, {"PCIe", "QPI", "PCIe"},
+                                          xgmi, false),
+            std::vector<std::string>({"PCIe 3 out", "PCIe 5 in"}));
+  EXPECT_EQ(rvs::LinkScheduler::PathLinks(3, 5, {xgmi, xgmi}, xgmi, false),
+            std::vector<std::string>({xgmi + " 3 out", xgmi + " 5 in"}));
+  // without point-to-point type every hop goes through agent ports
+  EXPECT_EQ(rvs::LinkScheduler::PathLinks(3, 5, {xgmi}, "", false),
+            std::vector<std::string>({xgmi + " 3 out", xgmi + " 5 in"}));
+}
+
+TEST(LinkSchedulerTest, xgmi_point_to_point) {
+  // transfers from one GPU to its xGMI peers use separate links
+  rvs::LinkScheduler sched;
+  sched.SetPointToPoint(xgmi);
+  sched.Add(0, 1, {xgmi}, false);
+  sched.Add(0, 2, {xgmi}, false);
+  sched.Add(3, 2, {xgmi}, false);
+  auto rounds = sched.Schedule();
+  check_rounds(sched, rounds);
+  EXPECT_EQ(sched.LowerBound(), 1u);
+  EXPECT_EQ(rounds.size(), 1u);
+}
+
+TEST(LinkSchedulerTest, empty) {
+  rvs::LinkScheduler sched;
+  EXPECT_TRUE(sched.Schedule().empty());
+  EXPECT_EQ(sched.LowerBound(), 0u);
+}
+
+TEST(LinkSchedulerTest, xgmi_mesh) {
+  // fully connected hive, every pair has its own link
+  rvs::LinkScheduler sched = all_to_all(8, xgmi, true);
+  auto rounds = sched.Schedule();
+  check_rounds(sched, rounds);
+  // i->j and j->i share both directions of the same link
+  EXPECT_EQ(sched.LowerBound(), 2u);
+  EXPECT_EQ(rounds.size(), 2u);
+}
+
+TEST(LinkSchedulerTest, pcie_unidirectional) {
+  rvs::LinkScheduler sched = all_to_all(4, "PCIe", false);
+  auto rounds = sched.Schedule();
+  check_rounds(sched, rounds);
+  // each port carries 3 transfers in each direction
+  EXPECT_EQ(sched.LowerBound(), 3u);
+  EXPECT_EQ(rounds.size(), 3u);
+}
+
+TEST(LinkSchedulerTest, pcie_bidirectional) {
+  rvs::LinkScheduler sched = all_to_all(4, "PCIe", true);
+  auto rounds = sched.Schedule();
+  check_rounds(sched, rounds);
+  EXPECT_EQ(sched.LowerBound(), 6u);
+  EXPECT_EQ(rounds.size(), 6u);
+}
+
+TEST(LinkSchedulerTest, shared_switch) {
+  // GPUs 0-3 behind one switch uplink, 4-7 behind another
+  rvs::LinkScheduler sched;
+  for (uint32_t src = 0; src < 8; src++) {
+    for (uint32_t dst = 0; dst < 8; dst++) {
+      if (src == dst) {
+        continue;
+      }
+      std::vector<std::string> links = rvs::LinkScheduler::PathLinks(
+        src, dst, {"PCIe"}, "", false);
+      if (src / 4 != dst / 4) {
+        links.push_back("switch " + std::to_string(src / 4) + " up");
+        links.push_back("switch " + std::to_string(dst / 4) + " down");
+      }
+      sched.Add(links);
+    }
+  }
+  auto rounds = sched.Schedule();
+  check_rounds(sched, rounds);
+  // 16 transfers cross each uplink
+  EXPECT_EQ(sched.LowerBound(), 16u);
+  EXPECT_GE(rounds.size(), sched.LowerBound());
+  EXPECT_LE(rounds.size(), sched.LowerBound() + 2);
+}
@@ -0,0 +1,101 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <stdint.h>
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "include/rvslogarena.h"
+#include "include/rvsliblogger.h"
+#include "include/rvslognoderec.h"
+#include "include/rvs_unit_testing_defs.h"
+
+TEST(LogArenaTest, allocate) {
+  rvs::LogArena arena;
+
+  void* p1 = arena.allocate(3, 1);
+  void* p2 = arena.allocate(sizeof(double), alignof(double));
+  EXPECT_NE(p1, nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(p2) % alignof(double), 0u);
+  EXPECT_GT(reinterpret_cast<char*>(p2), reinterpret_cast<char*>(p1));
+
+  // allocations bigger than a chunk get a chunk of their own
+  char* big = static_cast<char*>(arena.allocate(100000, 8));
+  big[0] = 1;
+  big[99999] = 1;
+
+  // first chunk is reused after reset
+  arena.reset();
+  void* p3 = arena.allocate(3, 1);
+  EXPECT_EQ(p3, p1);
+}
+
+TEST(LogArenaTest, allocator) {
+  rvs::LogArena arena;
+  rvs::ArenaAllocator<char> alloc(&arena);
+
+  // string and vector storage is carved out of the arena
+  rvs::ArenaString s(std::string(200, 'x').c_str(), alloc);
+  rvs::ArenaVector<int> v(alloc);
+  for (int i = 0; i < 100; i++) {
+    v.push_back(i);
+  }
+  char* next = static_cast<char*>(arena.allocate(1, 1));
+  EXPECT_GE(next, s.data() + s.size());
+  EXPECT_GE(next, reinterpret_cast<char*>(v.data() + v.size()));
+  EXPECT_EQ(v[99], 99);
+
+  // without arena memory comes from the heap
+  rvs::ArenaString h(std::string(200, 'y').c_str());
+  EXPECT_EQ(h.size(), 200u);
+}
+
+TEST(LogArenaTest, pool) {
+  rvs::LogArena* a1 = rvs::LogArena::Acquire();
+  rvs::LogArena::Release(a1);
+  rvs::LogArena* a2 = rvs::LogArena::Acquire();
+  EXPECT_EQ(a1, a2);
+  rvs::LogArena::Release(a2);
+}
+
+TEST(LogArenaTest, record) {
+  rvs::logger::to_json(false);
+  for (int i = 0; i < 100; i++) {
+    void* r = rvs::logger::LogRecordCreate("test", "action",
+                                           rvs::logresults, 1, i);
+    rvs::LogNodeBase* rec = static_cast<rvs::LogNodeBase*>(r);
+    EXPECT_NE(rec->GetArena(), nullptr);
+
+    void* n = rvs::logger::CreateNode(r, "node");
+    EXPECT_EQ(static_cast<rvs::LogNodeBase*>(n)->GetArena(),
+              rec->GetArena());
+    rvs::logger::AddString(n, "key", std::string(100, 'x').c_str());
+    rvs::logger::AddInt(n, "val", i);
+    rvs::logger::AddNode(r, n);
+
+    rvs::logger::LogRecordFlush(r);
+  }
+}
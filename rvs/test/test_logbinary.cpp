@@ -0,0 +1,179 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <unistd.h>
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "include/rvsliblogger.h"
+#include "include/rvslogbinary.h"
+#include "include/rvslognoderec.h"
+#include "include/rvslognodestring.h"
+#include "include/rvs_unit_testing_defs.h"
+
+class LogBinaryTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    log_file = "test_logbinary_" + std::to_string(getpid());
+    rvs::logger::quiet();
+    rvs::logger::log_level(rvs::logresults);
+    rvs::logger::to_json(true);
+    rvs::logger::append(false);
+    rvs::logger::set_log_file(log_file);
+  }
+
+  void TearDown() override {
+    rvs::logger::to_binary(false);
+    unlink(log_file.c_str());
+  }
+
+  // writes the same set of records into log file
+  void write_log() {
+    ASSERT_EQ(rvs::logger::init_log_file(), 0);
+    for (int i = 0; i < 50; i++) {
+      void* r = rvs::logger::LogRecordCreate("pqt", "action_1",
+                                             rvs::logresults, 100 + i / 10,
+                                             999990 + i % 10);
+      rvs::logger::AddString(r, "src", "3254");
+      rvs::logger::AddString(r, "bandwidth (GBps)",
+                             std::to_string(i * 1.25).c_str());
+      rvs::logger::AddInt(r, "distance", i % 3 - 1);
+      void* hops = rvs::logger::CreateNode(r, "hops");
+      void* hop = rvs::logger::CreateNode(hops, "hop0");
+      rvs::logger::AddString(hop, "type", "PCIe \"x16\"");
+      rvs::logger::AddNode(hops, hop);
+      rvs::logger::AddNode(r, hops);
+      rvs::logger::LogRecordFlush(r);
+    }
+    ASSERT_EQ(rvs::logger::terminate(), 0);
+  }
+
+  std::string get_content() {
+    std::ifstream fs(log_file, std::ios::binary);
+    std::stringstream ss;
+    ss << fs.rdbuf();
+    return ss.str();
+  }
+
+  std::string log_file;
+};
+
+TEST_F(LogBinaryTest, varint) {
+  std::string out;
+  rvs::LogBinaryWriter::Varint(&out, 0);
+  rvs::LogBinaryWriter::Varint(&out, 127);
+  rvs::LogBinaryWriter::Varint(&out, 128);
+  EXPECT_EQ(out, std::string("\x00\x7f\x80\x01", 4));
+  EXPECT_EQ(rvs::LogBinaryWriter::ZigZag(0), 0u);
+  EXPECT_EQ(rvs::LogBinaryWriter::ZigZag(-1), 1u);
+  EXPECT_EQ(rvs::LogBinaryWriter::ZigZag(1), 2u);
+}
+
+TEST_F(LogBinaryTest, same_as_json) {
+  write_log();
+  std::string json = get_content();
+
+  rvs::logger::to_binary(true);
+  write_log();
+  std::string bin = get_content();
+  EXPECT_LT(bin.size() * 3, json.size());
+
+  // decode binary log and format records the way JSON log does
+  std::istringstream in(bin);
+  rvs::LogBinaryReader reader(&in);
+  std::string decoded("[");
+  int count = 0;
+  while (std::unique_ptr<rvs::LogNodeRec> rec{reader.Next()}) {
+    if (count++)
+      decoded += ",";
+    rec->Serialize(&decoded, "  ", 0);
+  }
+  decoded += RVSENDL "]";
+
+  EXPECT_FALSE(reader.Error());
+  // clock anchor and 50 records
+  EXPECT_EQ(count, 51);
+
+  // wall clock differs between the two runs so drop clock anchor
+  const char* sep = "," RVSENDL "  {";
+  ASSERT_NE(json.find("\"wallclock\""), std::string::npos);
+  ASSERT_NE(decoded.find("\"wallclock\""), std::string::npos);
+  json.erase(1, json.find(sep));
+  decoded.erase(1, decoded.find(sep));
+  EXPECT_EQ(decoded, json);
+}
+
+TEST_F(LogBinaryTest, truncated) {
+  rvs::logger::to_binary(true);
+  write_log();
+  std::string bin = get_content();
+
+  std::istringstream in(bin.substr(0, bin.size() - 3));
+  rvs::LogBinaryReader reader(&in);
+  int count = 0;
+  while (std::unique_ptr<rvs::LogNodeRec> rec{reader.Next()}) {
+    count++;
+  }
+  EXPECT_TRUE(reader.Error());
+  EXPECT_EQ(count, 50);
+}
+
+TEST_F(LogBinaryTest, table_reset) {
+  // tiny string table so that it is reset several times
+  rvs::LogBinaryWriter writer(4);
+  std::string bin;
+  writer.Header(&bin);
+
+  std::string expected;
+  for (int i = 0; i < 20; i++) {
+    rvs::LogNodeRec rec("", rvs::logresults, 1, i);
+    std::string name = "name" + std::to_string(i);
+    rec.Add(new rvs::LogNodeString("key", name.c_str(), &rec));
+    rec.Add(new rvs::LogNodeString(name.c_str(), "value", &rec));
+    writer.Record(&rec, &bin);
+    rec.Serialize(&expected, "", 0);
+  }
+  // "key" is defined again after each reset
+  const std::string keydef("\x01\x03key");
+  size_t defs = 0;
+  for (size_t pos = bin.find(keydef); pos != std::string::npos;
+       pos = bin.find(keydef, pos + 1)) {
+    defs++;
+  }
+  EXPECT_GT(defs, 1u);
+
+  std::istringstream in(bin);
+  rvs::LogBinaryReader reader(&in);
+  std::string decoded;
+  while (std::unique_ptr<rvs::LogNodeRec> rec{reader.Next()}) {
+    rec->Serialize(&decoded, "", 0);
+  }
+  EXPECT_FALSE(reader.Error());
+  EXPECT_EQ(decoded, expected);
+}
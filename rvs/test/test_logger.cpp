@@ -0,0 +1,213 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <unistd.h>
+#include <time.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "include/rvsliblogger.h"
+#include "include/rvslognodebase.h"
+#include "include/rvs_unit_testing_defs.h"
+
+class LoggerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    log_file = "test_logger_" + std::to_string(getpid()) + ".json";
+    rvs::logger::quiet();
+    rvs::logger::log_level(rvs::logresults);
+    rvs::logger::to_json(true);
+    rvs::logger::append(false);
+    rvs::logger::set_log_file(log_file);
+  }
+
+  void TearDown() override {
+    unlink(log_file.c_str());
+  }
+
+  std::string get_content() {
+    std::ifstream fs(log_file);
+    std::stringstream ss;
+    ss << fs.rdbuf();
+    return ss.str();
+  }
+
+  void add_record(int idx) {
+    void* r = rvs::logger::LogRecordCreate("test", "action", rvs::logresults,
+                                           1, idx);
+    rvs::logger::AddInt(r, "idx", idx);
+    rvs::logger::LogRecordFlush(r);
+  }
+
+  std::string log_file;
+};
+
+TEST_F(LoggerTest, json_records_buffered) {
+  ASSERT_EQ(rvs::logger::init_log_file(), 0);
+  for (int i = 0; i < 3; i++) {
+    add_record(i);
+  }
+  ASSERT_EQ(rvs::logger::terminate(), 0);
+
+  std::string content = get_content();
+  ASSERT_FALSE(content.empty());
+  EXPECT_EQ(content.front(), '[');
+  EXPECT_EQ(content.back(), ']');
+  EXPECT_NE(content.find("\"idx\" : 0"), std::string::npos);
+  EXPECT_NE(content.find("\"idx\" : 2"), std::string::npos);
+  EXPECT_NE(content.find("\"wallclock\""), std::string::npos);
+  // clock anchor and three records separated by three commas
+  size_t count = 0;
+  for (size_t pos = content.find("},"); pos != std::string::npos;
+       pos = content.find("},", pos + 1)) {
+    count++;
+  }
+  EXPECT_EQ(count, 3u);
+}
+
+TEST_F(LoggerTest, json_large_run) {
+  ASSERT_EQ(rvs::logger::init_log_file(), 0);
+  // enough records to overflow log buffer several times
+  for (int i = 0; i < 10000; i++) {
+    add_record(i);
+  }
+  ASSERT_EQ(rvs::logger::terminate(), 0);
+
+  std::string content = get_content();
+  EXPECT_EQ(content.front(), '[');
+  EXPECT_EQ(content.back(), ']');
+  EXPECT_NE(content.find("\"idx\" : 9999"), std::string::npos);
+}
+
+TEST_F(LoggerTest, json_records_async) {
+  rvs::logger::async(true);
+  ASSERT_EQ(rvs::logger::init_log_file(), 0);
+  for (int i = 0; i < 1000; i++) {
+    add_record(i);
+  }
+  ASSERT_EQ(rvs::logger::terminate(), 0);
+  rvs::logger::async(false);
+
+  std::string content = get_content();
+  ASSERT_FALSE(content.empty());
+  EXPECT_EQ(content.front(), '[');
+  EXPECT_EQ(content.back(), ']');
+  EXPECT_NE(content.find("\"idx\" : 0"), std::string::npos);
+  EXPECT_NE(content.find("\"idx\" : 999"), std::string::npos);
+}
+
+TEST_F(LoggerTest, json_terminated_while_running) {
+  ASSERT_EQ(rvs::logger::init_log_file(), 0);
+  EXPECT_EQ(get_content(), "[" RVSENDL "]");
+
+  // overflow log buffer so that records are written before terminate()
+  for (int i = 0; i < 10000; i++) {
+    add_record(i);
+  }
+  std::string content = get_content();
+  EXPECT_EQ(content.front(), '[');
+  EXPECT_EQ(content.substr(content.size() - 3), "}" RVSENDL "]");
+
+  ASSERT_EQ(rvs::logger::terminate(), 0);
+}
+
+TEST_F(LoggerTest, json_flushed_when_idle) {
+  ASSERT_EQ(rvs::logger::init_log_file(), 0);
+  add_record(0);
+  EXPECT_EQ(get_content().find("\"idx\" : 0"), std::string::npos);
+
+  // no further rows; timer has to write the buffered one out
+  usleep(1500000);
+  std::string content = get_content();
+  EXPECT_NE(content.find("\"idx\" : 0"), std::string::npos);
+  EXPECT_EQ(content.substr(content.size() - 3), "}" RVSENDL "]");
+
+  ASSERT_EQ(rvs::logger::terminate(), 0);
+}
+
+TEST_F(LoggerTest, json_stop_terminates_once) {
+  ASSERT_EQ(rvs::logger::init_log_file(), 0);
+  add_record(0);
+  rvs::logger::Stop(1);
+  // rvs calls terminate() once more at the end of the run
+  ASSERT_EQ(rvs::logger::terminate(), 0);
+
+  std::string content = get_content();
+  EXPECT_EQ(content.substr(content.size() - 3), "}" RVSENDL "]");
+  EXPECT_EQ(content.find("]" RVSENDL "]"), std::string::npos);
+}
+
+TEST_F(LoggerTest, json_append) {
+  rvs::logger::append(true);
+  for (int run = 0; run < 3; run++) {
+    ASSERT_EQ(rvs::logger::init_log_file(), 0);
+    add_record(run);
+    add_record(run + 10);
+    ASSERT_EQ(rvs::logger::terminate(), 0);
+  }
+  rvs::logger::append(false);
+
+  std::string content = get_content();
+  EXPECT_EQ(content.substr(0, 2), "[" RVSENDL);
+  EXPECT_EQ(content.back(), ']');
+  EXPECT_EQ(content.find("]"), content.size() - 1);
+  EXPECT_NE(content.find("\"idx\" : 12"), std::string::npos);
+  // three clock anchors and six records separated by eight commas
+  size_t count = 0;
+  const char* sep = "," RVSENDL "  {";
+  for (size_t pos = content.find(sep); pos != std::string::npos;
+       pos = content.find(sep, pos + 1)) {
+    count++;
+  }
+  EXPECT_EQ(count, 8u);
+}
+
+TEST_F(LoggerTest, ticks_monotonic) {
+  // let clock calibrate
+  uint32_t sec0, usec0;
+  rvs::logger::get_ticks(&sec0, &usec0);
+  usleep(150000);
+
+  uint32_t sec1, usec1;
+  ASSERT_TRUE(rvs::logger::get_ticks(&sec0, &usec0));
+  for (int i = 0; i < 100000; i++) {
+    ASSERT_TRUE(rvs::logger::get_ticks(&sec1, &usec1));
+    ASSERT_LT(usec1, 1000000u);
+    ASSERT_TRUE(sec1 > sec0 || (sec1 == sec0 && usec1 >= usec0));
+    sec0 = sec1;
+    usec0 = usec1;
+  }
+
+  // must stay in CLOCK_MONOTONIC time base
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  ASSERT_TRUE(rvs::logger::get_ticks(&sec1, &usec1));
+  int64_t diff = (static_cast<int64_t>(sec1) - ts.tv_sec) * 1000000 +
+                 static_cast<int64_t>(usec1) - ts.tv_nsec / 1000;
+  EXPECT_LT(diff < 0 ? -diff : diff, 1000);
+}
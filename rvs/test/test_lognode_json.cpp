@@ -0,0 +1,158 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "include/rvslognode.h"
+#include "include/rvslognodeint.h"
+#include "include/rvslognoderec.h"
+#include "include/rvslognodestring.h"
+#include "include/rvs_unit_testing_defs.h"
+
+// Description of a log record used to build both rvs::LogNode tree and
+// reference output produced by the original string concatenating serializer
+struct node_spec {
+  rvs::eLN type;
+  std::string name;
+  std::string sval;
+  int ival;
+  std::vector<node_spec> child;
+};
+
+static std::string legacy_json(const node_spec& n, const std::string& Lead,
+                               int level, int sec, int usec) {
+  std::string result(RVSENDL);
+  switch (n.type) {
+  case rvs::eLN::Integer:
+    result += Lead + "\"" + n.name + "\"" + " : " + std::to_string(n.ival);
+    return result;
+  case rvs::eLN::String:
+    result += Lead + "\"" + n.name + "\"" + " : " + "\"" + n.sval + "\"";
+    return result;
+  case rvs::eLN::Record: {
+    result += Lead + "{";
+    result += RVSENDL;
+    result += Lead + RVSINDENT;
+    result += std::string("\"") + "loglevel" + "\"" + " : " +
+              std::to_string(level) + ",";
+    char  buff[64];
+    snprintf(buff, sizeof(buff), "%6d.%-6d", sec, usec);
+    result += RVSENDL;
+    result += Lead + RVSINDENT;
+    result += std::string("\"") + "time" + "\"" + " : " +
+              std::string("\"") + buff + std::string("\"")  + ",";
+    break;
+  }
+  default:
+    result += Lead + "\"" + n.name + "\"" + " : {";
+  }
+  int size = n.child.size();
+  for (int i = 0; i < size; i++) {
+    result += legacy_json(n.child[i], Lead + RVSINDENT, level, sec, usec);
+    if (i + 1 < size) {
+      result += ",";
+    }
+  }
+  result += RVSENDL + Lead + "}";
+  return result;
+}
+
+static void build(const node_spec& s, rvs::LogNode* parent) {
+  for (const auto& c : s.child) {
+    switch (c.type) {
+    case rvs::eLN::Integer:
+      parent->Add(new rvs::LogNodeInt(c.name.c_str(), c.ival, parent));
+      break;
+    case rvs::eLN::String:
+      parent->Add(new rvs::LogNodeString(c.name.c_str(), c.sval.c_str(),
+                                         parent));
+      break;
+    default: {
+      rvs::LogNode* p = new rvs::LogNode(c.name.c_str(), parent);
+      build(c, p);
+      parent->Add(p);
+    }
+    }
+  }
+}
+
+// record resembling GPUP/RCQT output: several devices with nested properties
+static node_spec make_record(int devices, int props) {
+  node_spec rec{rvs::eLN::Record, "action", "", 0, {}};
+  rec.child.push_back({rvs::eLN::String, "action", "action_1", 0, {}});
+  rec.child.push_back({rvs::eLN::String, "module", "gpup", 0, {}});
+  for (int d = 0; d < devices; d++) {
+    node_spec dev{rvs::eLN::List, "gpu_" + std::to_string(d), "", 0, {}};
+    for (int p = 0; p < props; p++) {
+      node_spec prop{rvs::eLN::List, "prop_" + std::to_string(p), "", 0, {}};
+      prop.child.push_back({rvs::eLN::Integer, "value", "", p * 1000 - d, {}});
+      prop.child.push_back({rvs::eLN::String, "unit", "MHz", 0, {}});
+      dev.child.push_back(prop);
+    }
+    rec.child.push_back(dev);
+  }
+  return rec;
+}
+
+TEST(LogNodeJsonTest, same_as_legacy) {
+  node_spec spec = make_record(3, 4);
+  rvs::LogNodeRec rec("action", 3, 12, 345);
+  build(spec, &rec);
+
+  EXPECT_EQ(rec.ToJson("  "), legacy_json(spec, "  ", 3, 12, 345));
+  EXPECT_EQ(rec.ToJson(""), legacy_json(spec, "", 3, 12, 345));
+
+  std::string json;
+  rec.Serialize(&json, "T ", 0);
+  EXPECT_EQ(json, legacy_json(spec, "T ", 3, 12, 345));
+}
+
+TEST(LogNodeJsonTest, escape) {
+  rvs::LogNode node("n\"ame");
+  node.Add(new rvs::LogNodeString("path", "c:\\dir\n\x01", &node));
+  node.Add(new rvs::LogNodeInt("min", -2147483647 - 1, &node));
+  EXPECT_EQ(node.ToJson(""),
+            "\n\"n\\\"ame\" : {\n  \"path\" : \"c:\\\\dir\\n\\u0001\","
+            "\n  \"min\" : -2147483648\n}");
+}
+
+TEST(LogNodeJsonTest, reused_buffer) {
+  const int iterations = 100;
+  node_spec spec = make_record(8, 16);
+  rvs::LogNodeRec rec("action", 3, 12, 345);
+  build(spec, &rec);
+
+  const std::string expected = legacy_json(spec, "  ", 3, 12, 345);
+  std::string json;
+  for (int i = 0; i < iterations; i++) {
+    json.clear();
+    rec.Serialize(&json, "  ", 0);
+    ASSERT_EQ(json, expected);
+  }
+}
@@ -0,0 +1,104 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "include/rvslogqueue.h"
+#include "include/rvs_unit_testing_defs.h"
+
+TEST(LogQueueTest, single_thread) {
+  rvs::LogQueue q(4);
+  rvs::LogQueue::Entry e;
+
+  EXPECT_TRUE(q.empty());
+  EXPECT_FALSE(q.pop(&e));
+
+  for (int i = 0; i < 4; i++) {
+    e.Row = std::to_string(i);
+    e.Target = rvs::LogQueue::toCout;
+    EXPECT_TRUE(q.push(&e, false));
+  }
+
+  // queue is full, row is dropped
+  e.Row = "dropped";
+  EXPECT_FALSE(q.push(&e, false));
+  EXPECT_EQ(q.pushed(), 4u);
+  EXPECT_EQ(q.dropped(), 1u);
+  EXPECT_EQ(q.full(), 1u);
+
+  for (int i = 0; i < 4; i++) {
+    EXPECT_TRUE(q.pop(&e));
+    EXPECT_EQ(e.Row, std::to_string(i));
+    EXPECT_EQ(e.Target, rvs::LogQueue::toCout);
+  }
+  EXPECT_TRUE(q.empty());
+  EXPECT_FALSE(q.pop(&e));
+
+  q.reset_counters();
+  EXPECT_EQ(q.pushed(), 0u);
+  EXPECT_EQ(q.dropped(), 0u);
+}
+
+TEST(LogQueueTest, multi_producer) {
+  const int producers = 4;
+  const int rows = 10000;
+  rvs::LogQueue q(64);
+  std::vector<std::thread> t;
+
+  for (int p = 0; p < producers; p++) {
+    t.push_back(std::thread([&q, p, rows]() {
+      for (int i = 0; i < rows; i++) {
+        rvs::LogQueue::Entry e;
+        e.Row = std::to_string(i);
+        e.Target = p;
+        q.push(&e, true);
+      }
+    }));
+  }
+
+  // rows from each producer must arrive in order
+  std::vector<int> next(producers, 0);
+  int total = 0;
+  rvs::LogQueue::Entry e;
+  while (total < producers * rows) {
+    if (!q.pop(&e)) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(std::stoi(e.Row), next[e.Target]);
+    next[e.Target]++;
+    total++;
+  }
+
+  for (auto& it : t) {
+    it.join();
+  }
+  EXPECT_TRUE(q.empty());
+  EXPECT_EQ(q.pushed(), static_cast<uint64_t>(producers * rows));
+  EXPECT_EQ(q.dropped(), 0u);
+}
@@ -0,0 +1,102 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without result_idtriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <stdint.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "include/rvsrandom.h"
+
+TEST(Random, philox_known_answer) {
+  // Random123 known answer for zero counter and key
+  rvs::philox4x32 gen(0, 0);
+  uint32_t out[4];
+  gen.generate(0, out);
+  EXPECT_EQ(out[0], 0x6627e8d5u);
+  EXPECT_EQ(out[1], 0xe169c58du);
+  EXPECT_EQ(out[2], 0xbc57ac4cu);
+  EXPECT_EQ(out[3], 0x9b00dbd8u);
+}
+
+TEST(Random, reproducible) {
+  const size_t count = 3 * 1000 * 1000 + 7;
+  std::vector<float> serial(count);
+  std::vector<float> parallel(count);
+
+  rvs::random_fill(serial.data(), count, 10.0f, 1234, 1, 1);
+  rvs::random_fill(parallel.data(), count, 10.0f, 1234, 1);
+  EXPECT_EQ(serial, parallel);
+
+  // each 32 elements take the four words of eight consecutive counters,
+  // word by word
+  rvs::philox4x32 gen(1234, 1);
+  for (size_t i : {size_t(0), size_t(5), size_t(33), count - 1}) {
+    uint32_t out[4];
+    gen.generate(i / 32 * 8 + i % 8, out);
+    EXPECT_EQ(serial[i], static_cast<float>(out[i % 32 / 8] >> 8) * 10.0f /
+                         16777216.0f);
+  }
+
+  // other stream or seed gives other values
+  rvs::random_fill(parallel.data(), count, 10.0f, 1234, 2);
+  EXPECT_NE(serial, parallel);
+  rvs::random_fill(parallel.data(), count, 10.0f, 1235, 1);
+  EXPECT_NE(serial, parallel);
+}
+
+TEST(Random, distribution) {
+  const size_t count = 1 << 20;
+  std::vector<double> d(count);
+  rvs::random_fill(d.data(), count, 2.0, 42, 0);
+
+  double sum = 0;
+  std::vector<size_t> bins(16);
+  for (double v : d) {
+    ASSERT_GE(v, 0.0);
+    ASSERT_LT(v, 2.0);
+    sum += v;
+    bins[static_cast<size_t>(v * 8)]++;
+  }
+  EXPECT_NEAR(sum / count, 1.0, 0.01);
+  for (size_t b : bins) {
+    EXPECT_NEAR(static_cast<double>(b), count / 16.0, count / 16.0 * 0.05);
+  }
+
+  // half precision: positive, finite, normal and below 1
+  std::vector<uint16_t> h(count);
+  rvs::random_fill_half(h.data(), count, 42, 0);
+  size_t odd = 0;
+  std::vector<size_t> hbins(16);
+  for (uint16_t v : h) {
+    ASSERT_EQ(v & 0xfc00, 0x3800);
+    odd += v & 1;
+    hbins[(v & 0x3ff) >> 6]++;
+  }
+  EXPECT_NEAR(static_cast<double>(odd), count / 2.0, count * 0.01);
+  for (size_t b : hbins) {
+    EXPECT_NEAR(static_cast<double>(b), count / 16.0, count / 16.0 * 0.05);
+  }
+}
@@ -0,0 +1,191 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <math.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "include/rvsratecontrol.h"
+
+namespace {
+
+const uint64_t NS_PER_SEC = 1000000000ull;
+
+//! rate measured over one control window
+struct sample {
+  uint64_t ns;
+  double setpoint;
+  double measured;
+};
+
+/**
+ * @brief Simulated GPU running one GEMM at a time
+ *
+ * Each operation takes host overhead plus Op / Peak seconds. Only
+ * Efficiency of the work shows up in the measured rate, which models a
+ * bias the open loop bucket cannot see.
+ *
+ */
+struct sim_device {
+  double peak = 20000;        // GFLOPS
+  double op = 382;            // GFLOP per GEMM
+  uint64_t overhead = 200000;  // ns per GEMM
+  double efficiency = 1;
+
+  std::vector<sample> run(rvs::rate_controller* ctl,
+                          const rvs::rate_profile& prof,
+                          uint64_t duration, uint64_t window) {
+    std::vector<sample> out;
+    uint64_t t = 0;
+    uint64_t win_start = 0;
+    double done = 0;
+    ctl->reset(0);
+
+    while (t < duration) {
+      uint64_t delay = ctl->next_delay(t, prof.value(t));
+      if (delay > 0) {
+        t += std::min(delay, window);
+        continue;
+      }
+      ctl->consume();
+      t += overhead + static_cast<uint64_t>(op / peak * NS_PER_SEC);
+      done += op * efficiency;
+
+      // measure on completion so that windows hold whole GEMMs
+      if (t - win_start >= window) {
+        double measured = done / ((t - win_start) / 1e9);
+        double sp = prof.value(win_start + (t - win_start) / 2);
+        ctl->update(t, sp, measured);
+        out.push_back({t, sp, measured});
+        win_start = t;
+        done = 0;
+      }
+    }
+    return out;
+  }
+};
+
+//! largest relative error of samples taken in [From, To)
+double max_error(const std::vector<sample>& S, uint64_t From, uint64_t To) {
+  double err = 0;
+  for (const sample& s : S) {
+    if (s.ns >= From && s.ns < To) {
+      err = std::max(err, fabs(s.measured - s.setpoint) / s.setpoint);
+    }
+  }
+  return err;
+}
+
+}  // namespace
+
+TEST(RateControl, profile_shapes) {
+  const uint64_t p = NS_PER_SEC;
+  rvs::rate_profile c(rvs::rate_profile::constant, 100, 20, p, 1);
+  EXPECT_EQ(c.value(0), 100);
+  EXPECT_EQ(c.value(5 * p / 4), 100);
+
+  rvs::rate_profile st(rvs::rate_profile::step, 100, 40, p, 4);
+  EXPECT_EQ(st.value(0), 40);
+  EXPECT_EQ(st.value(p), 60);
+  EXPECT_EQ(st.value(3 * p + p / 2), 100);
+  EXPECT_EQ(st.value(4 * p), 40);
+
+  rvs::rate_profile sq(rvs::rate_profile::square, 100, 20, p, 1);
+  EXPECT_EQ(sq.value(p / 4), 100);
+  EXPECT_EQ(sq.value(3 * p / 4), 20);
+
+  rvs::rate_profile sn(rvs::rate_profile::sine, 100, 20, p, 1);
+  EXPECT_DOUBLE_EQ(sn.value(0), 100);
+  EXPECT_NEAR(sn.value(p / 4), 60, 1e-9);
+  EXPECT_NEAR(sn.value(p / 2), 20, 1e-9);
+
+  rvs::rate_profile::shape shape;
+  EXPECT_TRUE(rvs::rate_profile::parse_shape("square", &shape));
+  EXPECT_EQ(shape, rvs::rate_profile::square);
+  EXPECT_FALSE(rvs::rate_profile::parse_shape("ramp", &shape));
+}
+
+TEST(RateControl, holds_constant) {
+  sim_device dev;
+  rvs::rate_controller ctl(dev.op, rvs::rate_controller::params());
+  rvs::rate_profile prof(rvs::rate_profile::constant, 10000, 10000, 0, 1);
+
+  std::vector<sample> s = dev.run(&ctl, prof, 30 * NS_PER_SEC,
+                                  NS_PER_SEC / 2);
+  EXPECT_LT(max_error(s, 2 * NS_PER_SEC, 30 * NS_PER_SEC), 0.05);
+}
+
+TEST(RateControl, removes_bias) {
+  sim_device dev;
+  dev.efficiency = 0.8;
+  rvs::rate_profile prof(rvs::rate_profile::constant, 10000, 10000, 0, 1);
+
+  // bucket alone settles 20% low
+  rvs::rate_controller::params open;
+  open.kp = open.ki = 0;
+  rvs::rate_controller ol(dev.op, open);
+  std::vector<sample> s = dev.run(&ol, prof, 10 * NS_PER_SEC,
+                                  NS_PER_SEC / 2);
+  EXPECT_NEAR(s.back().measured, 8000, 400);
+
+  rvs::rate_controller cl(dev.op, rvs::rate_controller::params());
+  s = dev.run(&cl, prof, 30 * NS_PER_SEC, NS_PER_SEC / 2);
+  EXPECT_LT(max_error(s, 10 * NS_PER_SEC, 30 * NS_PER_SEC), 0.05);
+  EXPECT_NEAR(cl.correction(), 1.25, 0.05);
+}
+
+TEST(RateControl, tracks_square_and_sine) {
+  sim_device dev;
+  const uint64_t period = 20 * NS_PER_SEC;
+
+  rvs::rate_controller sq_ctl(dev.op, rvs::rate_controller::params());
+  rvs::rate_profile sq(rvs::rate_profile::square, 12000, 4000, period, 1);
+  std::vector<sample> s = dev.run(&sq_ctl, sq, 2 * period, NS_PER_SEC / 2);
+  // settled within two seconds of each edge
+  for (uint64_t edge = 0; edge < 2 * period; edge += period / 2) {
+    EXPECT_LT(max_error(s, edge + 2 * NS_PER_SEC, edge + period / 2), 0.05);
+  }
+
+  rvs::rate_controller sn_ctl(dev.op, rvs::rate_controller::params());
+  rvs::rate_profile sn(rvs::rate_profile::sine, 12000, 4000, period, 1);
+  s = dev.run(&sn_ctl, sn, 2 * period, NS_PER_SEC / 2);
+  EXPECT_LT(max_error(s, 2 * NS_PER_SEC, 2 * period), 0.1);
+}
+
+TEST(RateControl, recovers_from_saturation) {
+  sim_device dev;
+  rvs::rate_controller ctl(dev.op, rvs::rate_controller::params());
+  // twice what the device can do for 10 s, then half of it
+  rvs::rate_profile prof(rvs::rate_profile::square, 2 * dev.peak,
+                         dev.peak / 2, 20 * NS_PER_SEC, 1);
+
+  std::vector<sample> s = dev.run(&ctl, prof, 20 * NS_PER_SEC,
+                                  NS_PER_SEC / 2);
+  EXPECT_LE(ctl.correction(), 1.5);
+  EXPECT_LT(max_error(s, 12 * NS_PER_SEC, 20 * NS_PER_SEC), 0.05);
+}
@@ -0,0 +1,182 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without result_idtriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <random>
+
+#include "gtest/gtest.h"
+
+#include "include/rvssizesweep.h"
+
+namespace {
+
+// bandwidth rising with block size as peak * s / (s + half) where half is
+// the size reaching half of peak bandwidth
+double model(uint64_t Size, double Peak, double Half) {
+  return Peak * Size / (Size + Half);
+}
+
+// smallest size reaching Fraction of model bandwidth at MaxSize
+double model_knee(double Fraction, uint64_t MaxSize, double Half) {
+  double f = Fraction * MaxSize / (MaxSize + Half);
+  return Half * f / (1 - f);
+}
+
+// bytes moved by one pass of the fixed block size list (1 KiB - 512 MiB)
+uint64_t ladder_bytes() {
+  uint64_t bytes = 0;
+  for (uint64_t size = 1024; size <= 512 * 1024 * 1024; size *= 2) {
+    bytes += size;
+  }
+  return bytes;
+}
+
+}  // namespace
+
+TEST(SizeSweep, noiseless) {
+  const double half = 1024 * 1024;
+  rvs::size_sweep::params prm;
+  uint32_t calls = 0;
+  uint64_t bytes = 0;
+
+  rvs::size_sweep sweep(prm, [&](uint64_t Size, double* pBw) {
+    calls++;
+    bytes += Size;
+    *pBw = model(Size, 25, half);
+    return 0;
+  });
+
+  rvs::size_sweep::result res;
+  ASSERT_EQ(sweep.run(&res), 0);
+
+  // plateau is found without going up to the largest size
+  EXPECT_GE(res.plateau_bandwidth,
+            (1 - 2 * prm.flatness) * model(prm.max_size, 25, half));
+  EXPECT_LE(res.plateau_bandwidth, model(prm.max_size, 25, half));
+  double knee = model_knee(prm.plateau * res.plateau_bandwidth / 25,
+                           UINT64_MAX, half);
+  EXPECT_GE(res.knee, knee);
+  EXPECT_LE(res.knee, knee * (1 + prm.resolution) + prm.align);
+  EXPECT_GE(res.knee_bandwidth, prm.plateau * res.plateau_bandwidth);
+  EXPECT_LT(res.below, res.knee);
+
+  // each size measured the minimum number of times as there is no noise
+  for (const auto& p : res.points) {
+    EXPECT_EQ(p.samples, prm.min_samples);
+    EXPECT_EQ(p.size % prm.align, 0u);
+  }
+  EXPECT_EQ(calls, res.points.size() * prm.min_samples);
+
+  // cheaper than a single pass of the fixed block size list
+  EXPECT_LT(bytes, ladder_bytes());
+
+  // knee is confirmed by measuring just the knee and the size below it
+  calls = 0;
+  bytes = 0;
+  rvs::size_sweep::result next;
+  ASSERT_EQ(sweep.run(res, &next), 0);
+  EXPECT_EQ(next.knee, res.knee);
+  EXPECT_EQ(next.points.size(), 2u);
+  EXPECT_EQ(bytes, (res.knee + res.below) * prm.min_samples);
+}
+
+TEST(SizeSweep, knee_moved) {
+  double half = 1024 * 1024;
+  rvs::size_sweep::params prm;
+
+  rvs::size_sweep sweep(prm, [&](uint64_t Size, double* pBw) {
+    *pBw = model(Size, 25, half);
+    return 0;
+  });
+
+  rvs::size_sweep::result res;
+  ASSERT_EQ(sweep.run(&res), 0);
+
+  // slower small transfers move the knee up and trigger a new search
+  half *= 4;
+  rvs::size_sweep::result next;
+  ASSERT_EQ(sweep.run(res, &next), 0);
+  EXPECT_GT(next.knee, res.knee);
+  EXPECT_GT(next.points.size(), 2u);
+
+  // faster small transfers move it down
+  half /= 16;
+  ASSERT_EQ(sweep.run(next, &res), 0);
+  EXPECT_LT(res.knee, next.knee);
+  EXPECT_GT(res.points.size(), 2u);
+}
+
+TEST(SizeSweep, noisy) {
+  const double half = 256 * 1024;
+  rvs::size_sweep::params prm;
+  prm.plateau = 0.8;
+  std::mt19937 gen(7);
+  std::normal_distribution<double> noise(1.0, 0.03);
+
+  rvs::size_sweep sweep(prm, [&](uint64_t Size, double* pBw) {
+    *pBw = model(Size, 12, half) * noise(gen);
+    return 0;
+  });
+
+  rvs::size_sweep::result res;
+  ASSERT_EQ(sweep.run(&res), 0);
+
+  double knee = model_knee(prm.plateau, prm.max_size, half);
+  EXPECT_GT(res.knee, knee * 0.7);
+  EXPECT_LT(res.knee, knee * 1.4);
+  for (const auto& p : res.points) {
+    EXPECT_GE(p.samples, prm.min_samples);
+    EXPECT_LE(p.samples, prm.max_samples);
+    if (p.samples < prm.max_samples) {
+      EXPECT_LE(p.ci, prm.tolerance * p.bandwidth);
+    }
+  }
+}
+
+TEST(SizeSweep, flat_and_errors) {
+  rvs::size_sweep::params prm;
+  prm.min_size = 4096;
+  prm.max_size = 64 * 1024 * 1024;
+
+  rvs::size_sweep flat(prm, [](uint64_t Size, double* pBw) {
+    *pBw = 10;
+    return 0;
+  });
+  rvs::size_sweep::result res;
+  ASSERT_EQ(flat.run(&res), 0);
+  EXPECT_EQ(res.knee, prm.min_size);
+  EXPECT_EQ(res.below, 0u);
+  EXPECT_EQ(res.points.size(), 2u);
+
+  rvs::size_sweep failing(prm, [](uint64_t Size, double* pBw) {
+    *pBw = 0;
+    return Size < 1024 * 1024 ? -5 : 0;
+  });
+  EXPECT_EQ(failing.run(&res), -5);
+
+  prm.max_size = prm.min_size - 1;
+  rvs::size_sweep invalid(prm, [](uint64_t Size, double* pBw) {
+    return 0;
+  });
+  EXPECT_NE(invalid.run(&res), 0);
+}
@@ -0,0 +1,88 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without result_idtriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <chrono>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "include/rvsstopwatch.h"
+#include "include/rvs_unit_testing_defs.h"
+
+TEST(Stopwatch, elapsed) {
+  rvs::stopwatch sw;
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  uint64_t ns = sw.elapsed_ns();
+  EXPECT_GE(ns, 20 * rvs::NS_PER_MS);
+  EXPECT_LT(ns, 200 * rvs::NS_PER_MS);
+  EXPECT_GE(sw.elapsed_ms(), 20u);
+  EXPECT_GE(sw.elapsed_sec(), 0.02);
+  EXPECT_TRUE(sw.expired(20));
+  EXPECT_FALSE(sw.expired(10000));
+
+  uint64_t lap = sw.lap_ns();
+  EXPECT_GE(lap, ns);
+  EXPECT_LT(sw.elapsed_ns(), lap);
+}
+
+TEST(Stopwatch, monotonic) {
+  uint64_t prev = rvs::stopwatch::now_ns();
+  for (int i = 0; i < 100000; i++) {
+    uint64_t now = rvs::stopwatch::now_ns();
+    ASSERT_GE(now, prev);
+    prev = now;
+  }
+}
+
+TEST(Stopwatch, accumulator) {
+  rvs::interval_accumulator acc;
+  EXPECT_EQ(acc.count(), 0u);
+  EXPECT_EQ(acc.min_ns(), 0u);
+  EXPECT_EQ(acc.mean_ns(), 0);
+
+  acc.add(300);
+  acc.add(100);
+  acc.add(200);
+  EXPECT_EQ(acc.count(), 3u);
+  EXPECT_EQ(acc.total_ns(), 600u);
+  EXPECT_EQ(acc.min_ns(), 100u);
+  EXPECT_EQ(acc.max_ns(), 300u);
+  EXPECT_DOUBLE_EQ(acc.mean_ns(), 200);
+  EXPECT_DOUBLE_EQ(acc.total_sec(), 600e-9);
+
+  acc.reset();
+  EXPECT_EQ(acc.count(), 0u);
+  EXPECT_EQ(acc.max_ns(), 0u);
+}
+
+TEST(Stopwatch, scoped) {
+  rvs::interval_accumulator acc;
+  for (int i = 0; i < 3; i++) {
+    rvs::scoped_stopwatch sw(&acc);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  EXPECT_EQ(acc.count(), 3u);
+  EXPECT_GE(acc.min_ns(), 5 * rvs::NS_PER_MS);
+  EXPECT_GE(acc.total_ns(), 15 * rvs::NS_PER_MS);
+}
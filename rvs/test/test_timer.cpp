@@ -23,6 +23,12 @@
  *
  *******************************************************************************/
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "include/rvs_unit_testing_defs.h"
@@ -218,3 +224,59 @@ TEST_F(TimerTest, timer) {
   }
   timer2.stop();
 }
+
+class timed_action {
+ public:
+  // calback
+  void tick(void) {
+    last = std::chrono::steady_clock::now();
+    count++;
+  }
+  std::atomic<int> count{0};
+  std::chrono::steady_clock::time_point last;
+};
+
+TEST(TimerService, many_timers) {
+  const int num_timers = 50;
+  std::vector<timed_action> actions(num_timers);
+  std::vector<std::unique_ptr<rvs::timer<timed_action>>> timers;
+  for (int i = 0; i < num_timers; i++) {
+    timers.emplace_back(new rvs::timer<timed_action>(&timed_action::tick,
+                                                      &actions[i]));
+    timers.back()->start(10);
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(105));
+  for (auto& t : timers) {
+    t->stop();
+  }
+  for (auto& a : actions) {
+    EXPECT_GE(a.count, 8);
+    EXPECT_LE(a.count, 11);
+  }
+}
+
+TEST(TimerService, accuracy) {
+  timed_action action;
+  rvs::timer<timed_action> t(&timed_action::tick, &action);
+  auto start = std::chrono::steady_clock::now();
+  t.start(20, true);
+  std::this_thread::sleep_for(std::chrono::milliseconds(40));
+  ASSERT_EQ(action.count, 1);
+  auto late = std::chrono::duration_cast<std::chrono::microseconds>(
+                action.last - start).count() - 20000;
+  EXPECT_GE(late, 0);
+  EXPECT_LT(late, 5000);
+}
+
+TEST(TimerService, stop_immediate) {
+  timed_action action;
+  rvs::timer<timed_action> t(&timed_action::tick, &action);
+  t.start(10000);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  auto start = std::chrono::steady_clock::now();
+  t.stop();
+  auto took = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start).count();
+  EXPECT_LT(took, 5);
+  EXPECT_EQ(action.count, 0);
+}
@@ -0,0 +1,122 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without result_idtriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <stdio.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "include/rvshsa.h"
+#include "include/rvs_unit_testing_defs.h"
+
+namespace {
+
+// exposes topology of agents added by the test without querying HSA
+class topology_hsa : public rvs::hsa {
+ public:
+  void AddAgent(uint32_t Node, const std::string& Type,
+                const std::string& Name) {
+    AgentInformation agent;
+    agent.node = Node;
+    agent.agent_device_type = Type;
+    agent.agent_name = Name;
+    node_index[Node] = agent_list.size();
+    agent_list.push_back(agent);
+    topology.assign(agent_list.size() * agent_list.size(), NoConnection());
+  }
+
+  TopologyEntry& Entry(uint32_t Src, uint32_t Dst) {
+    return topology[node_index[Src] * agent_list.size() + node_index[Dst]];
+  }
+};
+
+// two GPUs connected by xGMI behind a CPU
+void make_system(topology_hsa* pHsa, const std::string& GpuName) {
+  pHsa->AddAgent(0, "CPU", "AMD EPYC 7742 64-Core Processor");
+  pHsa->AddAgent(1, "GPU", GpuName);
+  pHsa->AddAgent(2, "GPU", GpuName);
+}
+
+std::string temp_file() {
+  char name[] = "/tmp/rvstopologyXXXXXX";
+  int fd = mkstemp(name);
+  if (fd >= 0) {
+    close(fd);
+  }
+  return name;
+}
+
+}  // namespace
+
+TEST(topology, round_trip) {
+  topology_hsa saved;
+  make_system(&saved, "gfx908");
+  rvs::linkinfo_t xgmi;
+  xgmi.distance = 15;
+  xgmi.etype = HSA_AMD_LINK_INFO_TYPE_XGMI;
+  xgmi.strtype = rvs::hsa::LinkTypeName(xgmi.etype);
+  saved.Entry(1, 2).distance = 15;
+  saved.Entry(1, 2).peer_status = 2;
+  saved.Entry(1, 2).hops.push_back(xgmi);
+  saved.Entry(2, 1) = saved.Entry(1, 2);
+
+  std::string file = temp_file();
+  ASSERT_EQ(saved.SaveTopology(file), 0);
+
+  topology_hsa loaded;
+  make_system(&loaded, "gfx908");
+  ASSERT_EQ(loaded.LoadTopology(file), 0);
+  for (uint32_t src = 0; src < 3; src++) {
+    for (uint32_t dst = 0; dst < 3; dst++) {
+      const auto& expected = saved.Entry(src, dst);
+      const auto& actual = loaded.Entry(src, dst);
+      EXPECT_EQ(actual.distance, expected.distance);
+      EXPECT_EQ(actual.peer_status, expected.peer_status);
+      ASSERT_EQ(actual.hops.size(), expected.hops.size());
+      for (size_t h = 0; h < expected.hops.size(); h++) {
+        EXPECT_EQ(actual.hops[h].distance, expected.hops[h].distance);
+        EXPECT_EQ(actual.hops[h].etype, expected.hops[h].etype);
+        EXPECT_EQ(actual.hops[h].strtype, expected.hops[h].strtype);
+      }
+    }
+  }
+  EXPECT_EQ(loaded.Entry(0, 1).distance, rvs::hsa::NO_CONN);
+  remove(file.c_str());
+}
+
+TEST(topology, stale_file) {
+  topology_hsa saved;
+  make_system(&saved, "gfx908");
+  std::string file = temp_file();
+  ASSERT_EQ(saved.SaveTopology(file), 0);
+
+  topology_hsa other;
+  make_system(&other, "gfx90a");
+  EXPECT_NE(other.LoadTopology(file), 0);
+  EXPECT_EQ(other.Entry(1, 2).distance, rvs::hsa::NO_CONN);
+  remove(file.c_str());
+}
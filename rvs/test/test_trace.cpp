@@ -0,0 +1,86 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef RVS_DO_TRACE
+#define RVS_DO_TRACE
+#endif
+
+#include <chrono>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "include/rvsloglp.h"
+#include "include/rvsliblogger.h"
+#include "include/rvs_unit_testing_defs.h"
+
+// trace macro as it was before call site level check was introduced
+#define LEGACY_TRACE_ rvs::lp::Log(std::string(__FILE__)+"   "+__func__+":"\
+  +std::to_string(__LINE__), rvs::logtrace);
+
+static int sink = 0;
+
+// emulates transfer loop body with a few trace points
+static void loop_new(int count) {
+  for (int i = 0; i < count; i++) {
+    RVSTRACE_
+    sink += i;
+    RVSTRACE_
+    RVSDEBUG("size", std::to_string(i));
+  }
+}
+
+static void loop_legacy(int count) {
+  for (int i = 0; i < count; i++) {
+    LEGACY_TRACE_
+    sink += i;
+    LEGACY_TRACE_
+    LEGACY_TRACE_
+  }
+}
+
+TEST(TraceTest, disabled_level_overhead) {
+  const int iterations = 200000;
+  rvs::logger::quiet();
+  rvs::logger::log_level(rvs::logerror);
+
+  auto t0 = std::chrono::steady_clock::now();
+  loop_legacy(iterations);
+  auto t1 = std::chrono::steady_clock::now();
+  loop_new(iterations);
+  auto t2 = std::chrono::steady_clock::now();
+
+  double legacy_ns =
+    std::chrono::duration<double, std::nano>(t1 - t0).count() / iterations;
+  double new_ns =
+    std::chrono::duration<double, std::nano>(t2 - t1).count() / iterations;
+  EXPECT_LT(new_ns, legacy_ns);
+}
+
+TEST(TraceTest, log_on) {
+  rvs::logger::log_level(rvs::logdebug);
+  EXPECT_TRUE(rvs::lp::LogOn(rvs::logdebug));
+  rvs::logger::log_level(rvs::logtrace);
+  EXPECT_TRUE(rvs::lp::LogOn(rvs::logtrace));
+}
@@ -0,0 +1,115 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without result_idtriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "include/rvstransferstats.h"
+
+namespace {
+
+class count_sink : public rvs::transfer_sink {
+ public:
+  count_sink() : num(0), size(0) {}
+  void record(uint64_t Size, double Duration) override {
+    num++;
+    size += Size;
+  }
+  uint64_t num;
+  uint64_t size;
+};
+
+}  // namespace
+
+TEST(TransferStats, running_and_final) {
+  rvs::transfer_stats stats;
+  rvs::transfer_stats::data d;
+  count_sink sink;
+  stats.set_sink(&sink);
+
+  stats.add(100, 1.0);
+  stats.add(50, 0.5);
+  stats.take_running(&d);
+  EXPECT_EQ(d.size, 150u);
+  EXPECT_DOUBLE_EQ(d.duration, 1.5);
+
+  stats.add(10, 0.25);
+  stats.take_running(&d);
+  EXPECT_EQ(d.size, 10u);
+  EXPECT_DOUBLE_EQ(d.duration, 0.25);
+  stats.take_running(&d);
+  EXPECT_EQ(d.size, 0u);
+
+  stats.take_final(&d, true);
+  EXPECT_EQ(d.size, 160u);
+  EXPECT_DOUBLE_EQ(d.duration, 1.75);
+  stats.add(5, 0.125);
+  stats.take_final(&d, false);
+  EXPECT_EQ(d.size, 5u);
+  stats.take_running(&d);
+  EXPECT_EQ(d.size, 0u);
+
+  EXPECT_EQ(sink.num, 4u);
+  EXPECT_EQ(sink.size, 165u);
+}
+
+TEST(TransferStats, concurrent_reader) {
+  const uint64_t num = 1000000;
+  rvs::transfer_stats stats;
+  std::atomic<bool> done(false);
+
+  std::thread writer([&] {
+    for (uint64_t i = 0; i < num; i++) {
+      // duration always equals size so snapshots must agree
+      stats.add(1, 1.0);
+    }
+    done = true;
+  });
+
+  uint64_t size = 0;
+  double duration = 0;
+  bool consistent = true;
+  while (!done) {
+    rvs::transfer_stats::data d;
+    stats.take_running(&d);
+    consistent &= (static_cast<double>(d.size) == d.duration);
+    size += d.size;
+    duration += d.duration;
+  }
+  writer.join();
+
+  rvs::transfer_stats::data d;
+  stats.take_running(&d);
+  size += d.size;
+  duration += d.duration;
+  EXPECT_TRUE(consistent);
+  EXPECT_EQ(size, num);
+  EXPECT_DOUBLE_EQ(duration, static_cast<double>(num));
+
+  stats.take_final(&d, true);
+  EXPECT_EQ(d.size, num);
+}
@@ -0,0 +1,107 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without result_idtriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <atomic>
+#include <chrono>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "include/rvsworkpool.h"
+#include "include/rvs_unit_testing_defs.h"
+
+TEST(WorkPoolTest, cpulist) {
+  EXPECT_EQ(rvs::WorkPool::ParseCpuList("0-3,8,10-11\n"),
+            std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+  EXPECT_EQ(rvs::WorkPool::ParseCpuList("5"), std::vector<int>({5}));
+  EXPECT_TRUE(rvs::WorkPool::ParseCpuList("").empty());
+  EXPECT_TRUE(rvs::WorkPool::ParseCpuList("3-1").empty());
+  EXPECT_TRUE(rvs::WorkPool::ParseCpuList("x").empty());
+}
+
+TEST(WorkPoolTest, runs_all_tasks) {
+  rvs::WorkPool pool(4);
+  EXPECT_EQ(pool.Threads(), 4u);
+  EXPECT_GE(pool.Nodes(), 1u);
+
+  std::atomic<int> count(0);
+  // pool stays alive across several runs
+  for (int run = 0; run < 3; run++) {
+    for (int i = 0; i < 1000; i++) {
+      pool.Submit([&count]{ count++; }, i % 3 - 1);
+    }
+    pool.Wait();
+    EXPECT_EQ(count, (run + 1) * 1000);
+  }
+}
+
+TEST(WorkPoolTest, resubmit_and_hold) {
+  rvs::WorkPool pool(3);
+  std::atomic<int> count(0);
+
+  // each chain resubmits itself, Wait() covers the whole chain
+  std::function<void()> step = [&]{
+    if (++count % 100 != 0) {
+      pool.Submit(step);
+    }
+  };
+  for (int i = 0; i < 8; i++) {
+    pool.Submit(step);
+  }
+  pool.Wait();
+  EXPECT_EQ(count, 800);
+
+  // work outside the pool keeps Wait() blocked until released
+  std::atomic<bool> done(false);
+  pool.Hold();
+  std::thread t([&]{
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    pool.Submit([&done]{ done = true; });
+    pool.Release();
+  });
+  pool.Wait();
+  EXPECT_TRUE(done);
+  t.join();
+}
+
+TEST(WorkPoolTest, idle_threads_steal) {
+  rvs::WorkPool pool(4);
+  std::mutex mtx;
+  std::set<std::thread::id> ids;
+
+  // all tasks are queued on one thread, others have to steal them
+  pool.Submit([&]{
+    for (int i = 0; i < 16; i++) {
+      pool.Submit([&]{
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        std::lock_guard<std::mutex> lk(mtx);
+        ids.insert(std::this_thread::get_id());
+      });
+    }
+  });
+  pool.Wait();
+  EXPECT_GT(ids.size(), 1u);
+}
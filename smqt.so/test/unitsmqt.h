@@ -0,0 +1,42 @@
+/********************************************************************************
+ * 
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef SMQT_SO_TEST_UNITSMQT_H_
+#define SMQT_SO_TEST_UNITSMQT_H_
+#include <tuple>
+#include "include/action.h"
+
+
+class bar_data :public smqt_action {
+ public:
+  bar_data();
+  virtual ~bar_data();
+  virtual void on_set_device_gpu_id();
+  virtual void on_bar_data_read();
+  std::tuple<ulong, ulong, ulong, ulong> get_bar_sizes();
+  std::tuple<ulong, ulong, ulong> get_bar_addr();
+  int get_dev_id();
+};
+
+#endif  // SMQT_SO_TEST_UNITSMQT_H_
@@ -26,8 +26,9 @@
 
 #include <stdlib.h>
 #include <dirent.h>
+#include <fcntl.h>
 #include <string.h>
-#include <fstream>
+#include <unistd.h>
 #include <map>
 #include <string>
 #include <vector>
@@ -37,10 +38,13 @@ std::vector<uint16_t> rvs::gpulist::location_id;
 std::vector<uint16_t> rvs::gpulist::gpu_id;
 std::vector<uint16_t> rvs::gpulist::device_id;
 std::vector<uint16_t> rvs::gpulist::node_id;
+std::unordered_map<uint16_t, size_t> rvs::gpulist::gpu_index;
+std::unordered_map<uint16_t, size_t> rvs::gpulist::location_index;
+std::unordered_map<uint16_t, size_t> rvs::gpulist::node_index;
+bool rvs::gpulist::b_initialized = false;
 
 using std::vector;
 using std::string;
-using std::ifstream;
 
 int gpu_num_subdirs(const char* dirpath, const char* prefix) {
   int count = 0;
@@ -65,76 +69,150 @@ int gpu_num_subdirs(const char* dirpath, const char* prefix) {
 }
 
 /**
- * gets all GPUS location_id
- * @param pgpus_location_id ptr to vector that will store all the GPU location_id
- * @return
+ * @brief Read whole sysfs file into buffer
+ * @param path file path
+ * @param buff buffer
+ * @param size buffer size
+ * @return number of bytes read (buffer is null terminated), -1 on error
  */
-void gpu_get_all_location_id(std::vector<uint16_t>* pgpus_location_id) {
-  ifstream f_id, f_prop;
-  char path[KFD_PATH_MAX_LENGTH];
-
-  std::string prop_name;
-  int gpu_id;
-  uint32_t prop_val;
-
-
-  // Discover the number of nodes: Inside nodes folder there are only folders
-  // that represent the node number
-  int num_nodes = gpu_num_subdirs(KFD_SYS_PATH_NODES, "");
-
-  // get all GPUs device id
-  for (int node_id = 0; node_id < num_nodes; node_id++) {
-    snprintf(path, KFD_PATH_MAX_LENGTH, "%s/%d/gpu_id", KFD_SYS_PATH_NODES,
-           node_id);
-    f_id.open(path);
-    snprintf(path, KFD_PATH_MAX_LENGTH, "%s/%d/properties",
-             KFD_SYS_PATH_NODES, node_id);
-    f_prop.open(path);
-
-    f_id >> gpu_id;
-
-    if (gpu_id != 0) {
-      while (f_prop >> prop_name) {
-        if (prop_name == "location_id") {
-          f_prop >> prop_val;
-          (*pgpus_location_id).push_back(prop_val);
-          break;
-        }
-      }
+static ssize_t gpu_read_file(const char* path, char* buff, size_t size) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return -1;
+  }
+  size_t len = 0;
+  while (len < size - 1) {
+    ssize_t n = read(fd, buff + len, size - 1 - len);
+    if (n <= 0) {
+      break;
     }
+    len += n;
+  }
+  close(fd);
+  buff[len] = '\0';
+  return len;
+}
 
-    f_id.close();
-    f_prop.close();
+/**
+ * @brief Fetch GPU properties from node properties file contents
+ *
+ * File consists of lines in "name value" format.
+ *
+ * @param text null terminated file contents
+ * @param pnode node to fill in
+ */
+static void gpu_parse_properties(const char* text, rvs::kfd_node* pnode) {
+  const char* p = text;
+  while (*p) {
+    const char* name = p;
+    while (*p && *p != ' ' && *p != '\n')
+      p++;
+    size_t name_len = p - name;
+    while (*p == ' ')
+      p++;
+    char* end;
+    uint64_t val = strtoull(p, &end, 10);
+    if (name_len == 11 && strncmp(name, "location_id", 11) == 0) {
+      pnode->location_id = val;
+    } else if (name_len == 9 && strncmp(name, "device_id", 9) == 0) {
+      pnode->device_id = val;
+    }
+    p = end;
+    while (*p && *p != '\n')
+      p++;
+    if (*p)
+      p++;
   }
 }
 
 /**
- * gets all GPUS gpu_id
- * @param pgpus_id ptr to vector that will store all the GPU gpu_id
- * @return
+ * @brief Read GPU nodes from KFD topology in a single pass
+ *
+ * Nodes which are not GPUs (gpu_id is 0) are skipped.
+ *
+ * @param NodesPath path to KFD topology nodes folder
+ * @param pNodes ptr to vector that will receive GPU nodes sorted by node ID
+ * @return 0 if successful, -1 if the folder can't be read
  */
-void gpu_get_all_gpu_id(std::vector<uint16_t>* pgpus_id) {
-  ifstream f_id, f_prop;
-  char path[KFD_PATH_MAX_LENGTH];
+int rvs::gpulist::read_nodes(const char* NodesPath, vector<kfd_node>* pNodes) {
+  vector<int> nodes;
+  DIR* dirp = opendir(NodesPath);
+  if (dirp == nullptr) {
+    return -1;
+  }
+  struct dirent* dir;
+  while ((dir = readdir(dirp)) != 0) {
+    char* end;
+    int64_t node = strtol(dir->d_name, &end, 10);
+    if (end != dir->d_name && *end == '\0') {
+      nodes.push_back(node);
+    }
+  }
+  closedir(dirp);
+  std::sort(nodes.begin(), nodes.end());
 
-  int gpu_id;
+  char path[KFD_PATH_MAX_LENGTH];
+  char buff[8192];
+  pNodes->clear();
+  for (int node : nodes) {
+    snprintf(path, KFD_PATH_MAX_LENGTH, "%s/%d/gpu_id", NodesPath, node);
+    if (gpu_read_file(path, buff, sizeof(buff)) <= 0) {
+      continue;
+    }
+    kfd_node info = {static_cast<uint16_t>(node),
+                     static_cast<uint16_t>(strtoul(buff, nullptr, 10)), 0, 0};
+    if (info.gpu_id == 0) {
+      continue;
+    }
 
-  // Discover the number of nodes: Inside nodes folder there are only folders
-  // that represent the node number
-  int num_nodes = gpu_num_subdirs(KFD_SYS_PATH_NODES, "");
+    snprintf(path, KFD_PATH_MAX_LENGTH, "%s/%d/properties", NodesPath, node);
+    if (gpu_read_file(path, buff, sizeof(buff)) > 0) {
+      gpu_parse_properties(buff, &info);
+    }
+    pNodes->push_back(info);
+  }
 
-  // get all GPUs device id
-  for (int node_id = 0; node_id < num_nodes; node_id++) {
-    snprintf(path, KFD_PATH_MAX_LENGTH, "%s/%d/gpu_id", KFD_SYS_PATH_NODES,
-             node_id);
-    f_id.open(path);
+  return 0;
+}
 
-    f_id >> gpu_id;
+/**
+ * @brief Fetch GPU nodes from gpulist if initialized, otherwise from sysfs
+ * @param pNodes ptr to vector that will receive GPU nodes
+ */
+void rvs::gpulist::get_nodes(vector<kfd_node>* pNodes) {
+  if (!b_initialized) {
+    read_nodes(KFD_SYS_PATH_NODES, pNodes);
+    return;
+  }
+  pNodes->clear();
+  for (size_t i = 0; i < gpu_id.size(); i++) {
+    pNodes->push_back({node_id[i], gpu_id[i], location_id[i], device_id[i]});
+  }
+}
 
-    if (gpu_id != 0)
-      (*pgpus_id).push_back(gpu_id);
+/**
+ * gets all GPUS location_id
+ * @param pgpus_location_id ptr to vector that will store all the GPU location_id
+ * @return
+ */
+void gpu_get_all_location_id(std::vector<uint16_t>* pgpus_location_id) {
+  vector<rvs::kfd_node> nodes;
+  rvs::gpulist::get_nodes(&nodes);
+  for (const auto& node : nodes) {
+    pgpus_location_id->push_back(node.location_id);
+  }
+}
 
-    f_id.close();
+/**
+ * gets all GPUS gpu_id
+ * @param pgpus_id ptr to vector that will store all the GPU gpu_id
+ * @return
+ */
+void gpu_get_all_gpu_id(std::vector<uint16_t>* pgpus_id) {
+  vector<rvs::kfd_node> nodes;
+  rvs::gpulist::get_nodes(&nodes);
+  for (const auto& node : nodes) {
+    pgpus_id->push_back(node.gpu_id);
   }
 }
 
@@ -144,40 +222,10 @@ void gpu_get_all_gpu_id(std::vector<uint16_t>* pgpus_id) {
  * @return
  */
 void gpu_get_all_device_id(std::vector<uint16_t>* pgpus_device_id) {
-  ifstream f_id, f_prop;
-  char path[KFD_PATH_MAX_LENGTH];
-
-  std::string prop_name;
-  int gpu_id;
-  uint32_t prop_val;
-
-  // Discover the number of nodes: Inside nodes folder there are only folders
-  // that represent the node number
-  int num_nodes = gpu_num_subdirs(KFD_SYS_PATH_NODES, "");
-
-  // get all GPUs device id
-  for (int node_id = 0; node_id < num_nodes; node_id++) {
-    snprintf(path, KFD_PATH_MAX_LENGTH, "%s/%d/gpu_id", KFD_SYS_PATH_NODES,
-             node_id);
-    f_id.open(path);
-    snprintf(path, KFD_PATH_MAX_LENGTH, "%s/%d/properties",
-             KFD_SYS_PATH_NODES, node_id);
-    f_prop.open(path);
-
-    f_id >> gpu_id;
-
-    if (gpu_id != 0) {
-      while (f_prop >> prop_name) {
-        if (prop_name == "device_id") {
-          f_prop >> prop_val;
-          (*pgpus_device_id).push_back(prop_val);
-          break;
-        }
-      }
-    }
-
-    f_id.close();
-    f_prop.close();
+  vector<rvs::kfd_node> nodes;
+  rvs::gpulist::get_nodes(&nodes);
+  for (const auto& node : nodes) {
+    pgpus_device_id->push_back(node.device_id);
   }
 }
 
@@ -187,39 +235,56 @@ void gpu_get_all_device_id(std::vector<uint16_t>* pgpus_device_id) {
  * @return
  */
 void gpu_get_all_node_id(std::vector<uint16_t>* pgpus_node_id) {
-  ifstream f_id;
-  char path[KFD_PATH_MAX_LENGTH];
-  int gpu_id;
-
-
-  // Discover the number of nodes: Inside nodes folder there are only folders
-  // that represent the node number
-  int num_nodes = gpu_num_subdirs(KFD_SYS_PATH_NODES, "");
-
-  // get all GPUs device id
-  for (int node_id = 0; node_id < num_nodes; node_id++) {
-    snprintf(path, KFD_PATH_MAX_LENGTH, "%s/%d/gpu_id", KFD_SYS_PATH_NODES,
-           node_id);
-    f_id.open(path);
-    f_id >> gpu_id;
-
-    if (gpu_id != 0) {
-      (*pgpus_node_id).push_back(node_id);
-    }
-    f_id.close();
+  vector<rvs::kfd_node> nodes;
+  rvs::gpulist::get_nodes(&nodes);
+  for (const auto& node : nodes) {
+    pgpus_node_id->push_back(node.node_id);
   }
 }
 
 /**
  * @brief Initialize gpulist helper class
+ * @param NodesPath path to KFD topology nodes folder
  * @return 0 if successful, -1 otherwise
  **/
-int rvs::gpulist::Initialize() {
-  gpu_get_all_location_id(&location_id);
-  gpu_get_all_gpu_id(&gpu_id);
-  gpu_get_all_device_id(&device_id);
-  gpu_get_all_node_id(&node_id);
-  return 0;
+int rvs::gpulist::Initialize(const char* NodesPath) {
+  vector<kfd_node> nodes;
+  int sts = read_nodes(NodesPath, &nodes);
+
+  location_id.clear();
+  gpu_id.clear();
+  device_id.clear();
+  node_id.clear();
+  for (const auto& node : nodes) {
+    location_id.push_back(node.location_id);
+    gpu_id.push_back(node.gpu_id);
+    device_id.push_back(node.device_id);
+    node_id.push_back(node.node_id);
+  }
+  build_index();
+  b_initialized = (sts == 0);
+
+  return sts;
+}
+
+/**
+ * @brief Build lookup indexes from the arrays
+ *
+ * For duplicate IDs the first occurrence is kept.
+ **/
+void rvs::gpulist::build_index() {
+  gpu_index.clear();
+  location_index.clear();
+  node_index.clear();
+  for (size_t i = 0; i < gpu_id.size(); i++) {
+    gpu_index.emplace(gpu_id[i], i);
+  }
+  for (size_t i = 0; i < location_id.size(); i++) {
+    location_index.emplace(location_id[i], i);
+  }
+  for (size_t i = 0; i < node_id.size(); i++) {
+    node_index.emplace(node_id[i], i);
+  }
 }
 
 
@@ -231,13 +296,11 @@ int rvs::gpulist::Initialize() {
  **/
 int rvs::gpulist::gpu2location(const uint16_t GpuID,
                                uint16_t* pLocationID) {
-  const auto it = std::find(gpu_id.cbegin(),
-                            gpu_id.cend(), GpuID);
-  if (it == gpu_id.cend()) {
+  const auto it = gpu_index.find(GpuID);
+  if (it == gpu_index.cend()) {
     return -1;
   }
-  size_t pos = std::distance(gpu_id.cbegin(), it);
-  *pLocationID = location_id[pos];
+  *pLocationID = location_id[it->second];
   return 0;
 }
 
@@ -249,13 +312,11 @@ int rvs::gpulist::gpu2location(const uint16_t GpuID,
  * @return 0 if found, -1 otherwise
  **/
 int rvs::gpulist::location2gpu(const uint16_t LocationID, uint16_t* pGpuID) {
-  const auto it = std::find(location_id.cbegin(),
-                            location_id.cend(), LocationID);
-  if (it == location_id.cend()) {
+  const auto it = location_index.find(LocationID);
+  if (it == location_index.cend()) {
     return -1;
   }
-  size_t pos = std::distance(location_id.cbegin(), it);
-  *pGpuID = gpu_id[pos];
+  *pGpuID = gpu_id[it->second];
   return 0;
 }
 
@@ -267,13 +328,11 @@ int rvs::gpulist::location2gpu(const uint16_t LocationID, uint16_t* pGpuID) {
  * @return 0 if found, -1 otherwise
  **/
 int rvs::gpulist::node2gpu(const uint16_t NodeID, uint16_t* pGpuID) {
-  const auto it = std::find(node_id.cbegin(),
-                            node_id.cend(), NodeID);
-  if (it == node_id.cend()) {
+  const auto it = node_index.find(NodeID);
+  if (it == node_index.cend()) {
     return -1;
   }
-  size_t pos = std::distance(node_id.cbegin(), it);
-  *pGpuID = gpu_id[pos];
+  *pGpuID = gpu_id[it->second];
   return 0;
 }
 
@@ -286,13 +345,11 @@ int rvs::gpulist::node2gpu(const uint16_t NodeID, uint16_t* pGpuID) {
  **/
 int rvs::gpulist::location2device(const uint16_t LocationID,
                                   uint16_t* pDeviceID) {
-  const auto it = std::find(location_id.cbegin(),
-                            location_id.cend(), LocationID);
-  if (it == location_id.cend()) {
+  const auto it = location_index.find(LocationID);
+  if (it == location_index.cend()) {
     return -1;
   }
-  size_t pos = std::distance(location_id.cbegin(), it);
-  *pDeviceID = device_id[pos];
+  *pDeviceID = device_id[it->second];
   return 0;
 }
 
@@ -304,14 +361,11 @@ int rvs::gpulist::location2device(const uint16_t LocationID,
  * @return 0 if found, -1 otherwise
  **/
 int rvs::gpulist::gpu2device(const uint16_t GpuID, uint16_t* pDeviceID) {
-  const auto it = std::find(gpu_id.cbegin(),
-                            gpu_id.cend(), GpuID);
-  if (it == gpu_id.cend()) {
+  const auto it = gpu_index.find(GpuID);
+  if (it == gpu_index.cend()) {
     return -1;
   }
-
-  size_t pos = std::distance(gpu_id.cbegin(), it);
-  *pDeviceID = device_id[pos];
+  *pDeviceID = device_id[it->second];
   return 0;
 }
 
@@ -323,14 +377,11 @@ int rvs::gpulist::gpu2device(const uint16_t GpuID, uint16_t* pDeviceID) {
  * @return 0 if found, -1 otherwise
  **/
 int rvs::gpulist::gpu2node(const uint16_t GpuID, uint16_t* pNodeID) {
-  const auto it = std::find(gpu_id.cbegin(),
-                            gpu_id.cend(), GpuID);
-  if (it == gpu_id.cend()) {
+  const auto it = gpu_index.find(GpuID);
+  if (it == gpu_index.cend()) {
     return -1;
   }
-
-  size_t pos = std::distance(gpu_id.cbegin(), it);
-  *pNodeID = node_id[pos];
+  *pNodeID = node_id[it->second];
   return 0;
 }
 
@@ -343,14 +394,11 @@ int rvs::gpulist::gpu2node(const uint16_t GpuID, uint16_t* pNodeID) {
  **/
 int rvs::gpulist::location2node(const uint16_t LocationID,
                                     uint16_t* pNodeID) {
-  const auto it = std::find(location_id.cbegin(),
-                            location_id.cend(), LocationID);
-  if (it == location_id.cend()) {
+  const auto it = location_index.find(LocationID);
+  if (it == location_index.cend()) {
     return -1;
   }
-
-  size_t pos = std::distance(location_id.cbegin(), it);
-  *pNodeID = node_id[pos];
+  *pNodeID = node_id[it->second];
   return 0;
 }
 
@@ -27,9 +27,215 @@
 #include <time.h>
 #include <iostream>
 
+#include "include/rvsrandom.h"
+#include "include/rvsstopwatch.h"
+
 #define RANDOM_CT               320000
 #define RANDOM_DIV_CT           0.1234
 
+namespace {
+
+//! rocBlas GEMM call for float
+rocblas_status gemm_call(rocblas_handle handle, rocblas_operation transa,
+                         rocblas_operation transb, rocblas_int m,
+                         rocblas_int n, rocblas_int k, const float* alpha,
+                         const float* a, int lda, const float* b, int ldb,
+                         const float* beta, float* c, int ldc) {
+    return rocblas_sgemm(handle, transa, transb, m, n, k,
+                         alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+//! rocBlas GEMM call for double
+rocblas_status gemm_call(rocblas_handle handle, rocblas_operation transa,
+                         rocblas_operation transb, rocblas_int m,
+                         rocblas_int n, rocblas_int k, const double* alpha,
+                         const double* a, int lda, const double* b, int ldb,
+                         const double* beta, double* c, int ldc) {
+    return rocblas_dgemm(handle, transa, transb, m, n, k,
+                         alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+//! rocBlas GEMM call for half
+rocblas_status gemm_call(rocblas_handle handle, rocblas_operation transa,
+                         rocblas_operation transb, rocblas_int m,
+                         rocblas_int n, rocblas_int k,
+                         const rocblas_half* alpha, const rocblas_half* a,
+                         int lda, const rocblas_half* b, int ldb,
+                         const rocblas_half* beta, rocblas_half* c, int ldc) {
+    return rocblas_hgemm(handle, transa, transb, m, n, k,
+                         alpha, a, lda, b, ldb, beta, c, ldc);
+}
+
+//! converts alpha/beta to GEMM scalar type
+void to_scalar(float val, float* out) {
+    *out = val;
+}
+
+//! converts alpha/beta to GEMM scalar type
+void to_scalar(float val, double* out) {
+    *out = val;
+}
+
+//! converts alpha/beta to GEMM scalar type
+void to_scalar(float val, rocblas_half* out) {
+    out->data = val;
+}
+
+//! fills matrix with random data
+void fill(float* data, rocblas_int size, uint64_t seed, uint32_t stream) {
+    rvs::random_fill(data, size, static_cast<float>(RANDOM_CT / RANDOM_DIV_CT),
+                     seed, stream);
+}
+
+//! fills matrix with random data
+void fill(double* data, rocblas_int size, uint64_t seed, uint32_t stream) {
+    rvs::random_fill(data, size, RANDOM_CT / RANDOM_DIV_CT, seed, stream);
+}
+
+//! fills matrix with random data
+void fill(rocblas_half* data, rocblas_int size, uint64_t seed,
+          uint32_t stream) {
+    // rocblas_half is a plain 16-bit word
+    rvs::random_fill_half(reinterpret_cast<uint16_t*>(data), size, seed,
+                          stream);
+}
+
+/**
+ * @class blas_engine
+ *
+ * @brief rvs_blas_engine for element type T
+ *
+ */
+template <typename T>
+class blas_engine : public rvs_blas_engine {
+ public:
+    blas_engine(rocblas_int _size_a, rocblas_int _size_b, rocblas_int _size_c)
+        : size_a(_size_a), size_b(_size_b), size_c(_size_c),
+          da(nullptr), db(nullptr), dc(nullptr),
+          ha(nullptr), hb(nullptr), hc(nullptr) {
+    }
+
+    ~blas_engine() {
+        if (da)
+            hipFree(da);
+        if (db)
+            hipFree(db);
+        if (dc)
+            hipFree(dc);
+
+        delete []ha;
+        delete []hb;
+        delete []hc;
+    }
+
+    size_t element_size(void) {
+        return sizeof(T);
+    }
+
+    bool allocate_host(void) {
+        try {
+            ha = new T[size_a];
+            hb = new T[size_b];
+            hc = new T[size_c];
+            return true;
+        } catch (std::bad_alloc&) {
+            return false;
+        }
+    }
+
+    bool allocate_gpu(void) {
+        if (hipMalloc(&da, size_a * sizeof(T)) != hipSuccess)
+            return false;
+        if (hipMalloc(&db, size_b * sizeof(T)) != hipSuccess)
+            return false;
+        if (hipMalloc(&dc, size_c * sizeof(T)) != hipSuccess)
+            return false;
+        return true;
+    }
+
+    void generate(uint64_t seed, uint32_t stream) {
+        fill(ha, size_a, seed, stream);
+        fill(hb, size_b, seed, stream + 1);
+        fill(hc, size_c, seed, stream + 2);
+    }
+
+    bool copy_to_gpu(void) {
+        if (hipMemcpy(da, ha, sizeof(T) * size_a, hipMemcpyHostToDevice)
+                != hipSuccess)
+            return false;
+        if (hipMemcpy(db, hb, sizeof(T) * size_b, hipMemcpyHostToDevice)
+                != hipSuccess)
+            return false;
+        if (hipMemcpy(dc, hc, sizeof(T) * size_c, hipMemcpyHostToDevice)
+                != hipSuccess)
+            return false;
+        return true;
+    }
+
+    bool gemm(rocblas_handle handle,
+              rocblas_operation transa, rocblas_operation transb,
+              rocblas_int m, rocblas_int n, rocblas_int k,
+              float alpha, float beta, int lda, int ldb, int ldc) {
+        T gemm_alpha, gemm_beta;
+        to_scalar(alpha, &gemm_alpha);
+        to_scalar(beta, &gemm_beta);
+        return gemm_call(handle, transa, transb, m, n, k,
+                         &gemm_alpha, da, lda, db, ldb,
+                         &gemm_beta, dc, ldc) == rocblas_status_success;
+    }
+
+ protected:
+    //! number of elements in A
+    rocblas_int size_a;
+    //! number of elements in B
+    rocblas_int size_b;
+    //! number of elements in C
+    rocblas_int size_c;
+    //! pointer to device (GPU) memory
+    T *da;
+    //! pointer to device (GPU) memory
+    T *db;
+    //! pointer to device (GPU) memory
+    T *dc;
+    //! pointer to host memory
+    T *ha;
+    //! pointer to host memory
+    T *hb;
+    //! pointer to host memory
+    T *hc;
+};
+
+}  // namespace
+
+/**
+ * @brief creates engine for the given GEMM operation type
+ * @param ops_type GEMM operation type (sgemm, dgemm or hgemm)
+ * @param _size_a number of elements in matrix A
+ * @param _size_b number of elements in matrix B
+ * @param _size_c number of elements in matrix C
+ * @return new engine, nullptr if ops type is not supported
+ */
+rvs_blas_engine* rvs_blas_engine::create(const std::string& ops_type,
+                                         rocblas_int _size_a,
+                                         rocblas_int _size_b,
+                                         rocblas_int _size_c) {
+    if (ops_type == "sgemm")
+        return new blas_engine<float>(_size_a, _size_b, _size_c);
+    if (ops_type == "dgemm")
+        return new blas_engine<double>(_size_a, _size_b, _size_c);
+    if (ops_type == "hgemm")
+        return new blas_engine<rocblas_half>(_size_a, _size_b, _size_c);
+    return nullptr;
+}
+
+/**
+ * @brief checks whether GEMM operation type is supported
+ * @param ops_type GEMM operation type
+ * @return true if supported, otherwise false
+ */
+bool rvs_blas_engine::is_supported(const std::string& ops_type) {
+    return ops_type == "sgemm" || ops_type == "dgemm" || ops_type == "hgemm";
+}
 
 /**
  * @brief class constructor
@@ -37,20 +243,29 @@
  * @param _m matrix size
  * @param _n matrix size
  * @param _k matrix size
+ * @param ops_type GEMM operation type (sgemm, dgemm or hgemm)
  */
 rvs_blas::rvs_blas(int _gpu_device_index, int _m, int _n, int _k, int transA, int transB, 
-                    float alpha , float beta, int lda, int ldb, int ldc) : gpu_device_index(_gpu_device_index),
+                    float alpha , float beta, int lda, int ldb, int ldc,
+                    std::string ops_type) : gpu_device_index(_gpu_device_index),
                              m(_m), n(_n), k(_k){
     is_handle_init = false;
+    is_event_init = false;
     is_error = false;
-    da = db = dc = NULL;
-    ha = hb = hc = nullptr;
+    inflight_depth = 0;
+    inflight_head = 0;
+    inflight_count = 0;
+    inflight_has_prev = false;
+    inflight_submitted = 0;
+    seed = time(NULL);
+    generation = 0;
 
     size_a = k * m;
     size_b = k * n;
     size_c = n * m;
 
-    if (alocate_host_matrix_mem()) {
+    engine.reset(rvs_blas_engine::create(ops_type, size_a, size_b, size_c));
+    if (engine && engine->allocate_host()) {
         if (!init_gpu_device())
             is_error = true;
     } else {
@@ -86,12 +301,19 @@ rvs_blas::rvs_blas(int _gpu_device_index, int _m, int _n, int _k, int transA, in
     }
 }
 
+
 /**
  * @brief class destructor
  */
 rvs_blas::~rvs_blas() {
-    release_host_matrix_mem();
-    release_gpu_matrix_mem();
+    release_inflight();
+    engine.reset();
+    if (is_event_init) {
+        hipEventDestroy(gemm_start);
+        hipEventDestroy(gemm_stop);
+    }
+    if (is_handle_init)
+        rocblas_destroy_handle(blas_handle);
 }
 
 /**
@@ -105,13 +327,23 @@ bool rvs_blas::init_gpu_device(void) {
         // cannot select the given GPU device
         return false;
     } else {
-        if (!allocate_gpu_matrix_mem())
+        if (!engine->allocate_gpu())
             return false;
         if (rocblas_create_handle(&blas_handle) == rocblas_status_success) {
             is_handle_init = true;
             if (rocblas_get_stream(blas_handle, &hip_stream)
                  != rocblas_status_success)
                 return false;
+            // blocking sync lets the waiting thread sleep
+            if (hipEventCreateWithFlags(&gemm_start, hipEventBlockingSync)
+                    != hipSuccess)
+                return false;
+            if (hipEventCreateWithFlags(&gemm_stop, hipEventBlockingSync)
+                    != hipSuccess) {
+                hipEventDestroy(gemm_start);
+                return false;
+            }
+            is_event_init = true;
         } else {
             return false;
         }
@@ -123,291 +355,264 @@ bool rvs_blas::init_gpu_device(void) {
  * @brief copy data matrix from host to gpu
  * @return true if everything went fine, otherwise false
  */
-bool rvs_blas::copy_data_to_gpu(std::string ops_type) {
-
-      if(ops_type == "sgemm") {
-
-            if (da) {
-                 if (hipMemcpy(da, ha, sizeof(float) * size_a, hipMemcpyHostToDevice)
-                                 != hipSuccess) {
-                      is_error = true;
-                      return false;
-                  }
-            }
-
-            if (db) {
-                if (hipMemcpy(db, hb, sizeof(float) * size_b, hipMemcpyHostToDevice)
-                                != hipSuccess) {
-                      is_error = true;
-                      return false;
-                  }
-            }
-
-            if (dc) {
-                  if (hipMemcpy(dc, hc, sizeof(float) * size_c, hipMemcpyHostToDevice)
-                          != hipSuccess) {
-                       is_error = true;
-                       return false;
-                  }
-             }
-      }
+bool rvs_blas::copy_data_to_gpu(void) {
+    if (is_error)
+        return false;
 
+    if (!engine->copy_to_gpu()) {
+        is_error = true;
+        return false;
+    }
 
-      if(ops_type == "dgemm") {
+    return true;
+}
 
-            if (ddbla) {
-                  if (hipMemcpy(ddbla, hdbla, sizeof(double) * size_a, hipMemcpyHostToDevice)
-                                     != hipSuccess) {
-                        is_error = true;
-                        return false;
-                  }
-            }
+/**
+ * @brief waits for the GPU to finish and gets time
+ * @return steady clock time in microseconds
+ */
+double rvs_blas::get_time_us(void)
+{
+    hipDeviceSynchronize();
+    return static_cast<double>(rvs::stopwatch::now_ns()) / rvs::NS_PER_US;
+};
 
-            if (ddblb) {
-                  if (hipMemcpy(ddblb, hdblb, sizeof(double) * size_b, hipMemcpyHostToDevice)
-                                    != hipSuccess) {
-                        is_error = true;
-                        return false;
-                  }
-            }
+/**
+ * @brief checks whether the matrix multiplication completed
+ * @return true if GPU finished with matrix multiplication, otherwise false
+ */
+bool rvs_blas::is_gemm_op_complete(void) {
+    if (is_error)
+        return true;  // avoid blocking the calling thread
+    if (hipStreamQuery(hip_stream) != hipSuccess)
+        return false;
+    return true;
+}
 
-            if (ddblc) {
-                  if (hipMemcpy(ddblc, hdblc, sizeof(double) * size_c, hipMemcpyHostToDevice)
-                                  != hipSuccess) {
-                       is_error = true;
-                       return false;
-                  }
-            }
+/**
+ * @brief waits (sleeping) for the GEMM queued by run_blass_gemm()
+ * @param gpu_ms [out] GEMM execution time on the GPU in milliseconds
+ * @return true if everything went fine, otherwise false
+ */
+bool rvs_blas::wait_gemm(double *gpu_ms) {
+    *gpu_ms = 0;
+    if (is_error)
+        return false;
 
-      }
+    float ms;
+    if (hipEventSynchronize(gemm_stop) != hipSuccess ||
+            hipEventElapsedTime(&ms, gemm_start, gemm_stop) != hipSuccess) {
+        is_error = true;
+        return false;
+    }
 
-      if(ops_type == "hgemm") {
+    *gpu_ms = ms;
+    return true;
+}
 
-            if (dhlfa) {
-                  if (hipMemcpy(dhlfa, hhlfa, sizeof(rocblas_half) * size_a, hipMemcpyHostToDevice)
-                                     != hipSuccess) {
-                        is_error = true;
-                        return false;
-                  }
-            }
+/**
+ * @brief prepares streams for keeping several GEMMs in flight
+ *
+ * Creates num_streams streams, each with its own rocBlas handle, and
+ * timing events for queue_depth GEMMs. All GEMMs share the same matrices.
+ *
+ * @param num_streams number of streams GEMMs are spread over
+ * @param queue_depth max number of GEMMs in flight
+ * @return true if everything went fine, otherwise false
+ */
+bool rvs_blas::init_inflight(int num_streams, int queue_depth) {
+    if (is_error)
+        return false;
 
-            if (dhlfb) {
-                  if (hipMemcpy(dhlfb, hhlfb, sizeof(rocblas_half) * size_b, hipMemcpyHostToDevice)
-                                    != hipSuccess) {
-                        is_error = true;
-                        return false;
-                  }
-            }
+    release_inflight();
+    if (num_streams < 1 || queue_depth < 1)
+        return false;
 
-            if (dhlfc) {
-                  if (hipMemcpy(dhlfc, hhlfc, sizeof(rocblas_half) * size_c, hipMemcpyHostToDevice)
-                                  != hipSuccess) {
-                       is_error = true;
-                       return false;
-                  }
-            }
+    for (int i = 0; i < num_streams; i++) {
+        hipStream_t stream;
+        if (hipStreamCreateWithFlags(&stream, hipStreamNonBlocking)
+                != hipSuccess)
+            return false;
+        inflight_streams.push_back(stream);
 
-      }
+        rocblas_handle handle;
+        if (rocblas_create_handle(&handle) != rocblas_status_success)
+            return false;
+        inflight_handles.push_back(handle);
+        if (rocblas_set_stream(handle, stream) != rocblas_status_success)
+            return false;
+    }
 
+    // one spare slot keeps events of the last retired GEMM valid
+    for (int i = 0; i <= queue_depth; i++) {
+        // blocking sync lets the waiting thread sleep
+        hipEvent_t event;
+        if (hipEventCreateWithFlags(&event, hipEventBlockingSync)
+                != hipSuccess)
+            return false;
+        inflight_start.push_back(event);
+        if (hipEventCreateWithFlags(&event, hipEventBlockingSync)
+                != hipSuccess)
+            return false;
+        inflight_stop.push_back(event);
+    }
+    inflight_depth = queue_depth;
 
-    is_error = false;
     return true;
 }
 
 /**
- * @brief allocates memory (for matrix multiplication) on the selected GPU
- * @return true if everything went fine, otherwise false
+ * @brief enqueues one more GEMM, keeping at most queue_depth in flight
+ *
+ * If the queue is full the calling thread sleeps until the oldest GEMM
+ * completes. GEMMs are spread over the streams round robin.
+ *
+ * @param completed [out] number of GEMMs that completed during the call
+ * @param gpu_ms [out] GPU busy time of completed GEMMs in milliseconds
+ * @return true if GPU was able to enqueue the GEMM operation, otherwise false
  */
-bool rvs_blas::allocate_gpu_matrix_mem(void) {
-    if (hipMalloc(&da, size_a * sizeof(float)) != hipSuccess)
-        return false;
-    if (hipMalloc(&db, size_b * sizeof(float)) != hipSuccess)
-        return false;
-    if (hipMalloc(&dc, size_c * sizeof(float)) != hipSuccess)
+bool rvs_blas::submit_gemm(uint64_t *completed, double *gpu_ms) {
+    *completed = 0;
+    *gpu_ms = 0;
+    if (is_error || inflight_depth == 0)
         return false;
 
-    if (hipMalloc(&ddbla, size_a * sizeof(double)) != hipSuccess)
-        return false;
-    if (hipMalloc(&ddblb, size_b * sizeof(double)) != hipSuccess)
-        return false;
-    if (hipMalloc(&ddblc, size_c * sizeof(double)) != hipSuccess)
-        return false;
+    if (inflight_count == inflight_depth) {
+        if (!retire_gemm(gpu_ms))
+            return false;
+        (*completed)++;
+    }
 
-    if (hipMalloc(&dhlfa, size_a * sizeof(rocblas_half)) != hipSuccess)
+    size_t s = inflight_submitted % inflight_streams.size();
+    size_t slot = (inflight_head + inflight_count) % inflight_stop.size();
+    if (hipEventRecord(inflight_start[slot], inflight_streams[s])
+            != hipSuccess) {
+        is_error = true;
         return false;
-    if (hipMalloc(&dhlfb, size_b * sizeof(rocblas_half)) != hipSuccess)
+    }
+
+    if (!engine->gemm(inflight_handles[s], transa, transb, m, n, k,
+                      blas_alpha_val, blas_beta_val,
+                      blas_lda_offset, blas_ldb_offset, blas_ldc_offset)) {
+        is_error = true;  // GPU cannot enqueue the gemm
         return false;
-    if (hipMalloc(&dhlfc, size_c * sizeof(rocblas_half)) != hipSuccess)
+    }
+
+    if (hipEventRecord(inflight_stop[slot], inflight_streams[s])
+            != hipSuccess) {
+        is_error = true;
         return false;
+    }
+    inflight_count++;
+    inflight_submitted++;
 
     return true;
 }
 
 /**
- * @brief gets time
- */
-double rvs_blas::get_time_us(void)
-{
-    hipDeviceSynchronize();
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (tv.tv_sec * 1000 * 1000) + tv.tv_usec;
-};
- 
-
-/**
- * @brief releases GPU mem & destroys the rocBlas handle
+ * @brief waits for all in-flight GEMMs to complete
+ * @param completed [out] number of GEMMs that completed during the call
+ * @param gpu_ms [out] GPU busy time of completed GEMMs in milliseconds
+ * @return true if everything went fine, otherwise false
  */
-void rvs_blas::release_gpu_matrix_mem(void) {
-    if (da)
-        hipFree(da);
-    if (db)
-        hipFree(db);
-    if (dc)
-        hipFree(dc);
-
-    if (ddbla)
-        hipFree(ddbla);
-    if (ddblb)
-        hipFree(ddblb);
-    if (ddblc)
-        hipFree(ddblc);
-
-    if (dhlfa)
-        hipFree(dhlfa);
-    if (dhlfb)
-        hipFree(dhlfb);
-    if (dhlfc)
-        hipFree(dhlfc);
-
-    if (is_handle_init)
-        rocblas_destroy_handle(blas_handle);
+bool rvs_blas::drain_gemms(uint64_t *completed, double *gpu_ms) {
+    *completed = 0;
+    *gpu_ms = 0;
+    while (inflight_count > 0) {
+        if (!retire_gemm(gpu_ms))
+            return false;
+        (*completed)++;
+    }
+    return true;
 }
 
 /**
- * @brief allocate host matrix memory
+ * @brief waits (sleeping) for the oldest in-flight GEMM to complete
+ *
+ * Adds the part of its execution that does not overlap the previously
+ * retired GEMM, so that GEMMs running concurrently on several streams
+ * count the time the GPU was busy only once.
+ *
+ * @param gpu_ms [in,out] GPU busy time in milliseconds
  * @return true if everything went fine, otherwise false
  */
-bool rvs_blas::alocate_host_matrix_mem(void) {
-
-    try {
-        ha = new float[size_a];
-        hb = new float[size_b];
-        hc = new float[size_c];
-
-        hdbla = new double[size_a];
-        hdblb = new double[size_b];
-        hdblc = new double[size_c];
-
-        hhlfa = new rocblas_half[size_a];
-        hhlfb = new rocblas_half[size_b];
-        hhlfc = new rocblas_half[size_c];
-
-        return true;
-    } catch (std::bad_alloc&) {
+bool rvs_blas::retire_gemm(double *gpu_ms) {
+    size_t slot = inflight_head;
+    size_t prev = (slot + inflight_stop.size() - 1) % inflight_stop.size();
+    float run_ms, gap_ms = 0, end_ms = 0;
+
+    if (hipEventSynchronize(inflight_stop[slot]) != hipSuccess ||
+            hipEventElapsedTime(&run_ms, inflight_start[slot],
+                                inflight_stop[slot]) != hipSuccess ||
+            (inflight_has_prev &&
+             (hipEventElapsedTime(&gap_ms, inflight_stop[prev],
+                                  inflight_start[slot]) != hipSuccess ||
+              hipEventElapsedTime(&end_ms, inflight_stop[prev],
+                                  inflight_stop[slot]) != hipSuccess))) {
+        is_error = true;
+        inflight_count = 0;
         return false;
     }
-}
 
-/**
- * @brief releases the host matrix memory
- */
-void rvs_blas::release_host_matrix_mem(void) {
-    if (ha)
-        delete []ha;
-    if (hb)
-        delete []hb;
-    if (hc)
-        delete []hc;
+    if (!inflight_has_prev || gap_ms >= 0)
+        *gpu_ms += run_ms;
+    else if (end_ms > 0)
+        *gpu_ms += end_ms;
 
-    if (hdbla)
-        delete []hdbla;
-    if (hdblb)
-        delete []hdblb;
-    if (hdblc)
-        delete []hdblc;
-
-    if (hhlfa)
-        delete []hhlfa;
-    if (hhlfb)
-        delete []hhlfb;
-    if (hhlfc)
-        delete []hhlfc;
+    inflight_head = (inflight_head + 1) % inflight_stop.size();
+    inflight_count--;
+    inflight_has_prev = true;
+    return true;
 }
 
 /**
- * @brief checks whether the matrix multiplication completed
- * @return true if GPU finished with matrix multiplication, otherwise false
+ * @brief waits for in-flight GEMMs and releases their streams and events
  */
-bool rvs_blas::is_gemm_op_complete(void) {
-    if (is_error)
-        return true;  // avoid blocking the calling thread
-    if (hipStreamQuery(hip_stream) != hipSuccess)
-        return false;
-    return true;
+void rvs_blas::release_inflight(void) {
+    for (hipStream_t stream : inflight_streams)
+        hipStreamSynchronize(stream);
+    for (hipEvent_t event : inflight_start)
+        hipEventDestroy(event);
+    for (hipEvent_t event : inflight_stop)
+        hipEventDestroy(event);
+    for (rocblas_handle handle : inflight_handles)
+        rocblas_destroy_handle(handle);
+    for (hipStream_t stream : inflight_streams)
+        hipStreamDestroy(stream);
+
+    inflight_start.clear();
+    inflight_stop.clear();
+    inflight_handles.clear();
+    inflight_streams.clear();
+    inflight_depth = 0;
+    inflight_head = 0;
+    inflight_count = 0;
+    inflight_has_prev = false;
+    inflight_submitted = 0;
 }
 
 /**
- * @brief performs the SGEMM matrix multiplication
+ * @brief performs the GEMM matrix multiplication
  * @return true if GPU was able to enqueue the GEMM operation, otherwise false
  */
-bool rvs_blas::run_blass_gemm(std::string ops_type) {
-
-    if (!is_error) {
-      
-        if(ops_type == "sgemm") {
-
-                 float alpha = blas_alpha_val, beta = blas_beta_val;
-                 
-                 if (rocblas_sgemm(blas_handle, transa, transb,
-                         rvs_blas::m, rvs_blas::n, rvs_blas::k,
-                         &alpha, da, blas_lda_offset,
-                         db, blas_ldb_offset, &beta,
-                         dc, blas_ldc_offset) != rocblas_status_success) {
-                 is_error = true;  // GPU cannot enqueue the gemm
-                 return false;
-                 } else {
-                      return true;
-                 }
-        }
+bool rvs_blas::run_blass_gemm(void) {
+    if (is_error)
+        return false;
 
-       if(ops_type == "dgemm") {
-
-                  double alpha = blas_alpha_val, beta = blas_beta_val;
-
-                  if (rocblas_dgemm(blas_handle, transa, transb,
-                          rvs_blas::m, rvs_blas::n, rvs_blas::k,
-                          &alpha, ddbla, blas_lda_offset,
-                          ddblb, blas_ldb_offset, &beta,
-                          ddblc, blas_ldc_offset) != rocblas_status_success) {
-                  is_error = true;  // GPU cannot enqueue the gemm
-                  return false;
-                  } else {
-                       return true;
-                  }
-       }
-
-      if(ops_type == "hgemm") {
-                  rocblas_half alpha;
-                  rocblas_half beta;
-
-                  alpha.data = blas_alpha_val;
-                  beta.data = blas_beta_val;
-
-                  if (rocblas_hgemm(blas_handle, transa, transb,
-                          rvs_blas::m, rvs_blas::n, rvs_blas::k,
-                          &alpha, dhlfa, blas_lda_offset,
-                          dhlfb, blas_ldb_offset, &beta,
-                          dhlfc, blas_ldc_offset) != rocblas_status_success) {
-                  is_error = true;  // GPU cannot enqueue the gemm
-                  return false;
-                  } else {
-                       return true;
-                  }
-       }
+    if (hipEventRecord(gemm_start, hip_stream) != hipSuccess) {
+        is_error = true;
+        return false;
+    }
 
+    if (!engine->gemm(blas_handle, transa, transb, m, n, k,
+                      blas_alpha_val, blas_beta_val,
+                      blas_lda_offset, blas_ldb_offset, blas_ldc_offset)) {
+        is_error = true;  // GPU cannot enqueue the gemm
+        return false;
+    }
 
-    } else {
+    if (hipEventRecord(gemm_stop, hip_stream) != hipSuccess) {
+        is_error = true;
         return false;
     }
 
@@ -417,52 +622,22 @@ bool rvs_blas::run_blass_gemm(std::string ops_type) {
 /**
  * @brief generate matrix random data
  * it should be called before rocBlas GEMM
+ *
+ * Every call produces new data, the whole sequence is reproducible from
+ * the seed.
  */
 void rvs_blas::generate_random_matrix_data(void) {
-    int i;
-    if (!is_error) {
-        uint64_t nextr = time(NULL);
-
-        //SGEMM stuff
-        for (i = 0; i < size_a; ++i)
-            ha[i] = fast_pseudo_rand(&nextr);
-
-        for (i = 0; i < size_b; ++i)
-            hb[i] = fast_pseudo_rand(&nextr);
-
-        for (int i = 0; i < size_c; ++i)
-            hc[i] = fast_pseudo_rand(&nextr);
-
-        //DGEMM stuff
-        for (i = 0; i < size_a; ++i)
-            hdbla[i] = (double)fast_pseudo_rand(&nextr);
-
-        for (i = 0; i < size_b; ++i)
-            hdblb[i] = (double)fast_pseudo_rand(&nextr);
-
-        for (int i = 0; i < size_c; ++i)
-            hdblc[i] = (double)fast_pseudo_rand(&nextr);
-
-        for (i = 0; i < size_a; ++i)
-            hhlfa[i].data = (uint16_t)fast_pseudo_rand(&nextr);
-
-        for (i = 0; i < size_b; ++i)
-            hhlfb[i].data = (uint16_t)fast_pseudo_rand(&nextr);
+    if (is_error)
+        return;
 
-        for (int i = 0; i < size_c; ++i)
-            hhlfc[i].data = (uint16_t)fast_pseudo_rand(&nextr);
-    }
+    engine->generate(seed, 3 * generation++);
 }
 
-
-
 /**
- * @brief fast pseudo random generator 
- * @return floating point random number
+ * @brief set seed for matrix data generation
+ * @param _seed random seed
  */
-float rvs_blas::fast_pseudo_rand(u_long *nextr) {
-    *nextr = *nextr * 1103515245 + 12345;
-    return static_cast<float>(static_cast<uint32_t>
-                    ((*nextr / 65536) % RANDOM_CT)) / RANDOM_DIV_CT;
+void rvs_blas::set_seed(uint64_t _seed) {
+    seed = _seed;
+    generation = 0;
 }
-
@@ -0,0 +1,244 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvshistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "include/rvsstopwatch.h"
+
+const uint32_t rvs::latency_histogram::SUB_BITS;
+const uint32_t rvs::latency_histogram::MAX_BITS;
+const size_t rvs::latency_histogram::BUCKETS;
+
+/**
+ * @brief Set all counts to zero
+ *
+ * Must not be called while values are being recorded.
+ *
+ * */
+void rvs::latency_histogram::reset() {
+  for (size_t i = 0; i < BUCKETS; i++) {
+    counts[i].store(0, std::memory_order_relaxed);
+  }
+  num.store(0, std::memory_order_relaxed);
+  sum.store(0, std::memory_order_relaxed);
+  lowest.store(0, std::memory_order_relaxed);
+  highest.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Index of bucket holding given value
+ *
+ * @param Ns value (ns)
+ * @return bucket index
+ *
+ * */
+size_t rvs::latency_histogram::bucket(uint64_t Ns) {
+  const uint64_t half = 1ull << (SUB_BITS - 1);
+  if (Ns < (1ull << SUB_BITS))
+    return Ns;
+  if (Ns >= (1ull << MAX_BITS))
+    Ns = (1ull << MAX_BITS) - 1;
+
+  uint32_t shift = 63 - __builtin_clzll(Ns) - (SUB_BITS - 1);
+  return (1u << SUB_BITS) + (shift - 1) * half + ((Ns >> shift) - half);
+}
+
+/**
+ * @brief Largest value falling into given bucket
+ *
+ * @param Ix bucket index
+ * @return value (ns)
+ *
+ * */
+uint64_t rvs::latency_histogram::bucket_high(size_t Ix) {
+  const uint64_t half = 1ull << (SUB_BITS - 1);
+  if (Ix < (1u << SUB_BITS))
+    return Ix;
+
+  Ix -= 1u << SUB_BITS;
+  uint32_t shift = Ix / half + 1;
+  uint64_t low = (Ix % half + half) << shift;
+  return low + (1ull << shift) - 1;
+}
+
+/**
+ * @brief Record one value (single writer)
+ *
+ * @param Ns value (ns)
+ *
+ * */
+void rvs::latency_histogram::record(uint64_t Ns) {
+  // only one thread writes so plain load/store is enough and
+  // avoids locked read-modify-write instructions
+  std::atomic<uint32_t>& c = counts[bucket(Ns)];
+  c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+  uint64_t n = num.load(std::memory_order_relaxed);
+  if (n == 0 || Ns < lowest.load(std::memory_order_relaxed))
+    lowest.store(Ns, std::memory_order_relaxed);
+  if (Ns > highest.load(std::memory_order_relaxed))
+    highest.store(Ns, std::memory_order_relaxed);
+  sum.store(sum.load(std::memory_order_relaxed) + Ns,
+            std::memory_order_relaxed);
+  num.store(n + 1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Add values recorded in another histogram to this one
+ *
+ * This histogram must not be recorded into at the same time.
+ *
+ * @param Src source histogram
+ *
+ * */
+void rvs::latency_histogram::merge(const latency_histogram& Src) {
+  uint64_t n = Src.count();
+  if (n == 0)
+    return;
+
+  for (size_t i = 0; i < BUCKETS; i++) {
+    uint32_t c = Src.counts[i].load(std::memory_order_relaxed);
+    if (c) {
+      counts[i].store(counts[i].load(std::memory_order_relaxed) + c,
+                      std::memory_order_relaxed);
+    }
+  }
+
+  if (count() == 0 || Src.min() < min())
+    lowest.store(Src.min(), std::memory_order_relaxed);
+  if (Src.max() > max())
+    highest.store(Src.max(), std::memory_order_relaxed);
+  sum.store(sum.load(std::memory_order_relaxed) +
+            Src.sum.load(std::memory_order_relaxed),
+            std::memory_order_relaxed);
+  num.store(count() + n, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Average of recorded values
+ *
+ * @return average (ns), 0 if none
+ *
+ * */
+double rvs::latency_histogram::mean() const {
+  uint64_t n = count();
+  return n ? static_cast<double>(sum.load(std::memory_order_relaxed)) / n : 0;
+}
+
+/**
+ * @brief Value below which given percentage of recorded values falls
+ *
+ * Returned value is the upper bound of the bucket reaching the percentile,
+ * capped at the largest recorded value.
+ *
+ * @param Pct percentile (0-100)
+ * @return value (ns), 0 if none recorded
+ *
+ * */
+uint64_t rvs::latency_histogram::percentile(double Pct) const {
+  // take a copy so that concurrent recording does not skew the count
+  std::vector<uint32_t> snap(BUCKETS);
+  uint64_t n = 0;
+  for (size_t i = 0; i < BUCKETS; i++) {
+    snap[i] = counts[i].load(std::memory_order_relaxed);
+    n += snap[i];
+  }
+  if (n == 0)
+    return 0;
+
+  Pct = std::min(std::max(Pct, 0.0), 100.0);
+  uint64_t rank = std::max<uint64_t>(
+    static_cast<uint64_t>(std::ceil(Pct / 100 * n)), 1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < BUCKETS; i++) {
+    seen += snap[i];
+    if (seen >= rank)
+      return std::min(bucket_high(i), max());
+  }
+  return max();
+}
+
+/**
+ * @brief Create one histogram per block size
+ *
+ * Must be called before transfers start.
+ *
+ * @param Sizes list of block sizes (bytes)
+ *
+ * */
+void rvs::latency_recorder::init(const std::vector<uint32_t>& Sizes) {
+  sizes.assign(Sizes.begin(), Sizes.end());
+  std::sort(sizes.begin(), sizes.end());
+  sizes.erase(std::unique(sizes.begin(), sizes.end()), sizes.end());
+
+  hist.clear();
+  for (size_t i = 0; i < sizes.size(); i++) {
+    hist.emplace_back(new latency_histogram);
+  }
+}
+
+/**
+ * @brief Histogram recording given block size
+ *
+ * @param Size block size (bytes)
+ * @return histogram of the largest block size not above Size, nullptr if
+ * Size is below all block sizes
+ *
+ * */
+rvs::latency_histogram* rvs::latency_recorder::find(uint64_t Size) {
+  auto it = std::upper_bound(sizes.begin(), sizes.end(), Size);
+  if (it == sizes.begin())
+    return nullptr;
+  return hist[it - sizes.begin() - 1].get();
+}
+
+/**
+ * @brief Record completed transfer (transfer_sink interface)
+ *
+ * @param Size block size (bytes)
+ * @param Duration transfer time (sec)
+ *
+ * */
+void rvs::latency_recorder::record(uint64_t Size, double Duration) {
+  latency_histogram* h = find(Size);
+  if (h && Duration >= 0) {
+    h->record(static_cast<uint64_t>(std::llround(Duration * NS_PER_SEC)));
+  }
+}
+
+/**
+ * @brief Merge histograms of all block sizes into given histogram
+ *
+ * @param pDst destination histogram
+ *
+ * */
+void rvs::latency_recorder::merge(latency_histogram* pDst) const {
+  for (size_t i = 0; i < hist.size(); i++) {
+    pDst->merge(*hist[i]);
+  }
+}
@@ -30,12 +30,15 @@
 #include <iostream>
 #include <algorithm>
 #include <cstring>
+#include <fstream>
+#include <sstream>
 #include <string>
 #include <vector>
 
 #include "hsa/hsa.h"
 #include "hsa/hsa_ext_amd.h"
 
+#include "include/gpu_util.h"
 #include "include/rvs_util.h"
 #include "include/rvsloglp.h"
 
@@ -44,6 +47,59 @@ extern void gpu_get_all_gpu_id(std::vector<uint16_t>* pgpus_id);
 rvs::hsa* rvs::hsa::pDsc;
 const uint32_t rvs::hsa::NO_CONN;
 
+namespace {
+
+//! topology file tag
+const char kTopologyTag[] = "rvstopology";
+//! topology file format version
+const int kTopologyVersion = 2;
+
+/**
+ * @brief Read link properties of all KFD topology nodes
+ *
+ * Link information reported by HSA is derived from these so any change
+ * in them makes saved topology stale.
+ *
+ * @return concatenated contents of link properties files
+ *
+ * */
+std::string kfd_links() {
+  std::string text;
+  for (int node = 0; ; node++) {
+    std::string dir = std::string(KFD_SYS_PATH_NODES) + "/"
+                    + std::to_string(node);
+    std::ifstream props(dir + "/properties");
+    if (!props.good()) {
+      break;
+    }
+    for (const char* kind : {"io_links", "p2p_links"}) {
+      for (int link = 0; ; link++) {
+        std::ifstream fs(dir + "/" + kind + "/" + std::to_string(link)
+                         + "/properties");
+        if (!fs.good()) {
+          break;
+        }
+        std::stringstream ss;
+        ss << fs.rdbuf();
+        text += ss.str();
+      }
+    }
+  }
+  return text;
+}
+
+//! 64-bit FNV-1a hash
+uint64_t fnv1a(const std::string& Text) {
+  uint64_t h = 14695981039346656037ull;
+  for (unsigned char c : Text) {
+    h ^= c;
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+}  // namespace
+
 /**
  * @brief Initialize RVS HSA wrapper
  *
@@ -78,10 +134,29 @@ rvs::hsa* rvs::hsa::Get() {
 
 //! Default constructor
 rvs::hsa::hsa() {
+  waiter = nullptr;
 }
 
 //! Default destructor
 rvs::hsa::~hsa() {
+  delete waiter;
+  ReleaseTrafficCache();
+}
+
+/**
+ * @brief Fetch copy completion engine
+ *
+ * Waiter threads are started on the first call.
+ *
+ * @return pointer to completion engine shared by all transfers
+ *
+ * */
+rvs::hsa_waiter* rvs::hsa::Waiter() {
+  std::lock_guard<std::mutex> lk(waiter_mutex);
+  if (waiter == nullptr) {
+    waiter = new rvs::hsa_waiter();
+  }
+  return waiter;
 }
 
 
@@ -320,6 +395,8 @@ void rvs::hsa::InitAgents() {
       print_hsa_status(__FILE__, __LINE__, __func__,
                      "hsa_amd_agent_iterate_memory_pools()", status);
 
+    node_index[agent_list[i].node] = i;
+
     // separate the lists
     if (agent_list[i].agent_device_type == "CPU") {
       cpu_list.push_back(agent_list[i]);
@@ -342,9 +419,224 @@ void rvs::hsa::InitAgents() {
 
   std::sort(size_list.begin(), size_list.end());
 
+  InitTopology();
+
   PrintTopology();
 }
 
+/**
+ * @brief Fill in link information for all pairs of agents
+ *
+ * If RVS_TOPOLOGY_FILE environment variable is set and names a file saved
+ * on a system with the same agents and KFD links, link information is
+ * loaded from it. Otherwise HSA is queried and the result is saved into
+ * the file.
+ *
+ * @return void
+ *
+ * */
+void rvs::hsa::InitTopology() {
+  const char* file = getenv("RVS_TOPOLOGY_FILE");
+  if (file != nullptr && LoadTopology(file) == 0) {
+    rvs::lp::Log(string("[RVSHSA] reusing topology saved in ") + file,
+                 rvs::loginfo);
+    return;
+  }
+
+  size_t n = agent_list.size();
+  topology.assign(n * n, NoConnection());
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      RVSHSATRACE_
+      TopologyEntry& entry = topology[i * n + j];
+      if (QueryLinkInfo(i, j, &entry.distance, &entry.hops)) {
+        entry.distance = NO_CONN;
+        entry.hops.clear();
+      }
+      entry.peer_status = GetPeerStatusAgent(agent_list[i], agent_list[j]);
+    }
+  }
+
+  if (file != nullptr && SaveTopology(file) == 0) {
+    rvs::lp::Log(string("[RVSHSA] topology saved to ") + file,
+                 rvs::logdebug);
+  }
+}
+
+/**
+ * @brief Fetch link information between two agents
+ *
+ * @param SrcNode source NUMA node
+ * @param DstNode destination NUMA node
+ * @return pointer to link information, nullptr if node not found
+ *
+ * */
+const rvs::hsa::TopologyEntry* rvs::hsa::GetTopology(uint32_t SrcNode,
+                                                     uint32_t DstNode) {
+  int srcix = FindAgent(SrcNode);
+  int dstix = FindAgent(DstNode);
+  if (srcix < 0 || dstix < 0 || topology.empty()) {
+    RVSHSATRACE_
+    return nullptr;
+  }
+
+  return &topology[srcix * agent_list.size() + dstix];
+}
+
+/**
+ * @brief Link information of agents which are not connected
+ *
+ * @return entry with NO_CONN distance and no access
+ *
+ * */
+rvs::hsa::TopologyEntry rvs::hsa::NoConnection() {
+  TopologyEntry entry;
+  entry.distance = NO_CONN;
+  entry.peer_status = 0;
+  return entry;
+}
+
+/**
+ * @brief Hash of inputs to link information query
+ *
+ * Covers the list of agents and KFD link properties from which HSA
+ * derives link types and distances.
+ *
+ * @return hash value
+ *
+ * */
+uint64_t rvs::hsa::TopologyHash() {
+  std::string key;
+  for (const auto& agent : agent_list) {
+    key += std::to_string(agent.node) + " " + agent.agent_device_type + " "
+         + agent.agent_name + "\n";
+  }
+  key += kfd_links();
+  return fnv1a(key);
+}
+
+/**
+ * @brief Save link information for all pairs of agents
+ *
+ * File starts with format version and hash of the inputs to link query
+ * (see TopologyHash()) followed by the list of agents. Each following
+ * line describes one pair: source node, destination node, distance, peer
+ * status and hops as (type, distance) pairs.
+ *
+ * @param File file name
+ * @return 0 - OK, non-zero otherwise
+ *
+ * */
+int rvs::hsa::SaveTopology(const std::string& File) {
+  std::ofstream fs(File);
+  if (!fs.good()) {
+    rvs::lp::Log("[RVSHSA] could not open topology file " + File,
+                 rvs::logerror);
+    return -1;
+  }
+
+  size_t n = agent_list.size();
+  fs << kTopologyTag << " " << kTopologyVersion << " " << std::hex
+     << TopologyHash() << std::dec << "\n";
+  fs << "agents " << n << "\n";
+  for (size_t i = 0; i < n; i++) {
+    fs << agent_list[i].node << " " << agent_list[i].agent_device_type
+       << " " << agent_list[i].agent_name << "\n";
+  }
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < n; j++) {
+      const TopologyEntry& entry = topology[i * n + j];
+      fs << agent_list[i].node << " " << agent_list[j].node << " "
+         << entry.distance << " " << entry.peer_status << " "
+         << entry.hops.size();
+      for (const auto& hop : entry.hops) {
+        fs << " " << static_cast<int>(hop.etype) << " " << hop.distance;
+      }
+      fs << "\n";
+    }
+  }
+
+  return fs.good() ? 0 : -1;
+}
+
+/**
+ * @brief Load link information for all pairs of agents
+ *
+ * Pairs missing from the file are left unconnected.
+ *
+ * @param File file name as written by SaveTopology()
+ * @return 0 - OK, non-zero if file is missing, malformed, of different
+ * version or saved on a system with different agents or links
+ *
+ * */
+int rvs::hsa::LoadTopology(const std::string& File) {
+  std::ifstream fs(File);
+  if (!fs.good()) {
+    return -1;
+  }
+
+  string tag;
+  int version = 0;
+  uint64_t hash = 0;
+  fs >> tag >> version >> std::hex >> hash >> std::dec;
+  if (!fs || tag != kTopologyTag || version != kTopologyVersion ||
+      hash != TopologyHash()) {
+    RVSHSATRACE_
+    rvs::lp::Log("[RVSHSA] topology in " + File + " is out of date",
+                 rvs::loginfo);
+    return -1;
+  }
+
+  size_t n = 0;
+  fs >> tag >> n;
+  if (tag != "agents" || n != agent_list.size()) {
+    RVSHSATRACE_
+    return -1;
+  }
+  for (size_t i = 0; i < n; i++) {
+    uint32_t node;
+    string type;
+    string name;
+    fs >> node >> type >> std::ws;
+    std::getline(fs, name);
+    if (!fs || node != agent_list[i].node ||
+        type != agent_list[i].agent_device_type ||
+        name != agent_list[i].agent_name) {
+      RVSHSATRACE_
+      return -1;
+    }
+  }
+
+  vector<TopologyEntry> loaded(n * n, NoConnection());
+  for (size_t k = 0; k < n * n; k++) {
+    uint32_t src;
+    uint32_t dst;
+    size_t hops = 0;
+    TopologyEntry entry;
+    fs >> src >> dst >> entry.distance >> entry.peer_status >> hops;
+    if (!fs || FindAgent(src) < 0 || FindAgent(dst) < 0 || hops > n) {
+      RVSHSATRACE_
+      return -1;
+    }
+    for (size_t h = 0; h < hops; h++) {
+      int etype;
+      linkinfo_t hop;
+      fs >> etype >> hop.distance;
+      hop.etype = static_cast<hsa_amd_link_info_type_t>(etype);
+      hop.strtype = LinkTypeName(hop.etype);
+      entry.hops.push_back(hop);
+    }
+    if (!fs) {
+      RVSHSATRACE_
+      return -1;
+    }
+    loaded[FindAgent(src) * n + FindAgent(dst)] = entry;
+  }
+
+  topology.swap(loaded);
+  return 0;
+}
+
 /**
  * @brief Process individual hsa_agent
  *
@@ -522,10 +814,9 @@ hsa_status_t rvs::hsa::ProcessMemPool(hsa_amd_memory_pool_t pool, void* data) {
  *
  * */
 int rvs::hsa::FindAgent(const uint32_t Node) {
-  for (size_t i = 0; i < agent_list.size(); i++) {
-    if (agent_list[i].node == Node)
-      return i;
-  }
+  auto it = node_index.find(Node);
+  if (it != node_index.end())
+    return it->second;
   RVSHSATRACE_
   return -1;
 }
@@ -723,37 +1014,262 @@ int rvs::hsa::Allocate(int SrcAgent, int DstAgent, size_t Size,
 }
 
 /**
- * @brief Allocate buffers in source and destination memory pools
+ * @brief Get transfer buffers for the given pair of agents
+ *
+ * Takes idle buffers from the cache if large enough. Otherwise allocates
+ * new buffers and signal. If allocation fails, all idle cached buffers are
+ * freed and allocation is attempted once more.
+ *
+ * @param SrcAgent source agent index in agent_list vector
+ * @param DstAgent destination agent index in agent_list vector
+ * @param Size minimum size of buffers
+ * @return buffers to be returned through ReleaseTraffic(), nullptr on error
+ *
+ * */
+rvs::hsa::TrafficBuffers* rvs::hsa::AcquireTraffic(int SrcAgent, int DstAgent,
+                                                    size_t Size) {
+  hsa_status_t status;
+  TrafficBuffers* p = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lk(traffic_mutex);
+    auto range = traffic_cache.equal_range(std::make_pair(SrcAgent, DstAgent));
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second->capacity >= Size) {
+        p = it->second;
+        traffic_cache.erase(it);
+        RVSHSATRACE_
+        return p;
+      }
+    }
+    // too small, will be replaced with a larger one
+    if (range.first != range.second) {
+      p = range.first->second;
+      traffic_cache.erase(range.first);
+    }
+  }
+
+  if (p) {
+    RVSHSATRACE_
+    FreeTraffic(p);
+  }
+
+  p = new TrafficBuffers;
+  p->src_ix = SrcAgent;
+  p->dst_ix = DstAgent;
+  p->capacity = Size;
+  p->src_ptr = nullptr;
+  p->dst_ptr = nullptr;
+
+  // allocate buffers and grant permissions
+  if (Allocate(SrcAgent, DstAgent, Size,
+               &p->src_pool, &p->src_ptr, &p->dst_pool, &p->dst_ptr)) {
+    RVSHSATRACE_
+    // memory might be held by cached buffers of other agent pairs
+    ReleaseTrafficCache();
+    if (Allocate(SrcAgent, DstAgent, Size,
+                 &p->src_pool, &p->src_ptr, &p->dst_pool, &p->dst_ptr)) {
+      RVSHSATRACE_
+      delete p;
+      return nullptr;
+    }
+  }
+
+  // Create a signal to wait on copy operation
+  if (HSA_STATUS_SUCCESS !=
+     (status = hsa_signal_create(1, 0, NULL, &p->signal))) {
+    print_hsa_status(__FILE__, __LINE__, __func__,
+              "hsa_signal_create()",
+              status);
+    hsa_amd_memory_pool_free(p->src_ptr);
+    hsa_amd_memory_pool_free(p->dst_ptr);
+    delete p;
+    RVSHSATRACE_
+    return nullptr;
+  }
+
+  RVSHSATRACE_
+  return p;
+}
+
+/**
+ * @brief Return transfer buffers into the cache
+ *
+ * @param pBuffers buffers obtained through AcquireTraffic()
+ *
+ * */
+void rvs::hsa::ReleaseTraffic(TrafficBuffers* pBuffers) {
+  if (pBuffers == nullptr)
+    return;
+
+  std::lock_guard<std::mutex> lk(traffic_mutex);
+  traffic_cache.insert(std::make_pair(
+    std::make_pair(pBuffers->src_ix, pBuffers->dst_ix), pBuffers));
+}
+
+/**
+ * @brief Free transfer buffers and signal
+ *
+ * @param pBuffers buffers obtained through AcquireTraffic()
+ *
+ * */
+void rvs::hsa::FreeTraffic(TrafficBuffers* pBuffers) {
+  hsa_amd_memory_pool_free(pBuffers->src_ptr);
+  hsa_amd_memory_pool_free(pBuffers->dst_ptr);
+  hsa_signal_destroy(pBuffers->signal);
+  for (auto it = pBuffers->pipe_signals.begin();
+       it != pBuffers->pipe_signals.end(); ++it) {
+    hsa_signal_destroy(*it);
+  }
+  delete pBuffers;
+}
+
+/**
+ * @brief Make sure there is a signal for each copy in flight
+ *
+ * Signals are kept with the buffers so they are created only once.
+ *
+ * @param pBuffers transfer buffers
+ * @param Depth max number of copies in flight
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int rvs::hsa::PipeSignals(TrafficBuffers* pBuffers, uint32_t Depth) {
+  hsa_status_t status;
+
+  while (pBuffers->pipe_signals.size() < Depth) {
+    hsa_signal_t signal;
+    if (HSA_STATUS_SUCCESS !=
+       (status = hsa_signal_create(1, 0, NULL, &signal))) {
+      print_hsa_status(__FILE__, __LINE__, __func__,
+                "hsa_signal_create()",
+                status);
+      return -1;
+    }
+    pBuffers->pipe_signals.push_back(signal);
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Initiate asynchronous copy between transfer buffers
+ *
+ * @param pBuffers transfer buffers
+ * @param Size size of data to transfer
+ * @param Signal signal decremented on copy completion
+ * @param pDep if not nullptr, signal of the copy this one has to wait for
+ * @return HSA status
+ *
+ * */
+hsa_status_t rvs::hsa::StartCopy(TrafficBuffers* pBuffers, size_t Size,
+                                 hsa_signal_t Signal,
+                                 const hsa_signal_t* pDep) {
+  hsa_status_t status;
+
+  hsa_signal_store_relaxed(Signal, 1);
+  if (HSA_STATUS_SUCCESS !=
+     (status = hsa_amd_memory_async_copy(
+                pBuffers->dst_ptr, agent_list[pBuffers->dst_ix].agent,
+                pBuffers->src_ptr, agent_list[pBuffers->src_ix].agent,
+                Size,
+                pDep ? 1 : 0, pDep, Signal)))
+    print_hsa_status(__FILE__, __LINE__, __func__,
+              "hsa_amd_memory_async_copy()",
+              status);
+
+  return status;
+}
+
+/**
+ * @brief Free all idle transfer buffers
+ *
+ * Should be called at the end of an action once all its transfers are done.
+ *
+ * */
+void rvs::hsa::ReleaseTrafficCache() {
+  std::multimap<std::pair<int, int>, TrafficBuffers*> idle;
+  {
+    std::lock_guard<std::mutex> lk(traffic_mutex);
+    idle.swap(traffic_cache);
+  }
+
+  RVSHSATRACE_
+  for (auto it = idle.begin(); it != idle.end(); ++it) {
+    FreeTraffic(it->second);
+  }
+}
+
+/**
+ * @brief Pre-allocate transfer buffers
+ *
+ * Allocates buffers large enough for all transfers of a block size sweep
+ * so that the sweep itself does not allocate memory.
+ *
+ * @param SrcNode source NUMA node
+ * @param DstNode destination NUMA node
+ * @param MaxSize largest transfer size
+ * @param bidirectional 'true' for bidirectional transfer
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int rvs::hsa::ReserveTraffic(uint32_t SrcNode, uint32_t DstNode,
+                             size_t MaxSize, bool bidirectional) {
+  int src_ix = FindAgent(SrcNode);
+  int dst_ix = FindAgent(DstNode);
+  if (src_ix < 0 || dst_ix < 0) {
+    RVSHSATRACE_
+    return -1;
+  }
+
+  TrafficBuffers* fwd = AcquireTraffic(src_ix, dst_ix, MaxSize);
+  if (fwd == nullptr) {
+    RVSHSATRACE_
+    return -1;
+  }
+
+  TrafficBuffers* rev = nullptr;
+  if (bidirectional) {
+    rev = AcquireTraffic(dst_ix, src_ix, MaxSize);
+  }
+
+  ReleaseTraffic(fwd);
+  ReleaseTraffic(rev);
+
+  return (bidirectional && rev == nullptr) ? -1 : 0;
+}
+
+/**
+ * @brief Transfer data between two NUMA nodes
+ *
+ * Buffers and signals are taken from the transfer cache (see
+ * AcquireTraffic()) so that only the copy itself takes place here.
  *
  * @param SrcNode source NUMA node
  * @param DstNode destination NUMA node
  * @param Size size of data to transfer
  * @param bidirectional 'true' for bidirectional transfer
  * @param Duration [out] duration of transfer in seconds
+ * @param WaitState how to wait for copy completion; spinning reacts sooner,
+ * blocking leaves the CPU to other threads. Duration is taken from copy
+ * timestamps either way.
  * @return 0 - if successfull, non-zero otherwise
  *
  * */
 int rvs::hsa::SendTraffic(uint32_t SrcNode, uint32_t DstNode,
                               size_t Size, bool bidirectional,
-                              double* Duration) {
+                              double* Duration, hsa_wait_state_t WaitState) {
   hsa_status_t status;
-  int sts;
 
   int32_t src_ix_fwd;
   int32_t dst_ix_fwd;
-  hsa_amd_memory_pool_t src_pool_fwd;
-  hsa_amd_memory_pool_t dst_pool_fwd;
-  void* src_ptr_fwd = nullptr;
-  void* dst_ptr_fwd = nullptr;
+  TrafficBuffers* fwd;
   hsa_signal_t signal_fwd;
 
   int32_t src_ix_rev;
   int32_t dst_ix_rev;
-  hsa_amd_memory_pool_t src_pool_rev;
-  hsa_amd_memory_pool_t dst_pool_rev;
-  void* src_ptr_rev = nullptr;
-  void* dst_ptr_rev = nullptr;
-  hsa_signal_t signal_rev;
+  TrafficBuffers* rev = nullptr;
+  hsa_signal_t signal_rev = {0};
 
   RVSHSATRACE_
 
@@ -763,68 +1279,38 @@ int rvs::hsa::SendTraffic(uint32_t SrcNode, uint32_t DstNode,
   src_ix_rev = dst_ix_fwd;
   dst_ix_rev = src_ix_fwd;
 
-    if (src_ix_fwd < 0 || dst_ix_fwd < 0) {
+  if (src_ix_fwd < 0 || dst_ix_fwd < 0) {
     RVSHSATRACE_
     return -1;
   }
 
-  // allocate buffers and grant permissions for forward transfer
-  sts = Allocate(src_ix_fwd, dst_ix_fwd, Size,
-           &src_pool_fwd, &src_ptr_fwd,
-           &dst_pool_fwd, &dst_ptr_fwd);
-  if (sts) {
+  // get buffers and signal for forward transfer
+  fwd = AcquireTraffic(src_ix_fwd, dst_ix_fwd, Size);
+  if (fwd == nullptr) {
     RVSHSATRACE_
     return -1;
   }
-
-  // Create a signal to wait on copy operation
-  if (HSA_STATUS_SUCCESS !=
-     (status = hsa_signal_create(1, 0, NULL, &signal_fwd))) {
-    print_hsa_status(__FILE__, __LINE__, __func__,
-              "hsa_signal_create()",
-              status);
-      hsa_amd_memory_pool_free(src_ptr_fwd);
-      hsa_amd_memory_pool_free(dst_ptr_fwd);
-      RVSHSATRACE_
-      return -1;
-  }
+  signal_fwd = fwd->signal;
 
   if (bidirectional) {
     RVSHSATRACE_
 
-    // allocate buffers and grant permissions for reverse transfer
-    sts = Allocate(src_ix_rev, dst_ix_rev, Size,
-            &src_pool_rev, &src_ptr_rev,
-            &dst_pool_rev, &dst_ptr_rev);
-
-    if (sts) {
+    // get buffers and signal for reverse transfer
+    rev = AcquireTraffic(src_ix_rev, dst_ix_rev, Size);
+    if (rev == nullptr) {
       RVSHSATRACE_
-      hsa_amd_memory_pool_free(src_ptr_fwd);
-      hsa_amd_memory_pool_free(dst_ptr_fwd);
-      return -1;
-    }
-
-    // Create a signal to wait on for reverse copy operation
-    if (HSA_STATUS_SUCCESS !=
-       (status = hsa_signal_create(1, 0, NULL, &signal_rev))) {
-      print_hsa_status(__FILE__, __LINE__, __func__,
-              "hsa_signal_create()",
-              status);
-      hsa_amd_memory_pool_free(src_ptr_fwd);
-      hsa_amd_memory_pool_free(dst_ptr_fwd);
-      hsa_amd_memory_pool_free(src_ptr_rev);
-      hsa_amd_memory_pool_free(dst_ptr_rev);
-      hsa_signal_destroy(signal_fwd);
+      ReleaseTraffic(fwd);
       return -1;
     }
+    signal_rev = rev->signal;
   }
 
   // initiate forward transfer
   hsa_signal_store_relaxed(signal_fwd, 1);
   if (HSA_STATUS_SUCCESS !=
      (status = hsa_amd_memory_async_copy(
-                dst_ptr_fwd, agent_list[dst_ix_fwd].agent,
-                src_ptr_fwd, agent_list[src_ix_fwd].agent,
+                fwd->dst_ptr, agent_list[dst_ix_fwd].agent,
+                fwd->src_ptr, agent_list[src_ix_fwd].agent,
                 Size,
                 0, NULL, signal_fwd)))
     print_hsa_status(__FILE__, __LINE__, __func__,
@@ -835,8 +1321,8 @@ int rvs::hsa::SendTraffic(uint32_t SrcNode, uint32_t DstNode,
     // initiate reverse transfer
     hsa_signal_store_relaxed(signal_rev, 1);
     if (HSA_STATUS_SUCCESS != (status = hsa_amd_memory_async_copy(
-        dst_ptr_rev, agent_list[dst_ix_rev].agent,
-        src_ptr_rev, agent_list[src_ix_rev].agent, Size,
+        rev->dst_ptr, agent_list[dst_ix_rev].agent,
+        rev->src_ptr, agent_list[src_ix_rev].agent, Size,
         0, NULL, signal_rev)))
       print_hsa_status(__FILE__, __LINE__, __func__,
               "hsa_amd_memory_async_copy()",
@@ -845,34 +1331,171 @@ int rvs::hsa::SendTraffic(uint32_t SrcNode, uint32_t DstNode,
 
   // wait for transfer to complete
   RVSHSATRACE_
-  hsa_signal_wait_acquire(signal_fwd, HSA_SIGNAL_CONDITION_LT, 1, uint64_t(-1), HSA_WAIT_STATE_ACTIVE);
+  hsa_signal_wait_acquire(signal_fwd, HSA_SIGNAL_CONDITION_LT, 1, uint64_t(-1),
+                          WaitState);
 
   // if bidirectional, also wait for reverse transfer to complete
   if (bidirectional == true) {
     RVSHSATRACE_
-    hsa_signal_wait_acquire(signal_rev, HSA_SIGNAL_CONDITION_LT, 1, uint64_t(-1), HSA_WAIT_STATE_ACTIVE);
+    hsa_signal_wait_acquire(signal_rev, HSA_SIGNAL_CONDITION_LT, 1,
+                            uint64_t(-1), WaitState);
   }
 
   RVSHSATRACE_
   // get transfer duration
   *Duration = GetCopyTime(bidirectional, signal_fwd, signal_rev)/1000000000;
 
-  hsa_amd_memory_pool_free(src_ptr_fwd);
-  hsa_amd_memory_pool_free(dst_ptr_fwd);
-  hsa_signal_destroy(signal_fwd);
+  // keep buffers and signals for subsequent transfers
+  ReleaseTraffic(fwd);
+  ReleaseTraffic(rev);
+  RVSHSATRACE_
 
-  if (bidirectional) {
+  return 0;
+}
+
+
+/**
+ * @brief Transfer data between two NUMA nodes keeping several copies in flight
+ *
+ * Up to Depth copies are queued per direction. Each copy depends on the
+ * completion signal of the previous one, so copies run back to back in the
+ * order they were issued; as soon as the oldest one is done, the next copy
+ * is queued. This keeps DMA engines busy so that sustained link throughput
+ * is measured rather than the latency of a single copy.
+ *
+ * Signals form a ring of Depth + 1 slots: the slot of copy N is reused only
+ * once copy N + 1, which depends on it, has completed.
+ *
+ * @param SrcNode source NUMA node
+ * @param DstNode destination NUMA node
+ * @param Size size of data in each copy
+ * @param bidirectional 'true' for bidirectional transfer
+ * @param Depth max number of copies in flight per direction
+ * @param Count number of copies per direction
+ * @param pStats [out] sustained duration and per-copy times
+ * @param pHist [out] if not nullptr, histogram receiving per-copy times
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int rvs::hsa::SendTrafficPipelined(uint32_t SrcNode, uint32_t DstNode,
+                                   size_t Size, bool bidirectional,
+                                   uint32_t Depth, uint32_t Count,
+                                   TrafficStats* pStats,
+                                   rvs::latency_histogram* pHist) {
+  hsa_status_t status;
+  TrafficBuffers* lane[2] = {nullptr, nullptr};
+  uint32_t issued[2] = {0, 0};
+  uint32_t done[2] = {0, 0};
+  int lanes = bidirectional ? 2 : 1;
+  int sts = 0;
+
+  RVSHSATRACE_
+
+  pStats->copies = 0;
+  pStats->duration = 0;
+
+  if (Depth == 0 || Count == 0) {
     RVSHSATRACE_
-    hsa_amd_memory_pool_free(src_ptr_rev);
-    hsa_amd_memory_pool_free(dst_ptr_rev);
-    hsa_signal_destroy(signal_rev);
+    return -1;
+  }
+
+  // given NUMA nodes, find agent indexes
+  int src_ix = FindAgent(SrcNode);
+  int dst_ix = FindAgent(DstNode);
+  if (src_ix < 0 || dst_ix < 0) {
+    RVSHSATRACE_
+    return -1;
+  }
+
+  // get buffers and signals for each direction
+  lane[0] = AcquireTraffic(src_ix, dst_ix, Size);
+  if (lanes > 1 && lane[0] != nullptr) {
+    lane[1] = AcquireTraffic(dst_ix, src_ix, Size);
+  }
+  const uint32_t slots = Depth + 1;
+  for (int l = 0; l < lanes; l++) {
+    if (lane[l] == nullptr || PipeSignals(lane[l], slots)) {
+      RVSHSATRACE_
+      ReleaseTraffic(lane[0]);
+      ReleaseTraffic(lane[1]);
+      return -1;
+    }
+  }
+
+  // fill the pipeline
+  for (uint32_t k = 0; k < Depth && k < Count && sts == 0; k++) {
+    for (int l = 0; l < lanes && sts == 0; l++) {
+      const hsa_signal_t* dep =
+        k > 0 ? &lane[l]->pipe_signals[k - 1] : nullptr;
+      if (HSA_STATUS_SUCCESS !=
+          StartCopy(lane[l], Size, lane[l]->pipe_signals[k], dep)) {
+        sts = -1;
+        break;
+      }
+      issued[l]++;
+    }
   }
+
+  uint64_t first_start = std::numeric_limits<uint64_t>::max();
+  uint64_t last_end = 0;
+
+  // retire copies in order of issue and queue the next one
+  bool bpending = true;
+  while (bpending) {
+    bpending = false;
+    for (int l = 0; l < lanes; l++) {
+      if (done[l] >= issued[l])
+        continue;
+
+      // sleep rather than spin, copies may take long to complete
+      hsa_signal_t signal = lane[l]->pipe_signals[done[l] % slots];
+      hsa_signal_wait_acquire(signal, HSA_SIGNAL_CONDITION_LT, 1,
+                              uint64_t(-1), HSA_WAIT_STATE_BLOCKED);
+      done[l]++;
+
+      hsa_amd_profiling_async_copy_time_t copy_time {0};
+      if (HSA_STATUS_SUCCESS != (status =
+          hsa_amd_profiling_get_async_copy_time(signal, &copy_time))) {
+        print_hsa_status(__FILE__, __LINE__, __func__,
+                     "hsa_amd_profiling_get_async_copy_time()",
+                     status);
+      } else {
+        pStats->copies++;
+        if (pHist) {
+          pHist->record(copy_time.end - copy_time.start);
+        }
+        first_start = std::min<uint64_t>(first_start, copy_time.start);
+        last_end = std::max<uint64_t>(last_end, copy_time.end);
+      }
+
+      // keep the pipeline full, chained after the last copy issued
+      if (sts == 0 && issued[l] < Count) {
+        std::vector<hsa_signal_t>& ring = lane[l]->pipe_signals;
+        if (HSA_STATUS_SUCCESS !=
+            StartCopy(lane[l], Size, ring[issued[l] % slots],
+                      &ring[(issued[l] - 1) % slots])) {
+          sts = -1;
+        } else {
+          issued[l]++;
+        }
+      }
+      bpending = bpending || done[l] < issued[l];
+    }
+  }
+
+  if (last_end > first_start) {
+    pStats->duration = static_cast<double>(last_end - first_start)
+                       / 1000000000;
+  }
+
+  // keep buffers and signals for subsequent transfers
+  ReleaseTraffic(lane[0]);
+  ReleaseTraffic(lane[1]);
   RVSHSATRACE_
 
-  return 0;
+  return sts;
 }
 
-
 /**
  * @brief Get peer status between Src and Dst nodes
  *
@@ -882,20 +1505,16 @@ int rvs::hsa::SendTraffic(uint32_t SrcNode, uint32_t DstNode,
  *
  * */
 int rvs::hsa::GetPeerStatus(uint32_t SrcNode, uint32_t DstNode) {
-  int32_t srcix;
-  int32_t dstix;
   std::string msg;
 
   RVSHSATRACE_
-  // given NUMA nodes, find agent indexes
-  srcix = FindAgent(SrcNode);
-  dstix = FindAgent(DstNode);
-  if (srcix < 0 || dstix < 0) {
+  const TopologyEntry* entry = GetTopology(SrcNode, DstNode);
+  if (entry == nullptr) {
     RVSHSATRACE_
     return 0;
   }
 
-  int peer_status = GetPeerStatusAgent(agent_list[srcix], agent_list[dstix]);
+  int peer_status = entry->peer_status;
 
   msg = "Src: " + std::to_string(SrcNode) + "  Dst: " + std::to_string(DstNode)
       + "  access: " + std::to_string(peer_status);
@@ -988,6 +1607,39 @@ int rvs::hsa::GetPeerStatusAgent(const AgentInformation&  SrcAgent,
   return res_access_rights;
 }
 
+/**
+ * @brief Find NUMA node closest to the given agent
+ *
+ * CPU agents are enumerated by HSA in NUMA node order. For GPU agents,
+ * the CPU agent with the shortest NUMA distance is taken.
+ *
+ * @param Node agent node
+ * @return NUMA node number, -1 if not found
+ *
+ * */
+int rvs::hsa::GetNumaNode(uint32_t Node) {
+  RVSHSATRACE_
+  for (size_t i = 0; i < cpu_list.size(); i++) {
+    if (cpu_list[i].node == Node) {
+      return static_cast<int>(i);
+    }
+  }
+
+  int numa = -1;
+  uint32_t best = NO_CONN;
+  for (size_t i = 0; i < cpu_list.size(); i++) {
+    uint32_t distance;
+    std::vector<linkinfo_t> info;
+    if (GetLinkInfo(cpu_list[i].node, Node, &distance, &info) == 0 &&
+        distance < best) {
+      best = distance;
+      numa = static_cast<int>(i);
+    }
+  }
+
+  return numa;
+}
+
 /**
  * @brief Get link information between Src and Dst nodes
  *
@@ -1000,19 +1652,32 @@ int rvs::hsa::GetPeerStatusAgent(const AgentInformation&  SrcAgent,
  * */
 int rvs::hsa::GetLinkInfo(uint32_t SrcNode, uint32_t DstNode,
                   uint32_t* pDistance, std::vector<linkinfo_t>* pInfoarr) {
-  int32_t srcix;
-  int32_t dstix;
-  hsa_status_t sts;
-
   RVSHSATRACE_
-  // given NUMA nodes, find agent indexes
-  srcix = FindAgent(SrcNode);
-  dstix = FindAgent(DstNode);
-  if (srcix < 0 || dstix < 0) {
+  const TopologyEntry* entry = GetTopology(SrcNode, DstNode);
+  if (entry == nullptr) {
     RVSHSATRACE_
     return -1;
   }
 
+  *pDistance = entry->distance;
+  *pInfoarr = entry->hops;
+  return 0;
+}
+
+/**
+ * @brief Query HSA for link information between two agents
+ *
+ * @param srcix source agent index in agent_list
+ * @param dstix destination agent index in agent_list
+ * @param pDistance ptr to NUMA distance
+ * @param pInfoarr ptr to list of hop infos
+ * @return 0 - OK, non-zero otherwise
+ *
+ * */
+int rvs::hsa::QueryLinkInfo(int srcix, int dstix,
+                  uint32_t* pDistance, std::vector<linkinfo_t>* pInfoarr) {
+  hsa_status_t sts;
+
   RVSHSATRACE_
 
   *pDistance = NO_CONN;
@@ -1055,27 +1720,7 @@ int rvs::hsa::GetLinkInfo(uint32_t SrcNode, uint32_t DstNode,
     *pDistance += (link_info[hopIdx]).numa_distance;
     rvslinkinfo.distance = (link_info[hopIdx]).numa_distance;
     rvslinkinfo.etype = (link_info[hopIdx]).link_type;
-    switch (rvslinkinfo.etype) {
-      case HSA_AMD_LINK_INFO_TYPE_HYPERTRANSPORT:
-        rvslinkinfo.strtype = "HyperTransport";
-        break;
-      case HSA_AMD_LINK_INFO_TYPE_QPI:
-        rvslinkinfo.strtype = "QPI";
-        break;
-      case HSA_AMD_LINK_INFO_TYPE_PCIE:
-        rvslinkinfo.strtype = "PCIe";
-        break;
-      case HSA_AMD_LINK_INFO_TYPE_INFINBAND:
-        rvslinkinfo.strtype = "InfiniBand";
-        break;
-      case HSA_AMD_LINK_INFO_TYPE_XGMI:
-        rvslinkinfo.strtype = "xGMI";
-        break;
-      default:
-        RVSHSATRACE_
-        rvslinkinfo.strtype = "unknown-"
-                            + std::to_string(rvslinkinfo.etype);
-    }
+    rvslinkinfo.strtype = LinkTypeName(rvslinkinfo.etype);
     pInfoarr->push_back(rvslinkinfo);
   }
   free(link_info);
@@ -1084,6 +1729,31 @@ int rvs::hsa::GetLinkInfo(uint32_t SrcNode, uint32_t DstNode,
   return 0;
 }
 
+/**
+ * @brief Get link type name
+ *
+ * @param Type HSA link type
+ * @return link type as string
+ *
+ * */
+std::string rvs::hsa::LinkTypeName(hsa_amd_link_info_type_t Type) {
+  switch (Type) {
+    case HSA_AMD_LINK_INFO_TYPE_HYPERTRANSPORT:
+      return "HyperTransport";
+    case HSA_AMD_LINK_INFO_TYPE_QPI:
+      return "QPI";
+    case HSA_AMD_LINK_INFO_TYPE_PCIE:
+      return "PCIe";
+    case HSA_AMD_LINK_INFO_TYPE_INFINBAND:
+      return "InfiniBand";
+    case HSA_AMD_LINK_INFO_TYPE_XGMI:
+      return "xGMI";
+    default:
+      RVSHSATRACE_
+      return "unknown-" + std::to_string(Type);
+  }
+}
+
 
 void rvs::hsa::PrintTopology() {
   vector<uint16_t> gpuId;
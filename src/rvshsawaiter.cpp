@@ -0,0 +1,227 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvshsawaiter.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+
+#include "include/rvshsa.h"
+
+//! CPU cores served by one waiter thread
+#define RVS_HSA_WAITER_CORES 16
+//! upper limit for number of waiter threads
+#define RVS_HSA_WAITER_MAX 4
+
+//! Default constructor
+rvs::hsa_waiter::group::group() : pending(0) {
+}
+
+/**
+ * @brief Constructor for groups completed asynchronously
+ *
+ * @param OnDone called from waiter thread each time all the copies in the
+ * group complete; as it runs on waiter thread it should only hand
+ * the work over (e.g. to rvs::WorkPool)
+ *
+ * */
+rvs::hsa_waiter::group::group(const std::function<void()>& OnDone)
+: pending(0), on_done(OnDone) {
+}
+
+/**
+ * @brief Block until all copies submitted with this group complete
+ *
+ * */
+void rvs::hsa_waiter::group::wait() {
+  std::unique_lock<std::mutex> lk(mtx);
+  cv.wait(lk, [this]{ return pending == 0; });
+}
+
+/**
+ * @brief Keep group from completing while copies are being submitted
+ *
+ * Every hold() has to be matched with release().
+ *
+ * */
+void rvs::hsa_waiter::group::hold() {
+  std::lock_guard<std::mutex> lk(mtx);
+  pending++;
+}
+
+/**
+ * @brief Release hold taken with hold(), also called by waiter thread
+ * when one of the copies completes
+ *
+ * */
+void rvs::hsa_waiter::group::release() {
+  {
+    std::lock_guard<std::mutex> lk(mtx);
+    if (--pending > 0) {
+      return;
+    }
+    if (!on_done) {
+      cv.notify_all();
+      return;
+    }
+  }
+  // group may be reused from within the callback
+  on_done();
+}
+
+/**
+ * @brief Start waiter threads
+ *
+ * @param Threads number of waiter threads, 0 - one per
+ * RVS_HSA_WAITER_CORES CPU cores (at most RVS_HSA_WAITER_MAX)
+ *
+ * */
+rvs::hsa_waiter::hsa_waiter(size_t Threads) : next(0) {
+  if (Threads == 0) {
+    Threads = std::thread::hardware_concurrency() / RVS_HSA_WAITER_CORES;
+    Threads = std::min(std::max(Threads, static_cast<size_t>(1)),
+                       static_cast<size_t>(RVS_HSA_WAITER_MAX));
+  }
+
+  for (size_t i = 0; i < Threads; i++) {
+    std::unique_ptr<lane> p(new lane);
+    p->stop = false;
+    hsa_status_t status = hsa_signal_create(0, 0, NULL, &p->wake);
+    if (status != HSA_STATUS_SUCCESS) {
+      rvs::hsa::print_hsa_status(__FILE__, __LINE__, __func__,
+                                 "hsa_signal_create()", status);
+      break;
+    }
+    p->thread = std::thread(&rvs::hsa_waiter::Run, this, p.get());
+    lanes.push_back(std::move(p));
+  }
+}
+
+/**
+ * @brief Stop waiter threads
+ *
+ * Waiters complete all the copies submitted to them before exiting.
+ *
+ * */
+rvs::hsa_waiter::~hsa_waiter() {
+  for (auto& p : lanes) {
+    {
+      std::lock_guard<std::mutex> lk(p->mtx);
+      p->stop = true;
+    }
+    hsa_signal_store_screlease(p->wake, 1);
+  }
+  for (auto& p : lanes) {
+    p->thread.join();
+    hsa_signal_destroy(p->wake);
+  }
+}
+
+/**
+ * @brief Submit copy completion signal
+ *
+ * @param Signal copy completion signal, completed when it drops below 1
+ * @param pGroup group to notify when copy completes
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int rvs::hsa_waiter::Submit(hsa_signal_t Signal, group* pGroup) {
+  if (lanes.empty()) {
+    return -1;
+  }
+
+  lane* p;
+  {
+    std::lock_guard<std::mutex> lk(next_mutex);
+    p = lanes[next].get();
+    next = (next + 1) % lanes.size();
+  }
+
+  pGroup->hold();
+
+  {
+    std::lock_guard<std::mutex> lk(p->mtx);
+    p->incoming.push_back(entry{Signal, pGroup});
+  }
+  hsa_signal_store_screlease(p->wake, 1);
+
+  return 0;
+}
+
+/**
+ * @brief Waiter thread function
+ *
+ * Blocks on the wake signal and all the copy signals submitted to
+ * this lane, retires completed copies and picks up new submissions.
+ *
+ * @param pLane lane served by this thread
+ *
+ * */
+void rvs::hsa_waiter::Run(lane* pLane) {
+  std::vector<entry> active;
+  std::vector<hsa_signal_t> signals;
+  std::vector<hsa_signal_condition_t> conds;
+  std::vector<hsa_signal_value_t> values;
+
+  for (;;) {
+    // reset wake signal before picking up submissions so that
+    // no submission can be missed
+    hsa_signal_store_relaxed(pLane->wake, 0);
+    {
+      std::lock_guard<std::mutex> lk(pLane->mtx);
+      active.insert(active.end(), pLane->incoming.begin(),
+                    pLane->incoming.end());
+      pLane->incoming.clear();
+      if (pLane->stop && active.empty()) {
+        break;
+      }
+    }
+
+    signals.assign(1, pLane->wake);
+    conds.assign(1, HSA_SIGNAL_CONDITION_NE);
+    values.assign(1, 0);
+    for (const auto& e : active) {
+      signals.push_back(e.signal);
+      conds.push_back(HSA_SIGNAL_CONDITION_LT);
+      values.push_back(1);
+    }
+
+    hsa_signal_value_t value;
+    hsa_amd_signal_wait_any(signals.size(), signals.data(), conds.data(),
+                            values.data(), UINT64_MAX,
+                            HSA_WAIT_STATE_BLOCKED, &value);
+
+    // retire every copy completed so far, not only the one reported
+    auto it = active.begin();
+    while (it != active.end()) {
+      if (hsa_signal_load_scacquire(it->signal) < 1) {
+        it->pgroup->release();
+        it = active.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
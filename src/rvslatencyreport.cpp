@@ -0,0 +1,144 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvslatencyreport.h"
+
+#include <stdio.h>
+
+#include "include/rvsloglp.h"
+
+/**
+ * @brief Constructor
+ *
+ * @param Module module name
+ * @param Action action name
+ * @param Tag tag starting each log line
+ * @param Json 'true' if JSON records are to be created
+ *
+ * */
+rvs::latency_report::latency_report(const std::string& Module,
+                                    const std::string& Action,
+                                    const std::string& Tag, bool Json)
+  : module(Module), action(Action), tag(Tag), json(Json), transfers(0) {
+}
+
+/**
+ * @brief Print copy latency percentiles of one transfer
+ *
+ * Prints one line per block size (if more than one was transferred) and
+ * one for all the block sizes together.
+ *
+ * @param Rec latencies recorded by the transfer
+ * @param Pair transfer description
+ * @param Src source device
+ * @param Dst destination device
+ *
+ * */
+void rvs::latency_report::print(const latency_recorder& Rec,
+                                const std::string& Pair,
+                                const std::string& Src,
+                                const std::string& Dst) {
+  transfers++;
+
+  latency_histogram sum;
+  Rec.merge(&sum);
+  if (sum.count() == 0)
+    return;
+
+  if (Rec.size() > 1) {
+    for (size_t i = 0; i < Rec.size(); i++) {
+      if (Rec.histogram(i).count() > 0) {
+        log(Pair, Src, Dst, std::to_string(Rec.block_size(i)),
+            Rec.histogram(i), rvs::loginfo);
+      }
+    }
+  }
+
+  log(Pair, Src, Dst,
+      Rec.size() > 1 ? "all" : std::to_string(Rec.block_size(0)),
+      sum, rvs::logresults);
+  total.merge(sum);
+}
+
+/**
+ * @brief Print copy latency percentiles of all transfers together
+ *
+ * Nothing is printed unless more than one transfer has been printed.
+ *
+ * */
+void rvs::latency_report::print_all() {
+  if (transfers > 1 && total.count() > 0) {
+    log("all", "all", "all", "all", total, rvs::logresults);
+  }
+}
+
+/**
+ * @brief Log copy latency percentiles
+ *
+ * @param Pair transfer description
+ * @param Src source device
+ * @param Dst destination device
+ * @param Size block size (bytes)
+ * @param Hist copy latencies
+ * @param Level logging level
+ *
+ * */
+void rvs::latency_report::log(const std::string& Pair,
+                              const std::string& Src,
+                              const std::string& Dst,
+                              const std::string& Size,
+                              const latency_histogram& Hist, int Level) {
+  char buff[128];
+  snprintf(buff, sizeof(buff), "%.1f/%.1f/%.1f/%.1f us",
+           Hist.percentile(50) / 1e3, Hist.percentile(99) / 1e3,
+           Hist.percentile(99.9) / 1e3, Hist.max() / 1e3);
+
+  std::string msg = "[" + action + "] " + tag + "  " + Pair
+      + "  size: " + Size + "  copies: " + std::to_string(Hist.count())
+      + "  p50/p99/p99.9/max: " + buff;
+  rvs::lp::Log(msg, Level);
+
+  if (json) {
+    unsigned int sec;
+    unsigned int usec;
+    rvs::lp::get_ticks(&sec, &usec);
+    void* pjson = rvs::lp::LogRecordCreate(module.c_str(),
+                            action.c_str(), Level, sec, usec);
+    if (pjson != NULL) {
+      rvs::lp::AddString(pjson, "src", Src);
+      rvs::lp::AddString(pjson, "dst", Dst);
+      rvs::lp::AddString(pjson, "block size", Size);
+      rvs::lp::AddString(pjson, "copies", std::to_string(Hist.count()));
+      rvs::lp::AddString(pjson, "latency p50 (us)",
+                         std::to_string(Hist.percentile(50) / 1e3));
+      rvs::lp::AddString(pjson, "latency p99 (us)",
+                         std::to_string(Hist.percentile(99) / 1e3));
+      rvs::lp::AddString(pjson, "latency p99.9 (us)",
+                         std::to_string(Hist.percentile(99.9) / 1e3));
+      rvs::lp::AddString(pjson, "latency max (us)",
+                         std::to_string(Hist.max() / 1e3));
+      rvs::lp::LogRecordFlush(pjson);
+    }
+  }
+}
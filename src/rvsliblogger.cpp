@@ -25,29 +25,79 @@
 #include "include/rvsliblogger.h"
 
 #include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
 #include <time.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <errno.h>
 #include <cstring>
 
 #include <iostream>
 #include <chrono>
 #include <iomanip>
-#include <fstream>
 #include <string>
 #include <mutex>
+#include <vector>
+#include <utility>
+#include <new>
 
 #include "include/rvstrace.h"
 #include "include/rvslognode.h"
 #include "include/rvslognodestring.h"
 #include "include/rvslognodeint.h"
 #include "include/rvslognoderec.h"
+#include "include/rvslogarena.h"
+#include "include/rvslogbinary.h"
+#include "include/rvslogclock.h"
+#include "include/rvstimer.h"
 
 using std::cerr;
 using std::cout;
 
+namespace {
+
+/**
+ * @brief Construct log node in arena
+ *
+ * Falls back to plain new if no arena is given. Node name, value and
+ * child list are allocated from the same arena as the node.
+ *
+ * @param pArena arena to allocate from
+ * @param args arguments passed to node constructor
+ * @return newly constructed node
+ *
+ */
+template <typename T, typename... Args>
+T* new_node(rvs::LogArena* pArena, Args... args) {
+  if (pArena == nullptr)
+    return new T(args..., pArena);
+
+  void* p = pArena->allocate(sizeof(T), alignof(T));
+  return new (p) T(args..., pArena);
+}
+
+/**
+ * @brief Destroy log record and recycle its arena
+ *
+ * @param pRec log record
+ *
+ */
+void release_record(rvs::LogNodeRec* pRec) {
+  rvs::LogArena* arena = pRec->GetArena();
+  rvs::LogNodeBase::Destroy(pRec);
+  rvs::LogArena::Release(arena);
+}
+
+}  // namespace
+
 int   rvs::logger::loglevel_m(2);
 bool  rvs::logger::tojson_m(false);
 bool  rvs::logger::append_m(false);
+bool  rvs::logger::async_m(false);
+bool  rvs::logger::tobinary_m(false);
+rvs::LogBinaryWriter rvs::logger::binlog;
 bool  rvs::logger::isfirstrecord_m(true);
 std::mutex  rvs::logger::cout_mutex;
 std::mutex  rvs::logger::log_mutex;
@@ -55,6 +105,20 @@ bool  rvs::logger::bStop(false);
 uint16_t rvs::logger::stop_flags(0u);
 bool rvs::logger::b_quiet(false);
 char rvs::logger::log_file[1024];
+int rvs::logger::log_fd(-1);
+off_t rvs::logger::json_tail(-1);
+const char rvs::logger::json_term[] = RVSENDL "]";
+std::string rvs::logger::log_buffer;
+std::chrono::steady_clock::time_point rvs::logger::last_flush;
+const size_t rvs::logger::log_buffer_max(256 * 1024);
+const int rvs::logger::log_flush_ms(1000);
+bool rvs::logger::flush_armed(false);
+rvs::LogQueue rvs::logger::log_queue;
+std::thread rvs::logger::async_thread;
+std::atomic<bool> rvs::logger::async_run(false);
+std::atomic<bool> rvs::logger::async_idle(false);
+std::mutex rvs::logger::async_mutex;
+std::condition_variable rvs::logger::async_cv;
 
 const char*  rvs::logger::loglevelname[] = {
   "NONE  ", "RESULT", "ERROR ", "INFO  ", "DEBUG ", "TRACE " };
@@ -79,6 +143,29 @@ bool rvs::logger::append() {
   return append_m;
 }
 
+/**
+ * @brief Set 'async' flag
+ *
+ * When set, rows are formatted on the calling thread and handed over to
+ * a dedicated writer thread which outputs them to cout and log file.
+ *
+ * @param flag new value
+ *
+ */
+void rvs::logger::async(const bool flag) {
+  async_m = flag;
+}
+
+/**
+ * @brief Get 'async' flag
+ *
+ * @return Current flag value
+ *
+ */
+bool rvs::logger::async() {
+  return async_m;
+}
+
 void rvs::logger::set_log_file(const std::string& fname) {
     strncpy(log_file, fname.c_str(), sizeof(log_file));
 }
@@ -93,21 +180,29 @@ void rvs::logger::log_level(const int rLevel) {
   loglevel_m = rLevel;
 }
 
+/**
+ * @brief Get logging level
+ *
+ * @return Current logging level
+ *
+ */
+int rvs::logger::log_level() {
+  return loglevel_m;
+}
+
 /**
  * @brief Fetches times since system start
  *
+ * Time is taken from LogClock which is cheap enough to be called for
+ * each log row and keeps timestamps ordered across threads.
+ *
  * @param psecs seconds since system start
  * @param pusecs microseconds withing current second
  * @return 'true' - success, 'false otherwise
  *
  */
 bool rvs::logger::get_ticks(uint32_t* psecs, uint32_t* pusecs) {
-  struct timespec ts;
-
-  clock_gettime(CLOCK_MONOTONIC, &ts);
-  *pusecs    = ts.tv_nsec / 1000;
-  *psecs  = ts.tv_sec;
-
+  LogClock::split(LogClock::now(), psecs, pusecs);
   return true;
 }
 
@@ -131,6 +226,29 @@ bool rvs::logger::to_json() {
   return tojson_m;
 }
 
+/**
+ * @brief Set 'binary' flag
+ *
+ * When set together with 'json' flag, log records are written into
+ * log file in compact binary format (see rvslogbinary.h) instead of JSON.
+ *
+ * @param flag new value
+ *
+ */
+void rvs::logger::to_binary(const bool flag) {
+  tobinary_m = flag;
+}
+
+/**
+ * @brief Get 'binary' flag
+ *
+ * @return Current flag value
+ *
+ */
+bool rvs::logger::to_binary() {
+  return tobinary_m;
+}
+
 /**
  * @brief Output log message
  *
@@ -215,6 +333,16 @@ int rvs::logger::LogExt(const char* Message, const int LogLevel,
   row +="] ";
   row += Message;
 
+  // hand the row over to the writer thread
+  if (async_run.load(std::memory_order_acquire)) {
+    int target = 0;
+    if (!b_quiet)
+      target |= LogQueue::toCout;
+    if (!to_json())
+      target |= LogQueue::toFile;
+    return Enqueue(&row, target, LogLevel);
+  }
+
   // if no quiet option given, output to cout
   if (!b_quiet) {
     DTRACE_
@@ -230,21 +358,9 @@ int rvs::logger::LogExt(const char* Message, const int LogLevel,
   }
 
   DTRACE_
-  // send to file if requested
-  if (isfirstrecord_m) {
-    DTRACE_
-    isfirstrecord_m = false;
-  } else {
-    DTRACE_
-    row = RVSENDL + row;
-  }
-  DTRACE_
-
-  if (true) {
-    // lock log_mutex for the duration of this block
-    std::lock_guard<std::mutex> lk(log_mutex);
-    ToFile(row);
-  }
+  // lock log_mutex for the duration of this block
+  std::lock_guard<std::mutex> lk(log_mutex);
+  RowToFile(row, false);
 
   DTRACE_
   return 0;
@@ -276,7 +392,9 @@ void* rvs::logger::LogRecordCreate(const char* Module, const char* Action,
     get_ticks(&sec, &usec);
   }
 
-  rvs::LogNodeRec* rec = new LogNodeRec(Action, LogLevel, sec, usec);
+  // all nodes of this record are allocated from the same arena
+  rvs::LogNodeRec* rec = new_node<LogNodeRec>(LogArena::Acquire(), Action,
+                                              LogLevel, sec, usec, nullptr);
   AddString(rec, "action", Action);
   AddString(rec, "module", Module);
   AddString(rec, "loglevelname", (LogLevel >= lognone && LogLevel < logtrace) ?
@@ -295,16 +413,13 @@ void* rvs::logger::LogRecordCreate(const char* Module, const char* Action,
  *
  */
 int   rvs::logger::LogRecordFlush(void* pLogRecord) {
-  // lock log_mutex for the duration of this block
-  std::lock_guard<std::mutex> lk(log_mutex);
-  std::string val;
   DTRACE_
 
   LogNodeRec* r = static_cast<LogNodeRec*>(pLogRecord);
   // no JSON loggin requested
   if (!to_json()) {
     DTRACE_
-    delete r;
+    release_record(r);
     return 0;
   }
 
@@ -314,52 +429,245 @@ int   rvs::logger::LogRecordFlush(void* pLogRecord) {
     char buff[128];
     snprintf(buff, sizeof(buff), "unknown logging level: %d", r->LogLevel());
     Err(buff, "CLI");
-    delete r;
+    release_record(r);
     return -1;
   }
 
   // if too high, ignore record
   if (level > loglevel_m) {
     DTRACE_
-    delete r;
+    release_record(r);
     return 0;
   }
 
-  // do not pre-pend "," separator for the first row
-  std::string row;
-  if (append_m) {
-    DTRACE_
-    row = ",";
+  // binary records are encoded under log_mutex as the string table
+  // has to follow file order
+  if (tobinary_m) {
+    std::lock_guard<std::mutex> lk(log_mutex);
+    static std::string bin;
+    bin.clear();
+    binlog.Record(r, &bin);
+    release_record(r);
+    return ToFile(bin);
+  }
+
+  DTRACE_
+  // get JSON formatted log record; buffer is reused by subsequent records
+  // coming from the same thread
+  static thread_local std::string json;
+  json.clear();
+  r->Serialize(&json, "  ", 0);
+
+  // dealloc memory
+  release_record(r);
+
+  // hand the record over to the writer thread
+  if (async_run.load(std::memory_order_acquire)) {
+    std::string row(json);
+    return Enqueue(&row, LogQueue::toJson, level);
+  }
+
+  // lock log_mutex for the duration of this block
+  std::lock_guard<std::mutex> lk(log_mutex);
+
+  // send it to file
+  return RowToFile(json, true);
+}
+
+/**
+ * @brief Output row to file prepending proper separator
+ *
+ * Rows are separated by new line for text output and by ","
+ * for JSON output. Caller is expected to hold log_mutex.
+ *
+ * @param Row text row or JSON formatted log record
+ * @param bJson 'true' if Row is JSON record
+ * @return 0 - success, non-zero otherwise
+ *
+ */
+int rvs::logger::RowToFile(const std::string& Row, const bool bJson) {
+  // (re)open log file first as it tells if JSON separator is needed
+  if (log_fd < 0 && ToFile(std::string()))
+    return -1;
+
+  // do not pre-pend separator for the first row
+  const char* separator = "";
+  if (bJson) {
+    if (!isfirstrecord_m) {
+      separator = ",";
+    }
   } else {
-    DTRACE_
     if (!isfirstrecord_m) {
-      DTRACE_
-      row = ",";
+      separator = RVSENDL;
     }
   }
-  DTRACE_
-  // get JSON formatted log record
-  row += r->ToJson("  ");
+  isfirstrecord_m = false;
 
-  // send it to file
-  ToFile(row);
+  if (*separator) {
+    ToFile(separator);
+  }
+  return ToFile(Row);
+}
 
-  // dealloc memory
-  delete r;
+/**
+ * @brief Push formatted row into asynchronous log queue
+ *
+ * Rows at logerror level and below wait for a free slot when the queue is
+ * full. Less important rows are dropped and counted instead so that module
+ * threads are never held up by verbose logging.
+ *
+ * @param pRow formatted row (moved into the queue)
+ * @param Target combination of LogQueue::eTarget flags
+ * @param LogLevel logging level of the row
+ * @return 0 - success, non-zero if row was dropped
+ *
+ */
+int rvs::logger::Enqueue(std::string* pRow, const int Target,
+                         const int LogLevel) {
+  if (Target == 0)
+    return 0;
 
-  if (isfirstrecord_m) {
-    DTRACE_
-    isfirstrecord_m = false;
+  LogQueue::Entry e;
+  e.Row = std::move(*pRow);
+  e.Target = Target;
+
+  bool sts = log_queue.push(&e, LogLevel <= logerror);
+
+  if (async_idle.load(std::memory_order_relaxed)) {
+    async_cv.notify_one();
   }
-  DTRACE_
-  // return OK
+
+  return sts ? 0 : 1;
+}
+
+/**
+ * @brief Writer thread function for asynchronous logging
+ *
+ * Drains log_queue in batches so that cout_mutex and log_mutex are taken
+ * once per batch rather than once per row.
+ *
+ */
+void rvs::logger::AsyncWriter() {
+  const size_t batch_max = 256;
+  std::vector<LogQueue::Entry> batch(batch_max);
+
+  for (;;) {
+    size_t count = 0;
+    int targets = 0;
+    while (count < batch_max && log_queue.pop(&batch[count])) {
+      targets |= batch[count].Target;
+      count++;
+    }
+
+    if (count == 0) {
+      if (!async_run.load(std::memory_order_acquire))
+        break;
+      std::unique_lock<std::mutex> lk(async_mutex);
+      async_idle.store(true);
+      if (log_queue.empty()) {
+        async_cv.wait_for(lk, std::chrono::milliseconds(10));
+      }
+      async_idle.store(false);
+      continue;
+    }
+
+    if (targets & LogQueue::toCout) {
+      // lock cout_mutex for the duration of this block
+      std::lock_guard<std::mutex> lk(cout_mutex);
+      for (size_t i = 0; i < count; i++) {
+        if (batch[i].Target & LogQueue::toCout)
+          cout << batch[i].Row << '\n';
+      }
+    }
+
+    if (targets & (LogQueue::toFile | LogQueue::toJson)) {
+      // lock log_mutex for the duration of this block
+      std::lock_guard<std::mutex> lk(log_mutex);
+      for (size_t i = 0; i < count; i++) {
+        if (batch[i].Target & LogQueue::toFile)
+          RowToFile(batch[i].Row, false);
+        else if (batch[i].Target & LogQueue::toJson)
+          RowToFile(batch[i].Row, true);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Starts writer thread if asynchronous logging is requested
+ *
+ * @return 0 - success, non-zero otherwise
+ *
+ */
+int rvs::logger::StartAsync() {
+  if (!async_m || async_run.load())
+    return 0;
+
+  RegisterAtExit();
+
+  log_queue.reset_counters();
+  async_run.store(true, std::memory_order_release);
+  try {
+    async_thread = std::thread(AsyncWriter);
+  } catch (...) {
+    async_run.store(false);
+    return -1;
+  }
+
   return 0;
 }
 
+/**
+ * @brief Stops writer thread
+ *
+ * All rows queued before this call are output before it returns.
+ * Subsequent rows are output synchronously on the calling thread.
+ *
+ */
+void rvs::logger::StopAsync() {
+  if (!async_run.exchange(false))
+    return;
+
+  async_cv.notify_one();
+  if (async_thread.joinable())
+    async_thread.join();
+
+  // output rows pushed while writer thread was exiting
+  LogQueue::Entry e;
+  while (log_queue.pop(&e)) {
+    if ((e.Target & LogQueue::toCout)) {
+      std::lock_guard<std::mutex> lk(cout_mutex);
+      cout << e.Row << '\n';
+    }
+    if (e.Target & (LogQueue::toFile | LogQueue::toJson)) {
+      std::lock_guard<std::mutex> lk(log_mutex);
+      RowToFile(e.Row, (e.Target & LogQueue::toJson) != 0);
+    }
+  }
+
+  char buff[128];
+  snprintf(buff, sizeof(buff),
+           "asynchronous logging: %llu rows queued, %llu dropped, "
+           "%llu queue full",
+           static_cast<unsigned long long>(log_queue.pushed()),
+           static_cast<unsigned long long>(log_queue.dropped()),
+           static_cast<unsigned long long>(log_queue.full()));
+  if (log_queue.dropped()) {
+    Err(buff, "CLI");
+  }
+  LogExt(buff, loginfo, 0, 0);
+  log_queue.reset_counters();
+}
+
 /**
  * @brief Output log record to file
  *
- * Sends out string representing record to a log file
+ * Appends string representing record to the log buffer. Buffer is written
+ * into the log file once it grows over log_buffer_max bytes or when
+ * log_flush_ms elapsed since the last write. If no further row comes in,
+ * a timer writes the buffer out log_flush_ms after it was started so that
+ * rows are not held back during quiet periods. Caller is expected to hold
+ * log_mutex.
  *
  * @param Row string representing log record
  * @return 0 - success, non-zero otherwise
@@ -371,46 +679,243 @@ int rvs::logger::ToFile(const std::string& Row) {
       return 0;
   }
 
-  std::string logfile(log_file);
-  if (logfile == "")
+  if (log_file[0] == '\0')
     return -1;
 
-  std::fstream fs;
-  fs.open(logfile, std::fstream::out | std::fstream::app);
+  if (log_fd < 0) {
+    if (OpenFile(false))
+      return -1;
+  }
 
-  fs << Row;
+  log_buffer += Row;
 
-  fs.close();
+  if (log_buffer.size() >= log_buffer_max ||
+      std::chrono::steady_clock::now() - last_flush >=
+      std::chrono::milliseconds(log_flush_ms)) {
+    return FlushFile();
+  }
+
+  if (!flush_armed) {
+    flush_armed = true;
+    timer_service::get()->add(std::chrono::milliseconds(log_flush_ms), true,
+                              FlushTimer);
+  }
 
   return 0;
 }
 
 /**
- * @brief Patch JSON log file
+ * @brief Timer callback writing out rows buffered by ToFile()
+ *
+ * Called from timer service thread.
+ *
+ */
+void rvs::logger::FlushTimer() {
+  // lock log_mutex for the duration of this function
+  std::lock_guard<std::mutex> lk(log_mutex);
+  flush_armed = false;
+  FlushFile();
+}
+
+/**
+ * @brief Open log file
+ *
+ * Opens log file given through set_log_file(). File descriptor stays open
+ * until CloseFile() is called so that rows need not reopen the file.
  *
- * In case when append "-a" option is given along with "-l --json",
- * replaces "]" terminating character with " " in order to
- * ensure well-formed JSON content.
+ * JSON log file is not opened in append mode as its closing bracket is
+ * overwritten in place by each write (see JsonSeekTail()).
  *
- * @param pSts non zero if patching took place
+ * @param bTruncate 'true' if existing content is to be discarded
  * @return 0 - success, non-zero otherwise
  *
  */
-int rvs::logger::JsonPatchAppend(int* pSts) {
-  std::string logfile(log_file);
+int rvs::logger::OpenFile(const bool bTruncate) {
+  CloseFile();
+
+  bool bJson = tojson_m && !tobinary_m;
+
+  int flags = O_CREAT | O_CLOEXEC;
+  flags |= bJson ? O_RDWR : (O_WRONLY | O_APPEND);
+  if (bTruncate)
+    flags |= O_TRUNC;
 
-  FILE * pFile;
-  pFile = fopen(logfile.c_str() , "r+");
-  if (pFile == nullptr) {
+  log_fd = open(log_file, flags, 0644);
+  if (log_fd < 0)
     return -1;
+
+  RegisterAtExit();
+
+  last_flush = std::chrono::steady_clock::now();
+
+  if (bJson) {
+    if (JsonSeekTail()) {
+      close(log_fd);
+      log_fd = -1;
+      return -1;
+    }
+    // make sure the file is well formed from the very start
+    return FlushFile();
   }
-  fseek(pFile , -1 , SEEK_END);
-  fputs(" " , pFile);
-  fclose(pFile);
-  *pSts = 1;
+
   return 0;
 }
 
+/**
+ * @brief Locate closing bracket of JSON log file
+ *
+ * JSON log file is kept well formed at all times: each write puts the rows
+ * at json_tail followed by the closing bracket, and json_tail is then
+ * advanced past the rows so that the next write overwrites the bracket.
+ * Appending is thus O(1) per write and a run which is killed or stopped
+ * leaves a parseable file behind, missing only rows not yet written.
+ *
+ * For a new (empty) file the opening bracket is queued. For an existing
+ * file only its last few bytes are read to find the closing bracket.
+ * isfirstrecord_m is set according to whether the file holds any records.
+ *
+ * @return 0 - success, non-zero otherwise
+ *
+ */
+int rvs::logger::JsonSeekTail() {
+  struct stat st;
+  if (fstat(log_fd, &st))
+    return -1;
+
+  char tail[256];
+  ssize_t count = 0;
+  off_t start = 0;
+  if (st.st_size > 0) {
+    start = st.st_size > static_cast<off_t>(sizeof(tail)) ?
+            st.st_size - static_cast<off_t>(sizeof(tail)) : 0;
+    count = pread(log_fd, tail, st.st_size - start, start);
+    if (count < 0)
+      return -1;
+  }
+
+  ssize_t i = count - 1;
+  while (i >= 0 && isspace(tail[i]))
+    i--;
+
+  if (i < 0 && start == 0) {
+    // nothing in the file yet - start new JSON array
+    if (ftruncate(log_fd, 0))
+      return -1;
+    json_tail = 0;
+    log_buffer = "[";
+    isfirstrecord_m = true;
+    return 0;
+  }
+
+  if (i < 0 || tail[i] != ']') {
+    // not terminated (e.g. written by a run which crashed before
+    // the in-place terminator was introduced) - continue after
+    // the last record
+    json_tail = st.st_size;
+    isfirstrecord_m = false;
+    return 0;
+  }
+
+  json_tail = start + i;
+  // drop whatever follows closing bracket
+  if (st.st_size > json_tail + 1 && ftruncate(log_fd, json_tail + 1))
+    return -1;
+
+  // check if the array already holds any record
+  ssize_t j = i - 1;
+  while (j >= 0 && isspace(tail[j]))
+    j--;
+  isfirstrecord_m = (j >= 0 && tail[j] == '[');
+
+  return 0;
+}
+
+/**
+ * @brief Makes sure pending rows are output on process exit
+ *
+ * Registers AtExit() handler (once) so that writer thread is joined and
+ * buffered rows are written even if terminate() is never called.
+ *
+ */
+void rvs::logger::RegisterAtExit() {
+  static bool b_registered = false;
+
+  if (!b_registered) {
+    b_registered = true;
+    atexit(AtExit);
+  }
+}
+
+/**
+ * @brief Process exit handler
+ *
+ * Joins writer thread and writes out buffered rows.
+ *
+ */
+void rvs::logger::AtExit() {
+  StopAsync();
+
+  // lock log_mutex for the duration of this function
+  std::lock_guard<std::mutex> lk(log_mutex);
+  CloseFile();
+}
+
+/**
+ * @brief Write log buffer into log file
+ *
+ * @return 0 - success, non-zero otherwise
+ *
+ */
+int rvs::logger::FlushFile() {
+  last_flush = std::chrono::steady_clock::now();
+
+  if (log_fd < 0 || log_buffer.empty())
+    return 0;
+
+  // JSON rows go over the closing bracket which is re-written after them
+  size_t rows = log_buffer.size();
+  if (json_tail >= 0)
+    log_buffer += json_term;
+
+  off_t offset = json_tail;
+  const char* p = log_buffer.data();
+  size_t left = log_buffer.size();
+  while (left > 0) {
+    ssize_t written = offset < 0 ? write(log_fd, p, left) :
+                                   pwrite(log_fd, p, left, offset);
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      log_buffer.clear();
+      return -1;
+    }
+    p += written;
+    left -= written;
+    if (offset >= 0)
+      offset += written;
+  }
+  log_buffer.clear();
+
+  if (json_tail >= 0)
+    json_tail += rows;
+
+  return 0;
+}
+
+/**
+ * @brief Write pending rows and close log file
+ *
+ */
+void rvs::logger::CloseFile() {
+  if (log_fd < 0)
+    return;
+
+  FlushFile();
+  close(log_fd);
+  log_fd = -1;
+  json_tail = -1;
+}
+
 /**
  * @brief Create loggin output node
  *
@@ -422,7 +927,9 @@ int rvs::logger::JsonPatchAppend(int* pSts) {
  *
  */
 void* rvs::logger::CreateNode(void* Parent, const char* Name) {
-  rvs::LogNode* p = new LogNode(Name, static_cast<rvs::LogNodeBase*>(Parent));
+  rvs::LogNodeBase* pp = static_cast<rvs::LogNodeBase*>(Parent);
+  rvs::LogNode* p = new_node<LogNode>(pp ? pp->GetArena() : nullptr,
+                                      Name, pp);
   return p;
 }
 
@@ -438,7 +945,8 @@ void* rvs::logger::CreateNode(void* Parent, const char* Name) {
  */
 void  rvs::logger::AddString(void* Parent, const char* Key, const char* Val) {
   rvs::LogNode* pp = static_cast<rvs::LogNode*>(Parent);
-  rvs::LogNodeString* p = new LogNodeString(Key, Val, pp);
+  rvs::LogNodeString* p = new_node<LogNodeString>(pp->GetArena(),
+                                                  Key, Val, pp);
   pp->Add(p);
 }
 
@@ -454,7 +962,7 @@ void  rvs::logger::AddString(void* Parent, const char* Key, const char* Val) {
  */
 void  rvs::logger::AddInt(void* Parent, const char* Key, const int Val) {
   rvs::LogNode* pp = static_cast<rvs::LogNode*>(Parent);
-  rvs::LogNodeInt* p = new LogNodeInt(Key, Val, pp);
+  rvs::LogNodeInt* p = new_node<LogNodeInt>(pp->GetArena(), Key, Val, pp);
   pp->Add(p);
 }
 
@@ -483,68 +991,121 @@ void  rvs::logger::AddNode(void* Parent, void* Child) {
  *
  */
 int rvs::logger::init_log_file() {
-  isfirstrecord_m = true;
-  bStop = false;
-  stop_flags = 0;
+  // start writer thread if requested
+  if (StartAsync()) {
+    return -1;
+  }
 
-  std::string row;
-  std::string logfile(log_file);
+  {
+    // lock log_mutex for the duration of this block
+    std::lock_guard<std::mutex> lk(log_mutex);
 
-  // if no logg to file requested, just return
-  if (logfile == "")
-    return 0;
+    isfirstrecord_m = true;
+    bStop = false;
+    stop_flags = 0;
 
-  if (append()) {
-    // appnd to file, replace the closing "]" with "," in order to
-    // have well formed JSON after appending
-    int patch_status = -1;
+    std::string row;
+    std::string logfile(log_file);
 
-    if (to_json()) {
-      int sts = JsonPatchAppend(&patch_status);
-      if (sts) {
-        return -1;
-      }
+    // if no logg to file requested, just return
+    if (logfile == "") {
+      CloseFile();
+      return 0;
     }
-  }  else {
-    // logging but not appending - just truncate the file.
-    std::fstream fs;
-    fs.open(logfile, std::fstream::out);
-    bool berror = fs.fail();
-    fs.close();
-    if (berror) {
+
+    // when appending to JSON log, new records go in place of its closing
+    // bracket; otherwise just truncate the file
+    if (OpenFile(!append())) {
       return -1;
     }
-    if (to_json()) {
-      row = "[";
+
+    // binary log starts new session on each invocation
+    if (to_binary()) {
+      binlog.Header(&row);
     }
+
+    // print to log file if requested
+    ToFile(row);
   }
 
-  // print to log file if requested
-  ToFile(row);
+  // allow mapping of log timestamps onto calendar time
+  LogClockAnchor();
 
   return 0;
 }
 
+/**
+ * @brief Output wall-clock anchor at the start of log file
+ *
+ * Log timestamps count from system start. This row pairs a timestamp with
+ * UTC wall-clock time so that post-run analysis can convert log times
+ * into calendar time. It is output to the log file only.
+ *
+ */
+void rvs::logger::LogClockAnchor() {
+  if (loglevel_m < logresults)
+    return;
+
+  uint64_t mono;
+  std::string wall;
+  LogClock::anchor(&mono, &wall);
+
+  uint32_t sec;
+  uint32_t usec;
+  LogClock::split(mono, &sec, &usec);
+
+  if (to_json()) {
+    void* r = LogRecordCreate("CLI", "clock", logresults, sec, usec);
+    AddString(r, "wallclock", wall.c_str());
+    AddString(r, "clocksource", LogClock::source());
+    LogRecordFlush(r);
+    return;
+  }
+
+  char buff[64];
+  snprintf(buff, sizeof(buff), "%6d.%-6d", sec, usec);
+
+  std::string row("[");
+  row += loglevelname[logresults];
+  row += "] [";
+  row += buff;
+  row += "] [CLI] wall clock: ";
+  row += wall;
+  row += ", clock source: ";
+  row += LogClock::source();
+
+  // lock log_mutex for the duration of this block
+  std::lock_guard<std::mutex> lk(log_mutex);
+  RowToFile(row, false);
+}
+
 /**
  * @brief Performs proper termination of log file contents
  *
+ * Writes out all buffered rows and closes log file.
+ *
  * @return 0 - success, non-zero otherwise
  *
  */
 int rvs::logger::terminate() {
-  // if no logg to file requested, just return
+  // output everything queued so far
+  StopAsync();
+
+  // lock log_mutex for the duration of this function
+  std::lock_guard<std::mutex> lk(log_mutex);
+
+  // if no logg to file requested or already terminated, just return
   std::string logfile(log_file);
-  if (logfile == "")
+  if (logfile == "" || log_fd < 0)
     return 0;
 
-  std::string row(RVSENDL);
-
-  if (to_json()) {
-    row += "]";
+  // JSON log is kept terminated and binary log needs no terminator
+  if (!to_json()) {
+    ToFile(RVSENDL);
   }
 
-  // print to log file if requested
-  ToFile(row);
+  // write out buffered rows
+  CloseFile();
 
   return 0;
 }
@@ -558,12 +1119,14 @@ int rvs::logger::terminate() {
  *
  */
 void rvs::logger::Stop(uint16_t flags) {
-  // lock cout_mutex for the duration of this block
-  std::lock_guard<std::mutex> lk(cout_mutex);
+  {
+    // lock cout_mutex for the duration of this block
+    std::lock_guard<std::mutex> lk(cout_mutex);
 
-  // signal no further logging to either screen or file
-  bStop = true;
-  stop_flags = flags;
+    // signal no further logging to either screen or file
+    bStop = true;
+    stop_flags = flags;
+  }
 
   // properly terminate log file if needed
   terminate();
@@ -0,0 +1,212 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvslinksched.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Derive links occupied by a transfer from its path
+ *
+ * @param Src source node
+ * @param Dst destination node
+ * @param Hops hop types along the path (e.g. "PCIe", "xGMI")
+ * @param P2PHop hop type which connects two agents directly, empty if none
+ * @param Bidirectional 'true' if data flows in both directions
+ * @return list of links
+ *
+ * */
+std::vector<std::string> rvs::LinkScheduler::PathLinks(uint32_t Src,
+                                     uint32_t Dst,
+                                     const std::vector<std::string>& Hops,
+                                     const std::string& P2PHop,
+                                     bool Bidirectional) {
+  std::vector<std::string> links;
+  std::string src = std::to_string(Src);
+  std::string dst = std::to_string(Dst);
+
+  // single point-to-point hop is a link between the two agents
+  if (!P2PHop.empty() && Hops.size() == 1 && Hops[0] == P2PHop) {
+    links.push_back(P2PHop + " " + src + ">" + dst);
+    if (Bidirectional) {
+      links.push_back(P2PHop + " " + dst + ">" + src);
+    }
+    return links;
+  }
+
+  std::string first = Hops.empty() ? "link" : Hops.front();
+  std::string last = Hops.empty() ? "link" : Hops.back();
+  links.push_back(first + " " + src + " out");
+  links.push_back(last + " " + dst + " in");
+  if (Bidirectional) {
+    links.push_back(first + " " + src + " in");
+    links.push_back(last + " " + dst + " out");
+  }
+  return links;
+}
+
+/**
+ * @brief Add transfer described by its path
+ *
+ * @param Src source node
+ * @param Dst destination node
+ * @param Hops hop types along the path
+ * @param Bidirectional 'true' if data flows in both directions
+ * @return transfer index
+ *
+ * */
+size_t rvs::LinkScheduler::Add(uint32_t Src, uint32_t Dst,
+                               const std::vector<std::string>& Hops,
+                               bool Bidirectional) {
+  return Add(PathLinks(Src, Dst, Hops, p2p_hop, Bidirectional));
+}
+
+/**
+ * @brief Add transfer described by links it occupies
+ *
+ * @param Links links occupied by the transfer
+ * @return transfer index
+ *
+ * */
+size_t rvs::LinkScheduler::Add(const std::vector<std::string>& Links) {
+  std::vector<std::string> links(Links);
+  std::sort(links.begin(), links.end());
+  links.erase(std::unique(links.begin(), links.end()), links.end());
+  transfers.push_back(links);
+  return transfers.size() - 1;
+}
+
+/**
+ * @brief Check if two transfers share a link
+ *
+ * */
+bool rvs::LinkScheduler::Conflict(size_t A, size_t B) const {
+  const std::vector<std::string>& a = transfers[A];
+  const std::vector<std::string>& b = transfers[B];
+  auto ia = a.begin();
+  auto ib = b.begin();
+  while (ia != a.end() && ib != b.end()) {
+    if (*ia == *ib) {
+      return true;
+    }
+    if (*ia < *ib) {
+      ++ia;
+    } else {
+      ++ib;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Minimum possible number of rounds
+ *
+ * Transfers sharing the same link all conflict with each other, so
+ * there can not be less rounds than transfers on the busiest link.
+ *
+ * @return lower bound for number of rounds
+ *
+ * */
+size_t rvs::LinkScheduler::LowerBound() const {
+  std::map<std::string, size_t> load;
+  size_t bound = transfers.empty() ? 0 : 1;
+  for (const auto& t : transfers) {
+    for (const auto& link : t) {
+      bound = std::max(bound, ++load[link]);
+    }
+  }
+  return bound;
+}
+
+/**
+ * @brief Split transfers into rounds of non-conflicting transfers
+ *
+ * Colours conflict graph using DSatur: the next transfer coloured is the
+ * one whose neighbours already use the most colours (ties broken by
+ * number of neighbours), and it gets the lowest colour not in use by
+ * its neighbours.
+ *
+ * @return rounds, each holding indexes of transfers in order of adding
+ *
+ * */
+std::vector<std::vector<size_t>> rvs::LinkScheduler::Schedule() const {
+  const size_t n = transfers.size();
+
+  // conflict graph
+  std::vector<std::vector<size_t>> adj(n);
+  for (size_t a = 0; a < n; a++) {
+    for (size_t b = a + 1; b < n; b++) {
+      if (Conflict(a, b)) {
+        adj[a].push_back(b);
+        adj[b].push_back(a);
+      }
+    }
+  }
+
+  std::vector<int> colour(n, -1);
+  // colours used by neighbours of each transfer
+  std::vector<std::vector<bool>> used(n);
+  std::vector<size_t> saturation(n, 0);
+  int colours = 0;
+
+  for (size_t k = 0; k < n; k++) {
+    size_t pick = n;
+    for (size_t v = 0; v < n; v++) {
+      if (colour[v] >= 0) {
+        continue;
+      }
+      if (pick == n || saturation[v] > saturation[pick] ||
+          (saturation[v] == saturation[pick] &&
+           adj[v].size() > adj[pick].size())) {
+        pick = v;
+      }
+    }
+
+    int c = 0;
+    while (c < static_cast<int>(used[pick].size()) && used[pick][c]) {
+      c++;
+    }
+    colour[pick] = c;
+    colours = std::max(colours, c + 1);
+
+    for (size_t u : adj[pick]) {
+      if (used[u].size() <= static_cast<size_t>(c)) {
+        used[u].resize(c + 1, false);
+      }
+      if (!used[u][c]) {
+        used[u][c] = true;
+        saturation[u]++;
+      }
+    }
+  }
+
+  std::vector<std::vector<size_t>> rounds(colours);
+  for (size_t v = 0; v < n; v++) {
+    rounds[colour[v]].push_back(v);
+  }
+  return rounds;
+}
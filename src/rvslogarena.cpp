@@ -0,0 +1,165 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvslogarena.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+namespace {
+
+//! size of the first chunk in each arena
+const size_t kChunkSize = 4096;
+//! max number of idle arenas kept per thread
+const size_t kPoolSize = 8;
+
+/**
+ * @brief Per-thread pool of idle arenas
+ *
+ * Deletes pooled arenas when owning thread exits.
+ *
+ */
+struct arena_pool {
+  ~arena_pool() {
+    for (auto it = idle.begin(); it != idle.end(); ++it) {
+      delete (*it);
+    }
+  }
+  //! arenas ready to be reused
+  std::vector<rvs::LogArena*> idle;
+};
+
+thread_local arena_pool pool;
+
+}  // namespace
+
+//! Default constructor
+rvs::LogArena::LogArena() : cursor(nullptr), limit(nullptr) {
+}
+
+//! Destructor
+rvs::LogArena::~LogArena() {
+  for (auto it = chunks.begin(); it != chunks.end(); ++it) {
+    delete[] it->Data;
+  }
+}
+
+/**
+ * @brief Allocate new chunk and make it current
+ *
+ * @param MinSize minimum number of bytes needed
+ *
+ */
+void rvs::LogArena::add_chunk(const size_t MinSize) {
+  size_t size = chunks.empty() ? kChunkSize : chunks.back().Size * 2;
+  while (size < MinSize)
+    size *= 2;
+
+  Chunk c;
+  c.Data = new char[size];
+  c.Size = size;
+  chunks.push_back(c);
+
+  cursor = c.Data;
+  limit = c.Data + size;
+}
+
+/**
+ * @brief Allocate memory from arena
+ *
+ * Memory is only released by reset() or when arena is destroyed.
+ *
+ * @param Size number of bytes
+ * @param Align required alignment (power of 2)
+ * @return pointer to allocated memory
+ *
+ */
+void* rvs::LogArena::allocate(const size_t Size, const size_t Align) {
+  uintptr_t p = (reinterpret_cast<uintptr_t>(cursor) + Align - 1) &
+                ~static_cast<uintptr_t>(Align - 1);
+
+  if (cursor == nullptr || p + Size > reinterpret_cast<uintptr_t>(limit)) {
+    add_chunk(Size + Align);
+    p = (reinterpret_cast<uintptr_t>(cursor) + Align - 1) &
+        ~static_cast<uintptr_t>(Align - 1);
+  }
+
+  cursor = reinterpret_cast<char*>(p + Size);
+  return reinterpret_cast<void*>(p);
+}
+
+/**
+ * @brief Reclaim all memory allocated from arena
+ *
+ * Keeps the first chunk so that the next record does not need to
+ * allocate. Destructors of objects placed in arena are not called.
+ *
+ */
+void rvs::LogArena::reset() {
+  if (chunks.empty())
+    return;
+
+  for (size_t i = 1; i < chunks.size(); i++) {
+    delete[] chunks[i].Data;
+  }
+  chunks.resize(1);
+
+  cursor = chunks[0].Data;
+  limit = chunks[0].Data + chunks[0].Size;
+}
+
+/**
+ * @brief Get arena from the calling thread's pool
+ *
+ * @return empty arena
+ *
+ */
+rvs::LogArena* rvs::LogArena::Acquire() {
+  if (pool.idle.empty())
+    return new LogArena();
+
+  LogArena* p = pool.idle.back();
+  pool.idle.pop_back();
+  return p;
+}
+
+/**
+ * @brief Reset arena and return it to the calling thread's pool
+ *
+ * @param pArena arena obtained through Acquire()
+ *
+ */
+void rvs::LogArena::Release(LogArena* pArena) {
+  if (pArena == nullptr)
+    return;
+
+  if (pool.idle.size() >= kPoolSize) {
+    delete pArena;
+    return;
+  }
+
+  pArena->reset();
+  pool.idle.push_back(pArena);
+}
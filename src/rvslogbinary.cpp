@@ -0,0 +1,480 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvslogbinary.h"
+
+#include <string.h>
+
+#include <string>
+
+#include "include/rvslognode.h"
+#include "include/rvslognodeint.h"
+#include "include/rvslognoderec.h"
+#include "include/rvslognodestring.h"
+
+namespace {
+
+//! session signature
+const char kMagic[8] = {'R', 'V', 'S', 'B', 'L', 'O', 'G', '\0'};
+
+//! frame tags
+const char kFrameString = 0x01;
+const char kFrameRecord = 0x02;
+const char kFrameReset  = 0x03;
+
+//! node tags
+const char kNodeList      = 0x01;
+const char kNodeString    = 0x02;
+const char kNodeInt       = 0x03;
+const char kNodeStringRef = 0x04;
+
+//! string values longer than this are never put into string table
+const size_t kInternMax = 64;
+
+//! max nesting level accepted by reader
+const int kMaxDepth = 64;
+
+/**
+ * @brief Check if string value is worth putting into string table
+ *
+ * Names, identifiers and the like repeat across records, while numbers
+ * formatted as strings (bandwidth, temperature...) mostly do not.
+ *
+ * @param Val string value
+ * @param Len string length
+ * @return 'true' if value is to be interned
+ *
+ */
+bool worth_interning(const char* Val, const size_t Len) {
+  if (Len > kInternMax)
+    return false;
+
+  for (size_t i = 0; i < Len; i++) {
+    char c = Val[i];
+    if (!((c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+' ||
+          c == 'e' || c == 'E' || c == ' ')) {
+      return true;
+    }
+  }
+  return Len == 0;
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor
+ *
+ * @param TableMax string table size which triggers reset
+ *
+ */
+rvs::LogBinaryWriter::LogBinaryWriter(const size_t TableMax)
+: last_time(0), table_max(TableMax) {
+}
+
+//! Destructor
+rvs::LogBinaryWriter::~LogBinaryWriter() {
+}
+
+/**
+ * @brief Append LEB128 encoded unsigned integer
+ *
+ * @param pOut output buffer
+ * @param Val value
+ *
+ */
+void rvs::LogBinaryWriter::Varint(std::string* pOut, uint64_t Val) {
+  while (Val >= 0x80) {
+    pOut->push_back(static_cast<char>((Val & 0x7f) | 0x80));
+    Val >>= 7;
+  }
+  pOut->push_back(static_cast<char>(Val));
+}
+
+/**
+ * @brief Map signed integer onto unsigned so that small magnitudes
+ * produce short varints
+ *
+ * @param Val signed value
+ * @return zigzag encoded value
+ *
+ */
+uint64_t rvs::LogBinaryWriter::ZigZag(const int64_t Val) {
+  return (static_cast<uint64_t>(Val) << 1) ^ static_cast<uint64_t>(Val >> 63);
+}
+
+/**
+ * @brief Start new session
+ *
+ * Emits session header and resets string table and timestamp base.
+ *
+ * @param pOut output buffer
+ *
+ */
+void rvs::LogBinaryWriter::Header(std::string* pOut) {
+  table.clear();
+  last_time = 0;
+  pOut->append(kMagic, sizeof(kMagic));
+  pOut->push_back(static_cast<char>(LOGBIN_VERSION));
+}
+
+/**
+ * @brief Encode log record
+ *
+ * @param pRec log record
+ * @param pOut output buffer
+ *
+ */
+void rvs::LogBinaryWriter::Record(const LogNodeRec* pRec, std::string* pOut) {
+  defs.clear();
+  body.clear();
+
+  // start over with empty table rather than let it grow without limit
+  if (table.size() >= table_max) {
+    table.clear();
+    defs.push_back(kFrameReset);
+  }
+
+  pRec->Encode(this);
+  pOut->append(defs);
+  pOut->append(body);
+}
+
+/**
+ * @brief Get string table id, defining new string if needed
+ *
+ * @param Val string
+ * @param Len string length
+ * @return string id
+ *
+ */
+uint32_t rvs::LogBinaryWriter::Intern(const char* Val, const size_t Len) {
+  // lookup key is assembled in reused buffer to avoid heap traffic
+  lookup.assign(Val, Len);
+  auto it = table.find(lookup);
+  if (it != table.end())
+    return it->second;
+
+  uint32_t id = table.size();
+  table.insert(std::make_pair(lookup, id));
+
+  defs.push_back(kFrameString);
+  Varint(&defs, Len);
+  defs.append(Val, Len);
+
+  return id;
+}
+
+/**
+ * @brief Encode record header
+ *
+ * @param Level logging level
+ * @param Sec seconds
+ * @param uSec microseconds
+ * @param Count number of child nodes that follow
+ *
+ */
+void rvs::LogBinaryWriter::BeginRecord(const int Level, const unsigned Sec,
+                                       const unsigned uSec,
+                                       const size_t Count) {
+  int64_t now = static_cast<int64_t>(Sec) * 1000000 + uSec;
+
+  body.push_back(kFrameRecord);
+  Varint(&body, ZigZag(Level));
+  Varint(&body, ZigZag(now - last_time));
+  Varint(&body, Count);
+
+  last_time = now;
+}
+
+/**
+ * @brief Encode list node header
+ *
+ * @param Key node name
+ * @param Count number of child nodes that follow
+ *
+ */
+void rvs::LogBinaryWriter::List(const char* Key, const size_t Count) {
+  uint32_t key = Intern(Key, strlen(Key));
+  body.push_back(kNodeList);
+  Varint(&body, key);
+  Varint(&body, Count);
+}
+
+/**
+ * @brief Encode string node
+ *
+ * @param Key node name
+ * @param Val node value
+ *
+ */
+void rvs::LogBinaryWriter::String(const char* Key, const char* Val) {
+  uint32_t key = Intern(Key, strlen(Key));
+  size_t len = strlen(Val);
+  if (worth_interning(Val, len)) {
+    uint32_t val = Intern(Val, len);
+    body.push_back(kNodeStringRef);
+    Varint(&body, key);
+    Varint(&body, val);
+  } else {
+    body.push_back(kNodeString);
+    Varint(&body, key);
+    Varint(&body, len);
+    body.append(Val, len);
+  }
+}
+
+/**
+ * @brief Encode integer node
+ *
+ * @param Key node name
+ * @param Val node value
+ *
+ */
+void rvs::LogBinaryWriter::Int(const char* Key, const int Val) {
+  uint32_t key = Intern(Key, strlen(Key));
+  body.push_back(kNodeInt);
+  Varint(&body, key);
+  Varint(&body, ZigZag(Val));
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param pIn input stream holding binary log
+ *
+ */
+rvs::LogBinaryReader::LogBinaryReader(std::istream* pIn)
+: in(pIn), last_time(0), bsession(false), berror(false) {
+}
+
+/**
+ * @brief Read session header (after the first signature byte)
+ *
+ * @return 'true' on success
+ *
+ */
+bool rvs::LogBinaryReader::ReadHeader() {
+  std::string magic;
+  if (!ReadBytes(sizeof(kMagic) - 1, &magic))
+    return false;
+  if (magic != std::string(kMagic + 1, sizeof(kMagic) - 1))
+    return false;
+
+  // version 1 differs only in not having reset frames
+  int version = in->rdbuf()->sbumpc();
+  if (version < 1 || version > LOGBIN_VERSION)
+    return false;
+
+  table.clear();
+  last_time = 0;
+  bsession = true;
+  return true;
+}
+
+/**
+ * @brief Read LEB128 encoded unsigned integer
+ *
+ * @param pVal [out] value
+ * @return 'true' on success
+ *
+ */
+bool rvs::LogBinaryReader::ReadVarint(uint64_t* pVal) {
+  uint64_t val = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int c = in->rdbuf()->sbumpc();
+    if (c == std::char_traits<char>::eof())
+      return false;
+    val |= static_cast<uint64_t>(c & 0x7f) << shift;
+    if (!(c & 0x80)) {
+      *pVal = val;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Read given number of bytes
+ *
+ * @param Len number of bytes
+ * @param pVal [out] bytes read
+ * @return 'true' on success
+ *
+ */
+bool rvs::LogBinaryReader::ReadBytes(const size_t Len, std::string* pVal) {
+  pVal->resize(Len);
+  if (Len == 0)
+    return true;
+  return in->rdbuf()->sgetn(&(*pVal)[0], Len) ==
+         static_cast<std::streamsize>(Len);
+}
+
+/**
+ * @brief Read string table reference
+ *
+ * @param pKey [out] referenced string
+ * @return 'true' on success
+ *
+ */
+bool rvs::LogBinaryReader::ReadKey(std::string* pKey) {
+  uint64_t id;
+  if (!ReadVarint(&id) || id >= table.size())
+    return false;
+  *pKey = table[id];
+  return true;
+}
+
+/**
+ * @brief Read node and all its children
+ *
+ * @param pParent parent node
+ * @param Depth current nesting level
+ * @return newly created node, nullptr on error
+ *
+ */
+rvs::LogNodeBase* rvs::LogBinaryReader::ReadNode(const LogNodeBase* pParent,
+                                                const int Depth) {
+  if (Depth > kMaxDepth)
+    return nullptr;
+
+  int tag = in->rdbuf()->sbumpc();
+  std::string key;
+  if (!ReadKey(&key))
+    return nullptr;
+
+  uint64_t val;
+  switch (tag) {
+  case kNodeList: {
+    if (!ReadVarint(&val))
+      return nullptr;
+    LogNode* node = new LogNode(key.c_str(), pParent);
+    for (uint64_t i = 0; i < val; i++) {
+      LogNodeBase* child = ReadNode(node, Depth + 1);
+      if (child == nullptr) {
+        delete node;
+        return nullptr;
+      }
+      node->Add(child);
+    }
+    return node;
+  }
+  case kNodeString: {
+    std::string str;
+    if (!ReadVarint(&val) || !ReadBytes(val, &str))
+      return nullptr;
+    return new LogNodeString(key.c_str(), str.c_str(), pParent);
+  }
+  case kNodeStringRef: {
+    std::string str;
+    if (!ReadKey(&str))
+      return nullptr;
+    return new LogNodeString(key.c_str(), str.c_str(), pParent);
+  }
+  case kNodeInt: {
+    if (!ReadVarint(&val))
+      return nullptr;
+    int64_t i = static_cast<int64_t>(val >> 1) ^
+                -static_cast<int64_t>(val & 1);
+    return new LogNodeInt(key.c_str(), static_cast<int>(i), pParent);
+  }
+  default:
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Read next log record
+ *
+ * String definitions, string table resets and session headers are consumed
+ * on the way.
+ *
+ * @return log record (to be deleted by caller), nullptr at the end of
+ * input or on error (see Error())
+ *
+ */
+rvs::LogNodeRec* rvs::LogBinaryReader::Next() {
+  for (;;) {
+    int tag = in->rdbuf()->sbumpc();
+    if (tag == std::char_traits<char>::eof())
+      return nullptr;
+
+    if (tag == kMagic[0]) {
+      if (!ReadHeader()) {
+        berror = true;
+        return nullptr;
+      }
+      continue;
+    }
+
+    if (!bsession) {
+      berror = true;
+      return nullptr;
+    }
+
+    uint64_t val;
+    if (tag == kFrameString) {
+      std::string str;
+      if (!ReadVarint(&val) || !ReadBytes(val, &str)) {
+        berror = true;
+        return nullptr;
+      }
+      table.push_back(str);
+      continue;
+    }
+
+    if (tag == kFrameReset) {
+      table.clear();
+      continue;
+    }
+
+    if (tag != kFrameRecord) {
+      berror = true;
+      return nullptr;
+    }
+
+    uint64_t level, dtime, count;
+    if (!ReadVarint(&level) || !ReadVarint(&dtime) || !ReadVarint(&count)) {
+      berror = true;
+      return nullptr;
+    }
+    last_time += static_cast<int64_t>(dtime >> 1) ^
+                 -static_cast<int64_t>(dtime & 1);
+
+    int lvl = static_cast<int>(static_cast<int64_t>(level >> 1) ^
+                               -static_cast<int64_t>(level & 1));
+    LogNodeRec* rec = new LogNodeRec("", lvl,
+                                     static_cast<unsigned>(last_time / 1000000),
+                                     static_cast<unsigned>(last_time % 1000000));
+    for (uint64_t i = 0; i < count; i++) {
+      LogNodeBase* child = ReadNode(rec, 1);
+      if (child == nullptr) {
+        delete rec;
+        berror = true;
+        return nullptr;
+      }
+      rec->Add(child);
+    }
+    return rec;
+  }
+}
@@ -0,0 +1,231 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvslogclock.h"
+
+#include <time.h>
+#include <stdio.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+#include <string>
+
+namespace {
+
+//! time after start-up before TSC is used for timestamps (ns)
+const uint64_t calibration_ns = 100000000ull;
+//! interval between re-reads of system clock in each thread (ns)
+const uint64_t refresh_ns = 250000000ull;
+
+//! pair of TSC and CLOCK_MONOTONIC readings
+struct clock_pair {
+  //! TSC value
+  uint64_t tsc;
+  //! CLOCK_MONOTONIC value in ns
+  uint64_t ns;
+};
+
+//! per-thread timestamp cache
+struct thread_cache {
+  //! last re-read of system clock
+  clock_pair base;
+  //! last timestamp returned in this thread
+  uint64_t last;
+};
+
+thread_local thread_cache cache = {{0, 0}, 0};
+
+/**
+ * @brief Check if CPU has invariant (constant rate, always running) TSC
+ *
+ * @return 'true' if TSC may be used as time source
+ *
+ */
+bool invariant_tsc() {
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx))
+    return false;
+  return (edx & (1u << 8)) != 0;
+#else
+  return false;
+#endif
+}
+
+}  // namespace
+
+bool rvs::LogClock::tsc_ok(invariant_tsc());
+std::atomic<uint64_t> rvs::LogClock::scale(0);
+std::atomic<uint64_t> rvs::LogClock::refresh(0);
+
+/**
+ * @brief Read CLOCK_MONOTONIC
+ *
+ * @return ns since system start
+ *
+ */
+uint64_t rvs::LogClock::monotonic() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+/**
+ * @brief Read time stamp counter
+ *
+ * @return TSC value
+ *
+ */
+uint64_t rvs::LogClock::tsc() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+/**
+ * @brief Read TSC and CLOCK_MONOTONIC as close together as possible
+ *
+ * @return readings paired at TSC midpoint of the system clock call
+ *
+ */
+static clock_pair read_pair(uint64_t (*pTsc)(), uint64_t (*pMono)()) {
+  clock_pair p;
+  uint64_t t0 = (*pTsc)();
+  p.ns = (*pMono)();
+  uint64_t t1 = (*pTsc)();
+  p.tsc = t0 + (t1 - t0) / 2;
+  return p;
+}
+
+/**
+ * @brief Get monotonic timestamp
+ *
+ * @return ns since system start (CLOCK_MONOTONIC time base)
+ *
+ */
+uint64_t rvs::LogClock::now() {
+  if (!tsc_ok)
+    return monotonic();
+
+  uint64_t t = tsc();
+  uint64_t s = scale.load(std::memory_order_relaxed);
+  uint64_t ns;
+
+  // note: if thread migrated to a CPU with TSC slightly behind, t - base.tsc
+  // wraps around and system clock is re-read
+  if (s != 0 && cache.base.tsc != 0 &&
+      t - cache.base.tsc < refresh.load(std::memory_order_relaxed)) {
+    ns = cache.base.ns + (((t - cache.base.tsc) * s) >> 32);
+  } else {
+    cache.base = read_pair(tsc, monotonic);
+    ns = cache.base.ns;
+    calibrate();
+  }
+
+  // never go back in time within a thread
+  if (ns < cache.last)
+    ns = cache.last;
+  cache.last = ns;
+
+  return ns;
+}
+
+/**
+ * @brief Refine TSC rate using the latest reading of this thread
+ *
+ * Rate is computed over the whole time elapsed since the process wide
+ * reference reading, so it gets more accurate as the run goes on.
+ *
+ * @return 'true' if TSC rate is known
+ *
+ */
+bool rvs::LogClock::calibrate() {
+  static const clock_pair ref = read_pair(tsc, monotonic);
+
+  const clock_pair& cur = cache.base;
+  if (cur.ns < ref.ns + calibration_ns || cur.tsc <= ref.tsc)
+    return false;
+
+  double rate = static_cast<double>(cur.ns - ref.ns) /
+                static_cast<double>(cur.tsc - ref.tsc);
+  scale.store(static_cast<uint64_t>(rate * 4294967296.0),
+              std::memory_order_relaxed);
+  refresh.store(static_cast<uint64_t>(refresh_ns / rate),
+                std::memory_order_relaxed);
+  return true;
+}
+
+/**
+ * @brief Split timestamp into seconds and microseconds
+ *
+ * @param Ns timestamp in ns
+ * @param pSec [out] seconds
+ * @param pUsec [out] microseconds within current second
+ *
+ */
+void rvs::LogClock::split(const uint64_t Ns, uint32_t* pSec,
+                          uint32_t* pUsec) {
+  *pSec = static_cast<uint32_t>(Ns / 1000000000ull);
+  *pUsec = static_cast<uint32_t>((Ns % 1000000000ull) / 1000);
+}
+
+/**
+ * @brief Get monotonic timestamp paired with wall-clock time
+ *
+ * Used to map log timestamps onto calendar time.
+ *
+ * @param pMono [out] monotonic timestamp in ns
+ * @param pWall [out] UTC wall-clock time in ISO 8601 format
+ *
+ */
+void rvs::LogClock::anchor(uint64_t* pMono, std::string* pWall) {
+  struct timespec ts;
+  *pMono = now();
+  clock_gettime(CLOCK_REALTIME, &ts);
+
+  struct tm tm_utc;
+  gmtime_r(&ts.tv_sec, &tm_utc);
+
+  char buff[64];
+  snprintf(buff, sizeof(buff), "%04d-%02d-%02dT%02d:%02d:%02d.%06ldZ",
+           tm_utc.tm_year + 1900, tm_utc.tm_mon + 1, tm_utc.tm_mday,
+           tm_utc.tm_hour, tm_utc.tm_min, tm_utc.tm_sec,
+           static_cast<long>(ts.tv_nsec / 1000));  // NOLINT
+  *pWall = buff;
+}
+
+/**
+ * @brief Name of time source in use
+ *
+ * @return "tsc" if TSC is used once calibrated, "monotonic" otherwise
+ *
+ */
+const char* rvs::LogClock::source() {
+  return tsc_ok ? "tsc" : "monotonic";
+}
@@ -24,6 +24,9 @@
  *******************************************************************************/
 #include "include/rvsloglp.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <chrono>
 #include <string>
 
@@ -31,6 +34,21 @@
 using std::string;
 
 T_MODULE_INIT rvs::lp::mi;
+T_MODULE_INIT_EXT rvs::lp::mi_ext;
+
+/**
+ * @brief Extended module initialization entry point
+ *
+ * Exported from every module linked with this library. Launcher calls it,
+ * if present, before rvs_module_init().
+ *
+ * @param pMiExt Pointer to extended module initialization structure
+ * @return 0 - success, non-zero otherwise
+ *
+ */
+extern "C" int rvs_module_init_ext(void* pMiExt) {
+  return rvs::lp::InitializeExt(static_cast<T_MODULE_INIT_EXT*>(pMiExt));
+}
 
 /**
  * @brief Initialize logger proxy class
@@ -55,6 +73,28 @@ int   rvs::lp::Initialize(const T_MODULE_INIT* pMi) {
   return 0;
 }
 
+/**
+ * @brief Initialize callbacks passed through extended init structure
+ *
+ * Only members fully covered by pMiExt->size are taken over, so that
+ * launcher built against older header may pass shorter structure.
+ *
+ * @param pMiExt Pointer to extended module initialization structure
+ * @return 0 - success, non-zero otherwise
+ *
+ */
+int   rvs::lp::InitializeExt(const T_MODULE_INIT_EXT* pMiExt) {
+  T_MODULE_INIT_EXT e = {};
+
+  memcpy(&e, pMiExt, std::min<size_t>(pMiExt->size, sizeof(e)));
+
+  mi_ext.size          = sizeof(mi_ext);
+  mi_ext.cbLogLevel    = e.cbLogLevel;
+  mi_ext.cbGetTicks    = e.cbGetTicks;
+
+  return 0;
+}
+
 /**
  * @brief Output log message
  *
@@ -209,6 +249,10 @@ void  rvs::lp::AddNode(void* Parent, void* Child) {
  *
  */
 bool rvs::lp::get_ticks(unsigned int* psecs, unsigned int* pusecs) {
+  // use launcher clock so that all modules share the same time source
+  if (mi_ext.cbGetTicks)
+    return (*mi_ext.cbGetTicks)(psecs, pusecs);
+
   struct timespec ts;
 
   clock_gettime(CLOCK_MONOTONIC, &ts);
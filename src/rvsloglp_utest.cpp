@@ -32,7 +32,20 @@
 
 using std::string;
 
+namespace {
+
+//! In unit tests module logging level is taken directly from logger
+T_MODULE_INIT_EXT utest_module_init_ext() {
+  T_MODULE_INIT_EXT e = {};
+  e.size = sizeof(e);
+  e.cbLogLevel = rvs::logger::log_level;
+  return e;
+}
+
+}  // namespace
+
 T_MODULE_INIT rvs::lp::mi;
+T_MODULE_INIT_EXT rvs::lp::mi_ext = utest_module_init_ext();
 
 /**
  * @brief Initialize logger proxy class
@@ -211,13 +224,7 @@ void  rvs::lp::AddNode(void* Parent, void* Child) {
  *
  */
 bool rvs::lp::get_ticks(unsigned int* psecs, unsigned int* pusecs) {
-  struct timespec ts;
-
-  clock_gettime(CLOCK_MONOTONIC, &ts);
-  *pusecs    = ts.tv_nsec / 1000;
-  *psecs  = ts.tv_sec;
-
-  return true;
+  return rvs::logger::get_ticks(psecs, pusecs);
 }
 
 /**
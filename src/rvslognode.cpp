@@ -25,6 +25,7 @@
 #include <string>
 
 #include "include/rvslognode.h"
+#include "include/rvslogbinary.h"
 #include "include/rvstrace.h"
 
 using std::string;
@@ -34,18 +35,21 @@ using std::string;
  *
  * @param Name Node name
  * @param Parent Pointer to parent node
+ * @param pArena Arena holding node memory (nullptr if allocated by new)
  *
  */
-rvs::LogNode::LogNode(const char* Name, const LogNodeBase* Parent)
+rvs::LogNode::LogNode(const char* Name, const LogNodeBase* Parent,
+                      LogArena* pArena)
 :
-LogNodeBase(Name, Parent) {
+LogNodeBase(Name, Parent, pArena),
+Child(ArenaAllocator<LogNodeBase*>(pArena)) {
   Type = eLN::List;
 }
 
 //! Destructor
 rvs::LogNode::~LogNode() {
   for (auto it = Child.begin(); it != Child.end(); ++it) {
-    delete (*it);
+    Destroy(*it);
   }
 }
 
@@ -60,28 +64,43 @@ void rvs::LogNode::Add(LogNodeBase* pChild) {
 }
 
 /**
- * @brief Provides JSON representation of Node
+ * @brief Appends JSON representation of Node to the output buffer
  *
- * Traverses list of child nodes and converts them into proper string representation.
+ * Traverses list of child nodes and appends their representation.
  * Also ensures proper indentation and line breaks for formatted output.
  *
- * @param Lead String of blanks " " representing current indentation
- * @return Node as JSON string
+ * @param pJson output buffer
+ * @param Lead String representing base indentation
+ * @param Depth nesting level
  *
  */
-std::string rvs::LogNode::ToJson(const std::string& Lead) {
+void rvs::LogNode::Serialize(std::string* pJson, const std::string& Lead,
+                             const int Depth) const {
   DTRACE_
-  string result(RVSENDL);
-  result += Lead + "\"" + Name + "\"" + " : {";
+  JsonIndent(pJson, Lead, Depth);
+  JsonString(pJson, Name);
+  pJson->append(" : {");
 
-  int  size = Child.size();
-  for (int i = 0; i < size; i++) {
-    result += Child[i]->ToJson(Lead + RVSINDENT);
-    if (i+ 1 < size) {
-      result += ",";
+  size_t size = Child.size();
+  for (size_t i = 0; i < size; i++) {
+    Child[i]->Serialize(pJson, Lead, Depth + 1);
+    if (i + 1 < size) {
+      pJson->push_back(',');
     }
   }
-  result += RVSENDL + Lead + "}";
+  JsonIndent(pJson, Lead, Depth);
+  pJson->push_back('}');
+}
 
-  return result;
+/**
+ * @brief Encodes Node and its children into binary log format
+ *
+ * @param pWriter binary log encoder
+ *
+ */
+void rvs::LogNode::Encode(LogBinaryWriter* pWriter) const {
+  pWriter->List(Name.c_str(), Child.size());
+  for (auto it = Child.begin(); it != Child.end(); ++it) {
+    (*it)->Encode(pWriter);
+  }
 }
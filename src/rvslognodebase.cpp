@@ -31,14 +31,123 @@
  *
  * @param pName Node name
  * @param pParent Pointer to parent node
+ * @param pArena Arena holding node memory (nullptr if allocated by new)
  *
  */
-rvs::LogNodeBase::LogNodeBase(const char* pName, const LogNodeBase* pParent)
-: Name(pName),
+rvs::LogNodeBase::LogNodeBase(const char* pName, const LogNodeBase* pParent,
+                              LogArena* pArena)
+: Name(pName, ArenaAllocator<char>(pArena)),
 Parent(pParent),
-Type(eLN::Unknown) {
+Type(eLN::Unknown),
+Arena(pArena) {
 }
 
 //! Destructor
 rvs::LogNodeBase::~LogNodeBase() {
 }
+
+/**
+ * @brief Destroy node
+ *
+ * Nodes allocated from arena are only destructed, their memory is
+ * reclaimed together with the arena. Other nodes are deleted.
+ *
+ * @param pNode node to destroy
+ *
+ */
+void rvs::LogNodeBase::Destroy(LogNodeBase* pNode) {
+  if (pNode == nullptr)
+    return;
+
+  if (pNode->Arena) {
+    pNode->~LogNodeBase();
+  } else {
+    delete pNode;
+  }
+}
+
+/**
+ * @brief Provides JSON representation of Node
+ *
+ * @param Lead String of blanks " " representing current indentation
+ * @return Node as JSON string
+ *
+ */
+std::string rvs::LogNodeBase::ToJson(const std::string& Lead) {
+  std::string result;
+  Serialize(&result, Lead, 0);
+  return result;
+}
+
+/**
+ * @brief Appends new line and indentation for given nesting level
+ *
+ * @param pJson output buffer
+ * @param Lead String representing base indentation
+ * @param Depth nesting level
+ *
+ */
+void rvs::LogNodeBase::JsonIndent(std::string* pJson, const std::string& Lead,
+                                  const int Depth) {
+  pJson->append(RVSENDL);
+  pJson->append(Lead);
+  for (int i = 0; i < Depth; i++) {
+    pJson->append(RVSINDENT);
+  }
+}
+
+/**
+ * @brief Appends quoted and escaped JSON string
+ *
+ * @param pJson output buffer
+ * @param Val string value
+ *
+ */
+void rvs::LogNodeBase::JsonString(std::string* pJson,
+                                  const ArenaString& Val) {
+  static const char hex[] = "0123456789abcdef";
+
+  pJson->push_back('"');
+  for (size_t i = 0; i < Val.size(); i++) {
+    unsigned char c = static_cast<unsigned char>(Val[i]);
+    switch (c) {
+    case '"':  pJson->append("\\\""); break;
+    case '\\': pJson->append("\\\\"); break;
+    case '\n': pJson->append("\\n"); break;
+    case '\r': pJson->append("\\r"); break;
+    case '\t': pJson->append("\\t"); break;
+    case '\b': pJson->append("\\b"); break;
+    case '\f': pJson->append("\\f"); break;
+    default:
+      if (c < 0x20) {
+        char esc[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf]};
+        pJson->append(esc, sizeof(esc));
+      } else {
+        pJson->push_back(static_cast<char>(c));
+      }
+    }
+  }
+  pJson->push_back('"');
+}
+
+/**
+ * @brief Appends decimal representation of integer
+ *
+ * @param pJson output buffer
+ * @param Val integer value
+ *
+ */
+void rvs::LogNodeBase::JsonInt(std::string* pJson, const int Val) {
+  char buff[16];
+  char* p = buff + sizeof(buff);
+  unsigned int u = Val < 0 ? 0u - static_cast<unsigned int>(Val)
+                           : static_cast<unsigned int>(Val);
+  do {
+    *--p = static_cast<char>('0' + u % 10);
+    u /= 10;
+  } while (u);
+  if (Val < 0) {
+    *--p = '-';
+  }
+  pJson->append(p, buff + sizeof(buff) - p);
+}
@@ -25,6 +25,7 @@
 #include <string>
 
 #include "include/rvslognodeint.h"
+#include "include/rvslogbinary.h"
 
 using std::string;
 
@@ -34,12 +35,13 @@ using std::string;
  * @param Name Node name
  * @param Val Node value
  * @param Parent Pointer to parent node
+ * @param pArena Arena holding node memory (nullptr if allocated by new)
  *
  */
 rvs::LogNodeInt::LogNodeInt(const char* Name, const int Val,
-                            const LogNodeBase* Parent)
+                            const LogNodeBase* Parent, LogArena* pArena)
 :
-LogNodeBase(Name, Parent),
+LogNodeBase(Name, Parent, pArena),
 Value(Val) {
   Type = eLN::Integer;
 }
@@ -49,18 +51,27 @@ rvs::LogNodeInt::~LogNodeInt() {
 }
 
 /**
- * @brief Provides JSON representation of Node
+ * @brief Appends JSON representation of Node to the output buffer
  *
- * Traverses list of child nodes and converts them into proper string representation.
- * Also ensures proper indentation and line breaks for formatted output.
- *
- * @param Lead String of blanks " " representing current indentation
- * @return Node as JSON string
+ * @param pJson output buffer
+ * @param Lead String representing base indentation
+ * @param Depth nesting level
  *
  */
-std::string rvs::LogNodeInt::ToJson(const std::string& Lead) {
-  string result(RVSENDL);
-  result += Lead + "\"" + Name + "\"" + " : " + std::to_string(Value);
+void rvs::LogNodeInt::Serialize(std::string* pJson, const std::string& Lead,
+                                const int Depth) const {
+  JsonIndent(pJson, Lead, Depth);
+  JsonString(pJson, Name);
+  pJson->append(" : ");
+  JsonInt(pJson, Value);
+}
 
-  return result;
+/**
+ * @brief Encodes Node into binary log format
+ *
+ * @param pWriter binary log encoder
+ *
+ */
+void rvs::LogNodeInt::Encode(LogBinaryWriter* pWriter) const {
+  pWriter->Int(Name.c_str(), Value);
 }
@@ -24,6 +24,7 @@
  *******************************************************************************/
 
 #include "include/rvslognoderec.h"
+#include "include/rvslogbinary.h"
 
 #include <string>
 #include "include/rvstrace.h"
@@ -36,12 +37,14 @@
  * @param Sec secconds since system start
  * @param uSec microseconds in current second
  * @param Parent Pointer to parent node
+ * @param pArena Arena holding node memory (nullptr if allocated by new)
  *
  */
 rvs::LogNodeRec::LogNodeRec(const char* Name, int LoggingLevel,
-  const unsigned Sec, const unsigned uSec, const LogNodeBase* Parent)
+  const unsigned Sec, const unsigned uSec, const LogNodeBase* Parent,
+  LogArena* pArena)
 :
-LogNode(Name, Parent),
+LogNode(Name, Parent, pArena),
 Level(LoggingLevel),
 sec(Sec),
 usec(uSec) {
@@ -63,40 +66,54 @@ int rvs::LogNodeRec::LogLevel() {
 }
 
 /**
- * @brief Provides JSON representation of Node
+ * @brief Appends JSON representation of Node to the output buffer
  *
- * Traverses list of child nodes and converts them into proper string representation.
+ * Traverses list of child nodes and appends their representation.
  * Also ensures proper indentation and line breaks for formatted output.
  *
- * @param Lead String of blanks " " representing current indentation
- * @return Node as JSON string
+ * @param pJson output buffer
+ * @param Lead String representing base indentation
+ * @param Depth nesting level
  *
  */
-std::string rvs::LogNodeRec::ToJson(const std::string& Lead) {
+void rvs::LogNodeRec::Serialize(std::string* pJson, const std::string& Lead,
+                                const int Depth) const {
   DTRACE_
-  std::string result(RVSENDL);
-  result += Lead + "{";
+  JsonIndent(pJson, Lead, Depth);
+  pJson->push_back('{');
 
-  result += RVSENDL;
-  result += Lead + RVSINDENT;
-  result += std::string("\"") + "loglevel" + "\"" + " : " +
-            std::to_string(Level) + ",";
+  JsonIndent(pJson, Lead, Depth + 1);
+  pJson->append("\"loglevel\" : ");
+  JsonInt(pJson, Level);
+  pJson->push_back(',');
 
   char  buff[64];
-  snprintf(buff, sizeof(buff), "%6d.%-6d", sec, usec);
-  result += RVSENDL;
-  result += Lead + RVSINDENT;
-  result += std::string("\"") + "time" + "\"" + " : " +
-            std::string("\"") + buff + std::string("\"")  + ",";
+  int len = snprintf(buff, sizeof(buff), "%6d.%-6d", sec, usec);
+  JsonIndent(pJson, Lead, Depth + 1);
+  pJson->append("\"time\" : \"");
+  pJson->append(buff, len);
+  pJson->append("\",");
 
-  int  size = Child.size();
-  for (int i = 0; i < size; i++) {
-    result += Child[i]->ToJson(Lead + RVSINDENT);
-    if (i+ 1 < size) {
-      result += ",";
+  size_t size = Child.size();
+  for (size_t i = 0; i < size; i++) {
+    Child[i]->Serialize(pJson, Lead, Depth + 1);
+    if (i + 1 < size) {
+      pJson->push_back(',');
     }
   }
-  result += RVSENDL + Lead + "}";
+  JsonIndent(pJson, Lead, Depth);
+  pJson->push_back('}');
+}
 
-  return result;
+/**
+ * @brief Encodes Node and its children into binary log format
+ *
+ * @param pWriter binary log encoder
+ *
+ */
+void rvs::LogNodeRec::Encode(LogBinaryWriter* pWriter) const {
+  pWriter->BeginRecord(Level, sec, usec, Child.size());
+  for (auto it = Child.begin(); it != Child.end(); ++it) {
+    (*it)->Encode(pWriter);
+  }
 }
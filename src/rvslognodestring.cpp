@@ -25,6 +25,7 @@
 #include <string>
 
 #include "include/rvslognodestring.h"
+#include "include/rvslogbinary.h"
 
 using std::string;
 
@@ -34,13 +35,15 @@ using std::string;
  * @param Name Node name
  * @param Val Node value
  * @param Parent Pointer to parent node
+ * @param pArena Arena holding node memory (nullptr if allocated by new)
  *
  */
 rvs::LogNodeString::LogNodeString(const char* Name, const char* Val,
-                                  const LogNodeBase* Parent)
+                                  const LogNodeBase* Parent,
+                                  LogArena* pArena)
 :
-LogNodeBase(Name, Parent),
-Value(Val) {
+LogNodeBase(Name, Parent, pArena),
+Value(Val, ArenaAllocator<char>(pArena)) {
   Type = eLN::String;
 }
 
@@ -49,18 +52,28 @@ rvs::LogNodeString::~LogNodeString() {
 }
 
 /**
- * @brief Provides JSON representation of Node
+ * @brief Appends JSON representation of Node to the output buffer
  *
- * Traverses list of child nodes and converts them into proper string representation.
- * Also ensures proper indentation and line breaks for formatted output.
- *
- * @param Lead String of blanks " " representing current indentation
- * @return Node as JSON string
+ * @param pJson output buffer
+ * @param Lead String representing base indentation
+ * @param Depth nesting level
  *
  */
-std::string rvs::LogNodeString::ToJson(const std::string& Lead) {
-  string result(RVSENDL);
-  result += Lead + "\"" + Name + "\"" + " : " + "\"" + Value + "\"";
+void rvs::LogNodeString::Serialize(std::string* pJson,
+                                   const std::string& Lead,
+                                   const int Depth) const {
+  JsonIndent(pJson, Lead, Depth);
+  JsonString(pJson, Name);
+  pJson->append(" : ");
+  JsonString(pJson, Value);
+}
 
-  return result;
+/**
+ * @brief Encodes Node into binary log format
+ *
+ * @param pWriter binary log encoder
+ *
+ */
+void rvs::LogNodeString::Encode(LogBinaryWriter* pWriter) const {
+  pWriter->String(Name.c_str(), Value.c_str());
 }
@@ -0,0 +1,163 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvslogqueue.h"
+
+#include <chrono>
+#include <thread>
+#include <utility>
+
+/**
+ * @brief Constructor
+ *
+ * @param Capacity number of slots, rounded up to the power of 2
+ *
+ */
+rvs::LogQueue::LogQueue(const size_t Capacity)
+: tail(0), head(0), cnt_pushed(0), cnt_dropped(0), cnt_full(0) {
+  size_t size = 2;
+  while (size < Capacity)
+    size <<= 1;
+
+  buffer.reset(new Cell[size]);
+  for (size_t i = 0; i < size; i++) {
+    buffer[i].Seq.store(i, std::memory_order_relaxed);
+    buffer[i].Data.Target = 0;
+  }
+  mask = size - 1;
+}
+
+//! Destructor
+rvs::LogQueue::~LogQueue() {
+}
+
+/**
+ * @brief Try to place entry into the queue without waiting
+ *
+ * @param pEntry entry to push; its row is moved into the queue on success
+ * @return 'true' if entry was queued, 'false' if queue is full
+ *
+ */
+bool rvs::LogQueue::try_push(Entry* pEntry) {
+  size_t pos = tail.load(std::memory_order_relaxed);
+  Cell* cell;
+
+  for (;;) {
+    cell = &buffer[pos & mask];
+    size_t seq = cell->Seq.load(std::memory_order_acquire);
+    intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (tail.compare_exchange_weak(pos, pos + 1,
+                                     std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = tail.load(std::memory_order_relaxed);
+    }
+  }
+
+  cell->Data.Row = std::move(pEntry->Row);
+  cell->Data.Target = pEntry->Target;
+  cell->Seq.store(pos + 1, std::memory_order_release);
+
+  return true;
+}
+
+/**
+ * @brief Push entry into the queue
+ *
+ * When queue is full and bWait is 'false' entry is dropped and
+ * drop counter incremented. Otherwise producer yields until writer thread
+ * frees a slot.
+ *
+ * @param pEntry entry to push; its row is moved into the queue on success
+ * @param bWait 'true' if caller is to wait for free slot
+ * @return 'true' if entry was queued, 'false' if it was dropped
+ *
+ */
+bool rvs::LogQueue::push(Entry* pEntry, const bool bWait) {
+  if (try_push(pEntry)) {
+    cnt_pushed.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  cnt_full.fetch_add(1, std::memory_order_relaxed);
+  if (!bWait) {
+    cnt_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  while (!try_push(pEntry)) {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+  cnt_pushed.fetch_add(1, std::memory_order_relaxed);
+
+  return true;
+}
+
+/**
+ * @brief Take the oldest entry from the queue
+ *
+ * Must be called from single consumer thread only.
+ *
+ * @param pEntry [out] entry taken from the queue
+ * @return 'true' if entry was taken, 'false' if queue is empty
+ *
+ */
+bool rvs::LogQueue::pop(Entry* pEntry) {
+  size_t pos = head.load(std::memory_order_relaxed);
+  Cell* cell = &buffer[pos & mask];
+  size_t seq = cell->Seq.load(std::memory_order_acquire);
+
+  if (seq != pos + 1)
+    return false;
+
+  pEntry->Row = std::move(cell->Data.Row);
+  pEntry->Target = cell->Data.Target;
+  cell->Data.Row.clear();
+  cell->Seq.store(pos + mask + 1, std::memory_order_release);
+  head.store(pos + 1, std::memory_order_relaxed);
+
+  return true;
+}
+
+/**
+ * @brief Check if there are entries waiting in the queue
+ *
+ * @return 'true' if queue is empty
+ *
+ */
+bool rvs::LogQueue::empty() const {
+  size_t pos = head.load(std::memory_order_relaxed);
+  return buffer[pos & mask].Seq.load(std::memory_order_acquire) != pos + 1;
+}
+
+//! Resets pushed/dropped/full counters
+void rvs::LogQueue::reset_counters() {
+  cnt_pushed.store(0);
+  cnt_dropped.store(0);
+  cnt_full.store(0);
+}
@@ -0,0 +1,75 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvsloglp.h"
+
+#include <stdio.h>
+
+#include <string>
+
+/*
+ * Call site formatting is shared by run-time (rvsloglp.cpp) and unit test
+ * (rvsloglp_utest.cpp) logger proxies. Both implement Log() used here.
+ */
+
+/**
+ * @brief Output trace message for given call site
+ *
+ * @param Site call site description
+ * @param level Logging level
+ * @return 0 - success, non-zero otherwise
+ *
+ */
+int rvs::lp::LogSite(const log_site& Site, const int level) {
+  char buff[512];
+  snprintf(buff, sizeof(buff), "%s   %s:%d", Site.file, Site.func, Site.line);
+  return Log(buff, level);
+}
+
+/**
+ * @brief Output debug message for given call site
+ *
+ * Message is formed as call site location followed by s1..s4.
+ *
+ * @param Site call site description
+ * @param level Logging level
+ * @param s1 message part
+ * @param s2 message part
+ * @param s3 message part
+ * @param s4 message part
+ * @return 0 - success, non-zero otherwise
+ *
+ */
+int rvs::lp::LogSite(const log_site& Site, const int level,
+                     const std::string& s1, const std::string& s2,
+                     const std::string& s3, const std::string& s4) {
+  char buff[512];
+  snprintf(buff, sizeof(buff), "%s   %s:%d", Site.file, Site.func, Site.line);
+  std::string msg(buff);
+  msg += s1;
+  msg += s2;
+  msg += s3;
+  msg += s4;
+  return Log(msg, level);
+}
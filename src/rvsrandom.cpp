@@ -0,0 +1,288 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvsrandom.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "include/rvsworkpool.h"
+
+namespace {
+
+//! Philox multipliers
+const uint32_t PHILOX_M0 = 0xD2511F53;
+const uint32_t PHILOX_M1 = 0xCD9E8D57;
+//! Philox key increments
+const uint32_t PHILOX_W0 = 0x9E3779B9;
+const uint32_t PHILOX_W1 = 0xBB67AE85;
+//! number of Philox rounds
+const int PHILOX_ROUNDS = 10;
+
+//! number of counters processed together (independent lanes for SIMD)
+const size_t BATCH = 8;
+//! number of elements produced by one batch
+const size_t BATCH_ELEMS = 4 * BATCH;
+//! smallest number of elements worth handing to another thread
+const size_t MIN_CHUNK = 256 * 1024;
+
+/**
+ * @brief Generate random words for BATCH consecutive counters
+ *
+ * Lanes are kept in separate arrays and processed in simple loops so that
+ * the compiler can map them onto SIMD registers.
+ *
+ */
+inline void philox_batch(uint64_t Counter, uint32_t Stream,
+                         uint32_t K0, uint32_t K1,
+                         uint32_t Out[4][BATCH]) {
+  uint32_t c0[BATCH], c1[BATCH], c2[BATCH], c3[BATCH];
+  for (size_t j = 0; j < BATCH; j++) {
+    c0[j] = static_cast<uint32_t>(Counter + j);
+    c1[j] = static_cast<uint32_t>((Counter + j) >> 32);
+    c2[j] = Stream;
+    c3[j] = 0;
+  }
+
+  for (int r = 0; r < PHILOX_ROUNDS; r++) {
+    for (size_t j = 0; j < BATCH; j++) {
+      uint64_t p0 = static_cast<uint64_t>(PHILOX_M0) * c0[j];
+      uint64_t p1 = static_cast<uint64_t>(PHILOX_M1) * c2[j];
+      uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[j] ^ K0;
+      uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[j] ^ K1;
+      c1[j] = static_cast<uint32_t>(p1);
+      c3[j] = static_cast<uint32_t>(p0);
+      c0[j] = n0;
+      c2[j] = n2;
+    }
+    K0 += PHILOX_W0;
+    K1 += PHILOX_W1;
+  }
+
+  for (size_t j = 0; j < BATCH; j++) {
+    Out[0][j] = c0[j];
+    Out[1][j] = c1[j];
+    Out[2][j] = c2[j];
+    Out[3][j] = c3[j];
+  }
+}
+
+/**
+ * @brief Fill elements [Begin, End) of the sequence
+ *
+ * Elements are generated in batches of BATCH_ELEMS aligned to the start of
+ * the array: element e of a batch takes word e / BATCH of counter e % BATCH
+ * (relative to the batch), so the result does not depend on how the range
+ * is split between threads and each word is stored contiguously.
+ *
+ */
+template <typename T, typename Conv>
+void fill_range(T* pData, size_t Begin, size_t End,
+                uint64_t Seed, uint32_t Stream, Conv Convert) {
+  uint32_t k0 = static_cast<uint32_t>(Seed);
+  uint32_t k1 = static_cast<uint32_t>(Seed >> 32);
+  uint32_t out[4][BATCH];
+
+  size_t e = Begin - Begin % BATCH_ELEMS;
+  for (; e < End; e += BATCH_ELEMS) {
+    philox_batch(e / BATCH_ELEMS * BATCH, Stream, k0, k1, out);
+    if (e >= Begin && e + BATCH_ELEMS <= End) {
+      T* p = pData + e;
+      for (size_t w = 0; w < 4; w++) {
+        for (size_t j = 0; j < BATCH; j++) {
+          p[w * BATCH + j] = Convert(out[w][j]);
+        }
+      }
+      continue;
+    }
+    // partial batch at either end of the range
+    for (size_t w = 0; w < 4; w++) {
+      for (size_t j = 0; j < BATCH; j++) {
+        size_t ix = e + w * BATCH + j;
+        if (ix >= Begin && ix < End) {
+          pData[ix] = Convert(out[w][j]);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Pool shared by all fills
+ *
+ */
+rvs::WorkPool* fill_pool() {
+  static rvs::WorkPool pool;
+  return &pool;
+}
+
+/**
+ * @brief Split fill between pool threads and the calling thread
+ *
+ * @param Count number of elements
+ * @param Threads max number of threads to use, 0 for all pool threads
+ * @param Fill function filling elements [Begin, End)
+ *
+ */
+template <typename Fill>
+void parallel_fill(size_t Count, size_t Threads, Fill Fn) {
+  size_t chunks = Count / MIN_CHUNK + 1;
+  if (Threads != 1) {
+    rvs::WorkPool* pool = fill_pool();
+    size_t max_threads = Threads ? Threads : pool->Threads() + 1;
+    chunks = std::min(chunks, max_threads);
+  } else {
+    chunks = 1;
+  }
+
+  // chunk boundaries on batch boundaries
+  size_t chunk = (Count / chunks + BATCH_ELEMS - 1) / BATCH_ELEMS
+                 * BATCH_ELEMS;
+  if (chunks == 1 || chunk == 0) {
+    Fn(0, Count);
+    return;
+  }
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  size_t pending = 0;
+
+  for (size_t begin = chunk; begin < Count; begin += chunk) {
+    size_t end = std::min(begin + chunk, Count);
+    {
+      std::lock_guard<std::mutex> lk(mtx);
+      pending++;
+    }
+    fill_pool()->Submit([&, begin, end] {
+      Fn(begin, end);
+      std::lock_guard<std::mutex> lk(mtx);
+      if (--pending == 0) {
+        cv.notify_one();
+      }
+    });
+  }
+
+  Fn(0, std::min(chunk, Count));
+
+  std::unique_lock<std::mutex> lk(mtx);
+  cv.wait(lk, [&] { return pending == 0; });
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor
+ *
+ * @param Seed random seed (key)
+ * @param Stream sequence number, different streams are independent
+ *
+ * */
+rvs::philox4x32::philox4x32(uint64_t Seed, uint32_t Stream)
+  : k0(static_cast<uint32_t>(Seed)), k1(static_cast<uint32_t>(Seed >> 32)),
+    stream(Stream) {
+}
+
+/**
+ * @brief Generate random words for given counter
+ *
+ * @param Counter counter value
+ * @param Out [out] four random words
+ *
+ * */
+void rvs::philox4x32::generate(uint64_t Counter, uint32_t Out[4]) const {
+  uint32_t out[4][BATCH];
+  philox_batch(Counter, stream, k0, k1, out);
+  for (size_t w = 0; w < 4; w++) {
+    Out[w] = out[w][0];
+  }
+}
+
+/**
+ * @brief Fill array with uniformly distributed random values
+ *
+ * Element i of the array is the same for given seed and stream no matter
+ * how many threads fill it.
+ *
+ * @param pData array to fill
+ * @param Count number of elements
+ * @param Scale values are in range [0, Scale)
+ * @param Seed random seed
+ * @param Stream sequence number
+ * @param Threads max number of threads to use, 0 for all available
+ *
+ * */
+void rvs::random_fill(float* pData, size_t Count, float Scale,
+                      uint64_t Seed, uint32_t Stream, size_t Threads) {
+  const float mul = Scale / 16777216.0f;
+  parallel_fill(Count, Threads, [=](size_t Begin, size_t End) {
+    fill_range(pData, Begin, End, Seed, Stream, [mul](uint32_t x) {
+      return static_cast<float>(x >> 8) * mul;
+    });
+  });
+}
+
+/**
+ * @brief Fill array with uniformly distributed random values
+ *
+ * @param pData array to fill
+ * @param Count number of elements
+ * @param Scale values are in range [0, Scale)
+ * @param Seed random seed
+ * @param Stream sequence number
+ * @param Threads max number of threads to use, 0 for all available
+ *
+ * */
+void rvs::random_fill(double* pData, size_t Count, double Scale,
+                      uint64_t Seed, uint32_t Stream, size_t Threads) {
+  const double mul = Scale / 4294967296.0;
+  parallel_fill(Count, Threads, [=](size_t Begin, size_t End) {
+    fill_range(pData, Begin, End, Seed, Stream, [mul](uint32_t x) {
+      return static_cast<double>(x) * mul;
+    });
+  });
+}
+
+/**
+ * @brief Fill array with random IEEE half precision numbers in [0.5, 1)
+ *
+ * Only the mantissa is random, so that no element is NaN, Inf or denormal.
+ *
+ * @param pData array to fill (half precision bit patterns)
+ * @param Count number of elements
+ * @param Seed random seed
+ * @param Stream sequence number
+ * @param Threads max number of threads to use, 0 for all available
+ *
+ * */
+void rvs::random_fill_half(uint16_t* pData, size_t Count,
+                           uint64_t Seed, uint32_t Stream, size_t Threads) {
+  parallel_fill(Count, Threads, [=](size_t Begin, size_t End) {
+    fill_range(pData, Begin, End, Seed, Stream, [](uint32_t x) {
+      // sign 0, biased exponent 14 (2^-1), 10 random mantissa bits
+      return static_cast<uint16_t>(0x3800 | (x >> 22));
+    });
+  });
+}
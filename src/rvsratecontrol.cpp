@@ -0,0 +1,240 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvsratecontrol.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Default constructor, constant zero rate
+ *
+ * */
+rvs::rate_profile::rate_profile()
+  : shp(constant), high(0), low(0), period(0), steps(1) {
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param Shape profile shape
+ * @param High highest rate
+ * @param Low lowest rate
+ * @param PeriodNs period of the profile (ns)
+ * @param Steps number of steps of step profile
+ *
+ * */
+rvs::rate_profile::rate_profile(shape Shape, double High, double Low,
+                                uint64_t PeriodNs, uint32_t Steps)
+  : shp(Shape), high(High), low(Low), period(PeriodNs),
+    steps(std::max<uint32_t>(Steps, 1)) {
+}
+
+/**
+ * @brief Rate requested at given time
+ *
+ * @param Ns time since start of the profile (ns)
+ * @return requested rate
+ *
+ * */
+double rvs::rate_profile::value(uint64_t Ns) const {
+  if (period == 0) {
+    return high;
+  }
+
+  switch (shp) {
+  case step:
+    if (steps == 1) {
+      return high;
+    }
+    return low + (high - low) * ((Ns / period) % steps) / (steps - 1);
+
+  case square:
+    return (Ns % period) < period / 2 ? high : low;
+
+  case sine: {
+    double phase = 2 * M_PI * static_cast<double>(Ns % period) / period;
+    return low + (high - low) * (1 + cos(phase)) / 2;
+  }
+
+  default:
+    return high;
+  }
+}
+
+/**
+ * @brief Convert profile name to shape
+ *
+ * @param Name one of "constant", "step", "sine" or "square"
+ * @param pShape [out] profile shape
+ * @return true if name is valid
+ *
+ * */
+bool rvs::rate_profile::parse_shape(const std::string& Name, shape* pShape) {
+  if (Name == "constant") {
+    *pShape = constant;
+  } else if (Name == "step") {
+    *pShape = step;
+  } else if (Name == "sine") {
+    *pShape = sine;
+  } else if (Name == "square") {
+    *pShape = square;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+//! Default controller parameters
+rvs::rate_controller::params::params()
+  : kp(0.1), ki(0.5), kd(0), max_correction(0.5), burst(2) {
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param OpAmount amount of work of one operation (e.g. GFLOP)
+ * @param Params controller parameters
+ *
+ * */
+rvs::rate_controller::rate_controller(double OpAmount, const params& Params)
+  : prm(Params), op(OpAmount) {
+  reset(0);
+}
+
+/**
+ * @brief Restart control
+ *
+ * Bucket starts with one operation worth of tokens and no correction.
+ *
+ * @param NowNs current time (ns)
+ *
+ * */
+void rvs::rate_controller::reset(uint64_t NowNs) {
+  tokens = op;
+  last_refill = NowNs;
+  cur_rate = 0;
+  corr = 1;
+  integral = 0;
+  last_err = 0;
+  last_update = NowNs;
+  updated = false;
+  throttled = false;
+}
+
+/**
+ * @brief Add tokens for time elapsed since last refill
+ *
+ * @param NowNs current time (ns)
+ * @param Setpoint requested rate (work per second)
+ *
+ * */
+void rvs::rate_controller::refill(uint64_t NowNs, double Setpoint) {
+  cur_rate = std::max(Setpoint, 0.0) * corr;
+  if (NowNs > last_refill) {
+    tokens += cur_rate * (NowNs - last_refill) / 1e9;
+    last_refill = NowNs;
+  }
+  tokens = std::min(tokens, std::max(prm.burst, 1.0) * op);
+}
+
+/**
+ * @brief Time until next operation may start
+ *
+ * @param NowNs current time (ns)
+ * @param Setpoint requested rate (work per second)
+ * @return delay in ns, 0 if operation may start now, max uint64_t if
+ * setpoint is zero
+ *
+ * */
+uint64_t rvs::rate_controller::next_delay(uint64_t NowNs, double Setpoint) {
+  refill(NowNs, Setpoint);
+  if (tokens >= op) {
+    return 0;
+  }
+  throttled = true;
+  if (cur_rate <= 0) {
+    return std::numeric_limits<uint64_t>::max();
+  }
+  return static_cast<uint64_t>(ceil((op - tokens) / cur_rate * 1e9));
+}
+
+/**
+ * @brief Take tokens for one started operation
+ *
+ * */
+void rvs::rate_controller::consume(void) {
+  tokens -= op;
+}
+
+/**
+ * @brief Adjust correction factor from measured rate
+ *
+ * @param NowNs current time (ns)
+ * @param Setpoint rate requested over the measurement window
+ * @param Measured rate measured over the window ending now
+ *
+ * */
+void rvs::rate_controller::update(uint64_t NowNs, double Setpoint,
+                                  double Measured) {
+  if (Setpoint <= 0) {
+    return;
+  }
+
+  double err = (Setpoint - Measured) / Setpoint;
+  double dt = updated && NowNs > last_update ?
+              (NowNs - last_update) / 1e9 : 0;
+  double deriv = dt > 0 ? (err - last_err) / dt : 0;
+
+  // if no operation had to wait, the device is what limits the rate and
+  // raising the correction would only wind the integral up
+  double next_integral = integral;
+  if (throttled || err < 0) {
+    next_integral += err * dt;
+  }
+  double u = prm.kp * err + prm.ki * next_integral + prm.kd * deriv;
+
+  // integrate only while correction is not pushed further into saturation
+  if (u > prm.max_correction) {
+    u = prm.max_correction;
+    if (err < 0) {
+      integral = next_integral;
+    }
+  } else if (u < -prm.max_correction) {
+    u = -prm.max_correction;
+    if (err > 0) {
+      integral = next_integral;
+    }
+  } else {
+    integral = next_integral;
+  }
+
+  corr = 1 + u;
+  last_err = err;
+  last_update = NowNs;
+  updated = true;
+  throttled = false;
+}
@@ -0,0 +1,254 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvssizesweep.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+//! Default search parameters
+rvs::size_sweep::params::params() {
+  min_size = 1024;
+  max_size = 512 * 1024 * 1024;
+  align = 1024;
+  plateau = 0.9;
+  flatness = 0.01;
+  tolerance = 0.05;
+  resolution = 0.125;
+  min_samples = 3;
+  max_samples = 10;
+}
+
+/**
+ * @brief Constructor
+ *
+ * @param Params search parameters
+ * @param Measure measurement callback
+ *
+ * */
+rvs::size_sweep::size_sweep(const params& Params, measure_t Measure)
+  : prm(Params), measure(std::move(Measure)) {
+  prm.align = std::max<uint64_t>(prm.align, 1);
+  prm.min_samples = std::max<uint32_t>(prm.min_samples, 2);
+  prm.max_samples = std::max(prm.max_samples, prm.min_samples);
+}
+
+/**
+ * @brief Two-sided 95% quantile of Student's t distribution
+ *
+ * @param Dof degrees of freedom
+ * @return quantile value
+ *
+ * */
+double rvs::size_sweep::t95(uint32_t Dof) {
+  static const double t[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086
+  };
+  const uint32_t n = sizeof(t) / sizeof(t[0]);
+
+  if (Dof == 0)
+    return INFINITY;
+  return Dof <= n ? t[Dof - 1] : 1.960;
+}
+
+/**
+ * @brief Round size to nearest multiple of alignment
+ *
+ * @param Size size (bytes)
+ * @return aligned size, at least one alignment unit
+ *
+ * */
+uint64_t rvs::size_sweep::align(uint64_t Size) const {
+  uint64_t a = (Size + prm.align / 2) / prm.align * prm.align;
+  return std::max(a, prm.align);
+}
+
+/**
+ * @brief Measure bandwidth at given size
+ *
+ * Repeats measurement until confidence interval of mean bandwidth is
+ * within tolerance or maximum number of samples has been taken.
+ *
+ * @param Size block size (bytes)
+ * @param pPoint [out] measured bandwidth
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int rvs::size_sweep::probe(uint64_t Size, point* pPoint) {
+  double mean = 0;
+  double m2 = 0;
+  uint32_t n = 0;
+  double ci = INFINITY;
+
+  while (n < prm.max_samples) {
+    double bw;
+    int sts = measure(Size, &bw);
+    if (sts)
+      return sts;
+
+    // Welford's running mean and variance
+    n++;
+    double delta = bw - mean;
+    mean += delta / n;
+    m2 += delta * (bw - mean);
+
+    if (n >= prm.min_samples) {
+      ci = t95(n - 1) * std::sqrt(m2 / (n - 1) / n);
+      if (ci <= prm.tolerance * std::fabs(mean))
+        break;
+    }
+  }
+
+  pPoint->size = Size;
+  pPoint->bandwidth = mean;
+  pPoint->ci = ci;
+  pPoint->samples = n;
+  return 0;
+}
+
+/**
+ * @brief Run the search
+ *
+ * @param pResult [out] knee size, plateau bandwidth and all measurements
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int rvs::size_sweep::run(result* pResult) {
+  int sts;
+  point pt;
+
+  pResult->points.clear();
+  if (prm.min_size == 0 || prm.max_size < prm.min_size)
+    return -1;
+
+  // climb until doubling the size no longer pays off
+  double best = 0;
+  for (uint64_t size = prm.min_size; ; size = std::min(size * 2,
+                                                        prm.max_size)) {
+    if ((sts = probe(size, &pt)))
+      return sts;
+    pResult->points.push_back(pt);
+
+    // growth hidden in measurement noise does not count either, so that
+    // noisy links do not climb to the largest size
+    bool flat = pt.bandwidth - pt.ci / 2 < best * (1 + prm.flatness);
+    best = std::max(best, pt.bandwidth);
+    if (flat || size == prm.max_size)
+      break;
+  }
+
+  // plateau is averaged over the two largest sizes as the best of noisy
+  // means overestimates it
+  size_t n = pResult->points.size();
+  double plateau = n > 1 ? (pResult->points[n - 1].bandwidth +
+                            pResult->points[n - 2].bandwidth) / 2 : best;
+  double target = plateau * prm.plateau;
+
+  // hi is the smallest size reaching the target, lo the largest below it
+  uint64_t hi = pResult->points.back().size;
+  double hi_bw = pResult->points.back().bandwidth;
+  uint64_t lo = 0;
+  for (const point& p : pResult->points) {
+    if (p.bandwidth >= target && p.size < hi) {
+      hi = p.size;
+      hi_bw = p.bandwidth;
+    }
+  }
+  for (const point& p : pResult->points) {
+    if (p.size < hi)
+      lo = std::max(lo, p.size);
+  }
+
+  // bisect in logarithmic scale: lo is below target, hi reaches it
+  while (lo > 0 && hi > lo * (1 + prm.resolution)) {
+    uint64_t mid = align(static_cast<uint64_t>(
+      std::sqrt(static_cast<double>(lo) * static_cast<double>(hi))));
+    if (mid <= lo || mid >= hi)
+      break;
+
+    if ((sts = probe(mid, &pt)))
+      return sts;
+    pResult->points.push_back(pt);
+
+    if (pt.bandwidth >= target) {
+      hi = mid;
+      hi_bw = pt.bandwidth;
+    } else {
+      lo = mid;
+    }
+  }
+
+  pResult->knee = hi;
+  pResult->knee_bandwidth = hi_bw;
+  pResult->below = lo;
+  pResult->plateau_bandwidth = plateau;
+  return 0;
+}
+
+/**
+ * @brief Confirm knee found by previous search
+ *
+ * Measures only the previous knee and the size below it against previous
+ * plateau bandwidth. Full search is run if there was no previous result or
+ * if the knee has moved.
+ *
+ * @param Previous result of previous search
+ * @param pResult [out] knee size, plateau bandwidth and all measurements
+ * @return 0 - if successfull, non-zero otherwise
+ *
+ * */
+int rvs::size_sweep::run(const result& Previous, result* pResult) {
+  int sts;
+  point pt;
+
+  if (Previous.knee == 0 || Previous.knee < prm.min_size ||
+      Previous.knee > prm.max_size)
+    return run(pResult);
+
+  pResult->points.clear();
+  double target = Previous.plateau_bandwidth * prm.plateau;
+
+  if ((sts = probe(Previous.knee, &pt)))
+    return sts;
+  pResult->points.push_back(pt);
+  if (pt.bandwidth < target)
+    return run(pResult);
+  double knee_bw = pt.bandwidth;
+
+  if (Previous.below > 0) {
+    if ((sts = probe(Previous.below, &pt)))
+      return sts;
+    pResult->points.push_back(pt);
+    if (pt.bandwidth >= target)
+      return run(pResult);
+  }
+
+  pResult->knee = Previous.knee;
+  pResult->knee_bandwidth = knee_bw;
+  pResult->below = Previous.below;
+  pResult->plateau_bandwidth = Previous.plateau_bandwidth;
+  return 0;
+}
@@ -0,0 +1,98 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvsstopwatch.h"
+
+/**
+ * @brief Time elapsed since start
+ * @return elapsed time in nanoseconds
+ *
+ * */
+uint64_t rvs::stopwatch::elapsed_ns() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    clock_t::now() - start_time).count();
+}
+
+/**
+ * @brief Time elapsed since start
+ * @return elapsed time in whole milliseconds
+ *
+ * */
+uint64_t rvs::stopwatch::elapsed_ms() const {
+  return elapsed_ns() / NS_PER_MS;
+}
+
+/**
+ * @brief Time elapsed since start
+ * @return elapsed time in seconds
+ *
+ * */
+double rvs::stopwatch::elapsed_sec() const {
+  return static_cast<double>(elapsed_ns()) / NS_PER_SEC;
+}
+
+/**
+ * @brief Restart measurement
+ * @return time elapsed since previous start in nanoseconds
+ *
+ * */
+uint64_t rvs::stopwatch::lap_ns() {
+  clock_t::time_point now = clock_t::now();
+  uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+    now - start_time).count();
+  start_time = now;
+  return ns;
+}
+
+/**
+ * @brief Current time on the steady clock
+ * @return nanoseconds since unspecified epoch (usually boot)
+ *
+ * */
+uint64_t rvs::stopwatch::now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    clock_t::now().time_since_epoch()).count();
+}
+
+//! Clear all accumulated intervals
+void rvs::interval_accumulator::reset() {
+  num = 0;
+  total = 0;
+  shortest = UINT64_MAX;
+  longest = 0;
+}
+
+/**
+ * @brief Add measured interval
+ * @param Ns interval in nanoseconds
+ *
+ * */
+void rvs::interval_accumulator::add(uint64_t Ns) {
+  num++;
+  total += Ns;
+  if (Ns < shortest)
+    shortest = Ns;
+  if (Ns > longest)
+    longest = Ns;
+}
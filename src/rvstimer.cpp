@@ -0,0 +1,152 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvstimer.h"
+
+/**
+ * @brief Fetch timer service shared by all timers
+ * @return pointer to timer service
+ *
+ * */
+rvs::timer_service* rvs::timer_service::get() {
+  static timer_service service;
+  return &service;
+}
+
+//! Default constructor
+rvs::timer_service::timer_service() {
+  next_id = 1;
+  running_id = 0;
+  brunning = false;
+}
+
+//! Destructor. Waits for service thread to exit.
+rvs::timer_service::~timer_service() {
+  {
+    std::lock_guard<std::mutex> lk(mtx);
+    queue.clear();
+    entries.clear();
+  }
+  cv.notify_all();
+  if (t.joinable())
+    t.join();
+}
+
+/**
+ * @brief Add timer
+ *
+ * @param Interval time until first expiration and between expirations
+ * @param RunOnce 'true' if timer is to fire only once
+ * @param Callback function to be called from the service thread
+ * @return timer ID
+ *
+ * */
+uint64_t rvs::timer_service::add(clock_t::duration Interval, bool RunOnce,
+                                 const callback_t& Callback) {
+  std::unique_lock<std::mutex> lk(mtx);
+  uint64_t id = next_id++;
+  entry& e = entries[id];
+  e.interval = Interval;
+  e.once = RunOnce;
+  e.callback = Callback;
+  e.pos = queue.emplace(clock_t::now() + Interval, id);
+
+  if (!brunning) {
+    // previous service thread ran out of timers; it no longer touches
+    // any member so it is safe to join it under the lock
+    if (t.joinable())
+      t.join();
+    brunning = true;
+    t = std::thread(&timer_service::run, this);
+  } else if (e.pos == queue.begin()) {
+    cv.notify_all();
+  }
+
+  return id;
+}
+
+/**
+ * @brief Remove timer
+ *
+ * Timer will not fire after this call returns. If its callback is in
+ * progress on another thread, waits for it to complete.
+ *
+ * @param Id timer ID as returned by add(), 0 is ignored
+ *
+ * */
+void rvs::timer_service::cancel(uint64_t Id) {
+  if (Id == 0)
+    return;
+
+  std::unique_lock<std::mutex> lk(mtx);
+  auto it = entries.find(Id);
+  if (it != entries.end()) {
+    if (it->second.pos != queue.end()) {
+      queue.erase(it->second.pos);
+    }
+    entries.erase(it);
+    cv.notify_all();
+  }
+
+  if (std::this_thread::get_id() != t.get_id()) {
+    done_cv.wait(lk, [this, Id]() { return running_id != Id; });
+  }
+}
+
+/**
+ * @brief Service thread function
+ *
+ * */
+void rvs::timer_service::run() {
+  std::unique_lock<std::mutex> lk(mtx);
+  while (!queue.empty()) {
+    auto first = queue.begin();
+    clock_t::time_point now = clock_t::now();
+    if (now < first->first) {
+      cv.wait_until(lk, first->first);
+      continue;
+    }
+
+    clock_t::time_point deadline = first->first;
+    uint64_t id = first->second;
+    queue.erase(first);
+    entry& e = entries[id];
+    callback_t callback = e.callback;
+    if (e.once) {
+      entries.erase(id);
+    } else {
+      // keep the period if the callback was not late by a whole interval
+      clock_t::time_point next = deadline + e.interval;
+      e.pos = queue.emplace(next > now ? next : now + e.interval, id);
+    }
+
+    running_id = id;
+    lk.unlock();
+    callback();
+    lk.lock();
+    running_id = 0;
+    done_cv.notify_all();
+  }
+  brunning = false;
+}
@@ -0,0 +1,157 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvstransferstats.h"
+
+#include <string.h>
+
+namespace {
+
+uint64_t to_bits(double Val) {
+  uint64_t bits;
+  memcpy(&bits, &Val, sizeof(bits));
+  return bits;
+}
+
+double from_bits(uint64_t Bits) {
+  double val;
+  memcpy(&val, &Bits, sizeof(val));
+  return val;
+}
+
+}  // namespace
+
+//! Default constructor
+rvs::transfer_stats::transfer_stats() : seq(0), sink(nullptr) {
+  reset();
+}
+
+/**
+ * @brief Set all counters to zero
+ *
+ * Must not be called while transfers are running.
+ *
+ * */
+void rvs::transfer_stats::reset() {
+  std::lock_guard<std::mutex> lk(rdmutex);
+  memset(&wr, 0, sizeof(wr));
+  publish(wr);
+  running_base = wr;
+  final_base = wr;
+}
+
+/**
+ * @brief Make writer's counters visible to readers
+ *
+ * @param Data counter values
+ *
+ * */
+void rvs::transfer_stats::publish(const data& Data) {
+  uint32_t s = seq.load(std::memory_order_relaxed);
+  seq.store(s + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  size.store(Data.size, std::memory_order_relaxed);
+  duration.store(to_bits(Data.duration), std::memory_order_relaxed);
+
+  seq.store(s + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Account completed transfer (writer only)
+ *
+ * @param Size bytes transferred
+ * @param Duration transfer time (sec)
+ *
+ * */
+void rvs::transfer_stats::add(uint64_t Size, double Duration) {
+  wr.size += Size;
+  wr.duration += Duration;
+  publish(wr);
+
+  if (sink) {
+    sink->record(Size, Duration);
+  }
+}
+
+/**
+ * @brief Take consistent snapshot of counters without blocking the writer
+ *
+ * @param pData [out] cumulative counters since last reset()
+ *
+ * */
+void rvs::transfer_stats::load(data* pData) const {
+  for (;;) {
+    uint32_t s1 = seq.load(std::memory_order_acquire);
+    if (s1 & 1)
+      continue;
+
+    pData->size = size.load(std::memory_order_relaxed);
+    pData->duration = from_bits(duration.load(std::memory_order_relaxed));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (seq.load(std::memory_order_relaxed) == s1)
+      return;
+  }
+}
+
+/**
+ * @brief Get counters accumulated since previous call and start new interval
+ *
+ * @param pRunning [out] counters for the running interval
+ *
+ * */
+void rvs::transfer_stats::take_running(data* pRunning) {
+  std::lock_guard<std::mutex> lk(rdmutex);
+  data now;
+  load(&now);
+
+  *pRunning = now;
+  pRunning->size -= running_base.size;
+  pRunning->duration -= running_base.duration;
+  running_base = now;
+}
+
+/**
+ * @brief Get counters accumulated since last final reset
+ *
+ * Also starts new running interval.
+ *
+ * @param pTotal [out] final counters
+ * @param bReset [in] if 'true' start new final period
+ *
+ * */
+void rvs::transfer_stats::take_final(data* pTotal, bool bReset) {
+  std::lock_guard<std::mutex> lk(rdmutex);
+  data now;
+  load(&now);
+
+  *pTotal = now;
+  pTotal->size -= final_base.size;
+  pTotal->duration -= final_base.duration;
+  running_base = now;
+  if (bReset) {
+    final_base = now;
+  }
+}
@@ -0,0 +1,321 @@
+/********************************************************************************
+ *
+ * Copyright (c) 2018 ROCm Developer Tools
+ *
+ * MIT LICENSE:
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+ * of the Software, and to permit persons to whom the Software is furnished to do
+ * so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "include/rvsworkpool.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+//! sysfs directory describing NUMA nodes
+#define RVS_SYSFS_NODE_PATH "/sys/devices/system/node/"
+
+namespace {
+
+//! pool owning the calling thread, if any
+thread_local const rvs::WorkPool* tls_pool = nullptr;
+//! lane of the calling thread in tls_pool
+thread_local size_t tls_lane = 0;
+
+/**
+ * @brief Read first line of a sysfs file
+ *
+ * @param Path file path
+ * @param pLine [out] line read
+ * @return 'true' if successful
+ *
+ * */
+bool read_line(const std::string& Path, std::string* pLine) {
+  std::ifstream fs(Path);
+  return static_cast<bool>(std::getline(fs, *pLine));
+}
+
+}  // namespace
+
+/**
+ * @brief Parse CPU/node list in sysfs format (e.g. "0-3,8,10-11")
+ *
+ * @param List list to parse
+ * @return list of numbers, empty if List is not valid
+ *
+ * */
+std::vector<int> rvs::WorkPool::ParseCpuList(const std::string& List) {
+  std::vector<int> result;
+  std::stringstream ss(List);
+  std::string range;
+
+  while (std::getline(ss, range, ',')) {
+    if (range.empty() || range == "\n") {
+      continue;
+    }
+    char* end;
+    long first = strtol(range.c_str(), &end, 10);  // NOLINT
+    long last = first;  // NOLINT
+    if (*end == '-') {
+      last = strtol(end + 1, &end, 10);
+    }
+    if ((*end != '\0' && *end != '\n') || first < 0 || last < first) {
+      return std::vector<int>();
+    }
+    for (long i = first; i <= last; i++) {  // NOLINT
+      result.push_back(static_cast<int>(i));
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Start pool threads
+ *
+ * Threads are distributed round-robin over online NUMA nodes and pinned
+ * to CPUs of their node. If NUMA information is not available, a single
+ * node is assumed and threads are not pinned.
+ *
+ * @param Threads number of threads, 0 - one per CPU core
+ *
+ * */
+rvs::WorkPool::WorkPool(size_t Threads)
+: next_any(0), queued(0), pending(0), stop(false) {
+  if (Threads == 0) {
+    Threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+
+  std::string line;
+  std::vector<std::vector<int>> node_cpus;
+  if (read_line(RVS_SYSFS_NODE_PATH "online", &line)) {
+    for (int node : ParseCpuList(line)) {
+      std::string path = RVS_SYSFS_NODE_PATH "node" + std::to_string(node) +
+                         "/cpulist";
+      std::vector<int> cpus;
+      if (read_line(path, &line)) {
+        cpus = ParseCpuList(line);
+      }
+      // skip memory only nodes
+      if (cpus.empty()) {
+        continue;
+      }
+      node_ids.push_back(node);
+      node_cpus.push_back(cpus);
+    }
+  }
+  if (node_ids.empty()) {
+    node_ids.push_back(-1);
+    node_cpus.push_back(std::vector<int>());
+  }
+
+  node_lanes.resize(node_ids.size());
+  node_next.assign(node_ids.size(), 0);
+
+  for (size_t i = 0; i < Threads; i++) {
+    std::unique_ptr<lane> p(new lane);
+    p->node = i % node_ids.size();
+    node_lanes[p->node].push_back(i);
+    lanes.push_back(std::move(p));
+  }
+
+  for (size_t i = 0; i < lanes.size(); i++) {
+    lane* p = lanes[i].get();
+    p->thread = std::thread(&rvs::WorkPool::Run, this, i);
+    if (node_ids.size() > 1) {
+      cpu_set_t cpuset;
+      CPU_ZERO(&cpuset);
+      for (int cpu : node_cpus[p->node]) {
+        if (cpu < CPU_SETSIZE) {
+          CPU_SET(cpu, &cpuset);
+        }
+      }
+      // not being able to pin is not an error, thread just runs anywhere
+      pthread_setaffinity_np(p->thread.native_handle(), sizeof(cpuset),
+                             &cpuset);
+    }
+  }
+}
+
+/**
+ * @brief Stop pool threads
+ *
+ * Tasks already queued are executed before threads exit.
+ *
+ * */
+rvs::WorkPool::~WorkPool() {
+  {
+    std::lock_guard<std::mutex> lk(mtx);
+    stop = true;
+  }
+  cv_work.notify_all();
+  for (auto& p : lanes) {
+    p->thread.join();
+  }
+}
+
+/**
+ * @brief Queue task for execution
+ *
+ * @param Task task to execute
+ * @param Node preferred NUMA node, -1 - no preference (when called from
+ * a pool thread, task is queued on that thread)
+ *
+ * */
+void rvs::WorkPool::Submit(const task_t& Task, int Node) {
+  size_t ix;
+  {
+    std::lock_guard<std::mutex> lk(mtx);
+    queued++;
+    pending++;
+
+    auto it = std::find(node_ids.begin(), node_ids.end(), Node);
+    if (it != node_ids.end()) {
+      size_t node = it - node_ids.begin();
+      const std::vector<size_t>& nl = node_lanes[node];
+      ix = nl[node_next[node]++ % nl.size()];
+    } else if (tls_pool == this) {
+      ix = tls_lane;
+    } else {
+      ix = next_any++ % lanes.size();
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lk(lanes[ix]->mtx);
+    lanes[ix]->tasks.push_back(Task);
+  }
+  cv_work.notify_one();
+}
+
+/**
+ * @brief Keep Wait() from returning while work is outstanding outside
+ * the pool (e.g. asynchronous copies which will submit further tasks)
+ *
+ * Every Hold() has to be matched with Release().
+ *
+ * */
+void rvs::WorkPool::Hold() {
+  std::lock_guard<std::mutex> lk(mtx);
+  pending++;
+}
+
+/**
+ * @brief Release hold taken with Hold()
+ *
+ * */
+void rvs::WorkPool::Release() {
+  std::lock_guard<std::mutex> lk(mtx);
+  if (--pending == 0) {
+    cv_idle.notify_all();
+  }
+}
+
+/**
+ * @brief Block until all submitted tasks, including tasks submitted by
+ * other tasks, have completed and all holds have been released
+ *
+ * */
+void rvs::WorkPool::Wait() {
+  std::unique_lock<std::mutex> lk(mtx);
+  cv_idle.wait(lk, [this]{ return pending == 0; });
+}
+
+/**
+ * @brief Take the oldest task from thread's own queue
+ *
+ * @param Ix lane index
+ * @param pTask [out] task
+ * @return 'true' if task was found
+ *
+ * */
+bool rvs::WorkPool::Pop(size_t Ix, task_t* pTask) {
+  lane* p = lanes[Ix].get();
+  std::lock_guard<std::mutex> lk(p->mtx);
+  if (p->tasks.empty()) {
+    return false;
+  }
+  *pTask = std::move(p->tasks.front());
+  p->tasks.pop_front();
+  return true;
+}
+
+/**
+ * @brief Take the newest task from another thread, preferring threads
+ * on the same NUMA node
+ *
+ * @param Ix lane index of the thief
+ * @param pTask [out] task
+ * @return 'true' if task was found
+ *
+ * */
+bool rvs::WorkPool::Steal(size_t Ix, task_t* pTask) {
+  size_t own = lanes[Ix]->node;
+  for (size_t n = 0; n < node_lanes.size(); n++) {
+    size_t node = (own + n) % node_lanes.size();
+    for (size_t victim : node_lanes[node]) {
+      if (victim == Ix) {
+        continue;
+      }
+      lane* p = lanes[victim].get();
+      std::lock_guard<std::mutex> lk(p->mtx);
+      if (!p->tasks.empty()) {
+        *pTask = std::move(p->tasks.back());
+        p->tasks.pop_back();
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Pool thread function
+ *
+ * @param Ix lane index of this thread
+ *
+ * */
+void rvs::WorkPool::Run(size_t Ix) {
+  tls_pool = this;
+  tls_lane = Ix;
+
+  for (;;) {
+    task_t task;
+    if (Pop(Ix, &task) || Steal(Ix, &task)) {
+      {
+        std::lock_guard<std::mutex> lk(mtx);
+        queued--;
+      }
+      task();
+      Release();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lk(mtx);
+    if (stop && queued == 0) {
+      break;
+    }
+    cv_work.wait(lk, [this]{ return stop || queued > 0; });
+  }
+}